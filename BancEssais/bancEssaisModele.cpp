@@ -0,0 +1,931 @@
+/**
+ * \file bancEssaisModele.cpp
+ *
+ * Bancs d'essais (Google Benchmark) des opérations du modèle: inscription,
+ * désinscription, recherche d'un NAS, copie et formatage d'une circonscription,
+ * validation d'un NAS et d'un fichier, accesseurs de Date.
+ *
+ * Chaque banc est exécuté pour des circonscriptions de 1 000, 100 000 et
+ * 1 000 000 d'inscrits.  Les données viennent de GenerateurInscrits, avec un
+ * germe fixe: deux exécutions mesurent exactement les mêmes entrées.
+ *
+ * Les bancs de CirconscriptionConcurrente mesurent le débit à 1, 4 et 16 fils
+ * sur une liste de 100 000 inscrits, comparé à une Circonscription protégée
+ * par un seul mutex.
+ *
+ * Pour conserver les résultats et les comparer d'une version à l'autre:
+ *
+ *     bancEssaisModele --benchmark_out=resultats.json --benchmark_out_format=json
+ *     compare.py benchmarks avant.json apres.json
+ *
+ *  Created on: 2020-12-14
+ * \author Pascal Charpentier
+ */
+
+#include "Circonscription.h"
+#include "Candidat.h"
+#include "Electeur.h"
+#include "validationFormat.h"
+#include "GenerateurInscrits.h"
+#include "CirconscriptionConcurrente.h"
+#include "DepouillementBulletins.h"
+#include "ResultatsEnDirect.h"
+#include "JournalCirconscription.h"
+#include "DeltaCirconscription.h"
+#include "DetectionDoublons.h"
+#include "IndexCodesPostaux.h"
+#include "Province.h"
+#include "VisiteurPersonne.h"
+#include "IndexAlphabetique.h"
+#include "BassinDeTaches.h"
+#include "SectionsDeVote.h"
+#include "InstantaneCirconscription.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <map>
+#include <memory_resource>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace elections;
+
+namespace
+{
+
+const GenerateurInscrits GENERATEUR(2020);
+
+/**
+ * Le i-ème électeur synthétique.  L'indice 0 du générateur est réservé au
+ * député.
+ */
+
+Electeur electeurSynthetique(unsigned int p_i)
+{
+	return GENERATEUR.reqElecteur(p_i + 1);
+}
+
+/**
+ * Retourne une circonscription de p_taille inscrits.  Elle est construite à
+ * la première demande puis conservée pour les bancs suivants, la
+ * construction des grandes tailles étant plus coûteuse que les mesures.
+ */
+
+Circonscription& circonscriptionSynthetique(unsigned int p_taille)
+{
+	static std::map<unsigned int, std::unique_ptr<Circonscription> > cache;
+
+	std::unique_ptr<Circonscription>& circonscription = cache[p_taille];
+	if (!circonscription)
+	{
+		circonscription.reset(new Circonscription("Lac Saint-Jean", GENERATEUR.reqDepute()));
+		for (unsigned int i = 0; i < p_taille; ++i)
+		{
+			circonscription->inscrire(electeurSynthetique(i));
+		}
+	}
+	return *circonscription;
+}
+
+/**
+ * Retourne le texte d'un fichier de circonscription de p_taille inscrits
+ */
+
+const std::string& fichierSynthetique(unsigned int p_taille)
+{
+	static std::map<unsigned int, std::string> cache;
+
+	std::string& texte = cache[p_taille];
+	if (texte.empty())
+	{
+		std::ostringstream os;
+		GENERATEUR.ecrireFichier(os, "Lac Saint-Jean", p_taille);
+		texte = os.str();
+	}
+	return texte;
+}
+
+void taillesDeReference(benchmark::internal::Benchmark* p_banc)
+{
+	p_banc->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+}
+
+} // namespace
+
+/**
+ * Inscription d'un nouvel électeur dans une circonscription de taille N.
+ * L'électeur est retiré hors chronométrage pour garder la taille constante.
+ */
+
+static void BM_inscrire(benchmark::State& p_etat)
+{
+	Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+	Electeur nouveau = electeurSynthetique(p_etat.range(0));
+
+	for (auto _ : p_etat)
+	{
+		circonscription.inscrire(nouveau);
+		p_etat.PauseTiming();
+		circonscription.desinscrire(nouveau.reqNas());
+		p_etat.ResumeTiming();
+	}
+}
+BENCHMARK(BM_inscrire)->Apply(taillesDeReference);
+
+/**
+ * Désinscription de l'inscrit situé au milieu de la circonscription.  Il est
+ * réinscrit hors chronométrage.
+ */
+
+static void BM_desinscrire(benchmark::State& p_etat)
+{
+	Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+	Electeur retire = electeurSynthetique(p_etat.range(0) / 2);
+
+	for (auto _ : p_etat)
+	{
+		circonscription.desinscrire(retire.reqNas());
+		p_etat.PauseTiming();
+		circonscription.inscrire(retire);
+		p_etat.ResumeTiming();
+	}
+}
+BENCHMARK(BM_desinscrire)->Apply(taillesDeReference);
+
+/**
+ * Recherche d'un NAS présent.  La recherche privée trouver() est atteinte par
+ * tenterInscrire, qui s'arrête sans rien modifier lorsque le NAS est présent.
+ */
+
+static void BM_trouver(benchmark::State& p_etat)
+{
+	Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+	Electeur present = electeurSynthetique(p_etat.range(0) / 2);
+
+	for (auto _ : p_etat)
+	{
+		benchmark::DoNotOptimize(circonscription.tenterInscrire(present));
+	}
+}
+BENCHMARK(BM_trouver)->Apply(taillesDeReference);
+
+static void BM_reqInscrit(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+	std::string nas = electeurSynthetique(p_etat.range(0) / 2).reqNas();
+
+	for (auto _ : p_etat)
+	{
+		benchmark::DoNotOptimize(circonscription.reqInscrit(nas));
+	}
+}
+BENCHMARK(BM_reqInscrit)->Apply(taillesDeReference);
+
+static void BM_copieCirconscription(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+
+	for (auto _ : p_etat)
+	{
+		Circonscription copie(circonscription);
+		benchmark::DoNotOptimize(copie.reqNbInscrits());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_copieCirconscription)->Apply(taillesDeReference);
+
+static void BM_reqCirconscriptionFormate(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+
+	for (auto _ : p_etat)
+	{
+		std::string texte = circonscription.reqCirconscriptionFormate();
+		benchmark::DoNotOptimize(texte.data());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_reqCirconscriptionFormate)->Apply(taillesDeReference);
+
+/**
+ * Validation de N NAS, dont un sur huit a un chiffre de contrôle erroné
+ */
+
+static void BM_validerNas(benchmark::State& p_etat)
+{
+	std::vector<std::string> lesNas;
+	for (unsigned int i = 0; i < p_etat.range(0); ++i)
+	{
+		lesNas.push_back(GENERATEUR.reqNas(i + 1));
+		if (i % 8 == 0) lesNas.back()[10] = static_cast<char>('0' + (lesNas.back()[10] - '0' + 1) % 10);
+	}
+
+	for (auto _ : p_etat)
+	{
+		unsigned int nbValides = 0;
+		for (const std::string& nas : lesNas) nbValides += util::validerNas(nas);
+		benchmark::DoNotOptimize(nbValides);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_validerNas)->Apply(taillesDeReference);
+
+static void BM_validerFormatFichier(benchmark::State& p_etat)
+{
+	const std::string& texte = fichierSynthetique(p_etat.range(0));
+
+	for (auto _ : p_etat)
+	{
+		std::istringstream is(texte);
+		benchmark::DoNotOptimize(util::validerFormatFichier(is));
+	}
+	p_etat.SetBytesProcessed(p_etat.iterations() * texte.size());
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_validerFormatFichier)->Apply(taillesDeReference);
+
+/**
+ * Lecture du jour, du mois et de l'année des dates de naissance de N inscrits
+ */
+
+static void BM_accesseursDate(benchmark::State& p_etat)
+{
+	std::vector<util::Date> dates;
+	for (unsigned int i = 0; i < p_etat.range(0); ++i)
+	{
+		dates.push_back(electeurSynthetique(i).reqDateNaissance());
+	}
+
+	for (auto _ : p_etat)
+	{
+		long somme = 0;
+		for (const util::Date& date : dates) somme += date.reqJour() + date.reqMois() + date.reqAnnee();
+		benchmark::DoNotOptimize(somme);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_accesseursDate)->Apply(taillesDeReference);
+
+/**
+ * Liste partagée de 100 000 inscrits, et NAS des inscrits, pour les bancs
+ * concurrents.  Les variables statiques locales sont initialisées une seule
+ * fois même si plusieurs fils y arrivent en même temps.
+ */
+
+static const unsigned int TAILLE_CONCURRENCE = 100000;
+
+static CirconscriptionConcurrente& listePartagee()
+{
+	static CirconscriptionConcurrente liste(circonscriptionSynthetique(TAILLE_CONCURRENCE));
+	return liste;
+}
+
+static const std::vector<std::string>& nasPartages()
+{
+	static std::vector<std::string> lesNas = []()
+	{
+		std::vector<std::string> v;
+		for (unsigned int i = 0; i < TAILLE_CONCURRENCE; ++i) v.push_back(GENERATEUR.reqNas(i + 1));
+		return v;
+	}();
+	return lesNas;
+}
+
+static void BM_concurrenteLecture(benchmark::State& p_etat)
+{
+	const CirconscriptionConcurrente& liste = listePartagee();
+	const std::vector<std::string>& lesNas = nasPartages();
+	std::size_t i = p_etat.thread_index() * 7919;
+
+	for (auto _ : p_etat)
+	{
+		benchmark::DoNotOptimize(liste.estInscrit(lesNas[i++ % lesNas.size()]));
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations());
+}
+BENCHMARK(BM_concurrenteLecture)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+
+/**
+ * Chaque fil inscrit puis retire un électeur qui lui est propre
+ */
+
+static void BM_concurrenteInscription(benchmark::State& p_etat)
+{
+	CirconscriptionConcurrente& liste = listePartagee();
+	Electeur electeur = electeurSynthetique(TAILLE_CONCURRENCE + p_etat.thread_index());
+
+	for (auto _ : p_etat)
+	{
+		liste.tenterInscrire(electeur);
+		liste.tenterDesinscrire(electeur.reqNas());
+	}
+	p_etat.SetItemsProcessed(2 * p_etat.iterations());
+}
+BENCHMARK(BM_concurrenteInscription)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+
+/**
+ * Référence: la même charge sur une Circonscription protégée par un mutex
+ */
+
+static void BM_mutexGlobalInscription(benchmark::State& p_etat)
+{
+	static std::mutex mutex;
+	static Circonscription liste(circonscriptionSynthetique(TAILLE_CONCURRENCE));
+	Electeur electeur = electeurSynthetique(TAILLE_CONCURRENCE + p_etat.thread_index());
+
+	for (auto _ : p_etat)
+	{
+		std::lock_guard<std::mutex> verrou(mutex);
+		liste.tenterInscrire(electeur);
+		liste.tenterDesinscrire(electeur.reqNas());
+	}
+	p_etat.SetItemsProcessed(2 * p_etat.iterations());
+}
+BENCHMARK(BM_mutexGlobalInscription)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+
+/**
+ * Dépouillement de 10 000 000 de bulletins répartis entre 20 candidats et
+ * 50 bureaux, sur 1, 4 ou 16 fils du bassin
+ */
+
+static void BM_depouillement(benchmark::State& p_etat)
+{
+	static const unsigned int NB_BULLETINS = 10000000;
+	Circonscription circonscription("Lac Saint-Jean", GENERATEUR.reqDepute());
+	for (unsigned int i = 0; i < 20; ++i)
+	{
+		Electeur e = electeurSynthetique(i);
+		circonscription.inscrire(Candidat(e.reqNas(), e.reqNom(), e.reqPrenom(), e.reqDateNaissance(), e.reqAdresse(),
+		                                  static_cast<PartisPolitiques>(i % util::NB_PARTIS)));
+	}
+	std::vector<Bulletin> bulletins(NB_BULLETINS);
+	std::uint64_t etat = 1;
+	for (Bulletin& b: bulletins)
+	{
+		etat = etat * 6364136223846793005ULL + 1442695040888963407ULL;
+		b.candidat = static_cast<std::uint32_t>((etat >> 33) % 21);
+		b.bureau = static_cast<std::uint32_t>((etat >> 17) % 50);
+	}
+	DepouillementBulletins depouillement(circonscription, 50, p_etat.range(0));
+
+	for (auto _ : p_etat)
+	{
+		depouillement.depouiller(bulletins);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * NB_BULLETINS);
+}
+BENCHMARK(BM_depouillement)->Arg(1)->Arg(4)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Transmissions et corrections de 1 000 bureaux pour 20 candidats, pendant
+ * que 0, 3 ou 15 fils lisent l'instantané en continu
+ */
+
+static void BM_resultatsEnDirect(benchmark::State& p_etat)
+{
+	static std::unique_ptr<ResultatsEnDirect> resultats;
+
+	if (p_etat.thread_index() == 0)
+	{
+		Circonscription circonscription("Lac Saint-Jean", GENERATEUR.reqDepute());
+		for (unsigned int i = 0; i < 20; ++i)
+		{
+			Electeur e = electeurSynthetique(i);
+			circonscription.inscrire(Candidat(e.reqNas(), e.reqNom(), e.reqPrenom(), e.reqDateNaissance(), e.reqAdresse(),
+			                                  static_cast<PartisPolitiques>(i % util::NB_PARTIS)));
+		}
+		resultats.reset(new ResultatsEnDirect(circonscription, 1000));
+	}
+	std::vector<std::uint64_t> voix(20, 0);
+	std::size_t bureau = 0;
+
+	for (auto _ : p_etat)
+	{
+		if (p_etat.thread_index() == 0)
+		{
+			voix[bureau % 20] += 1;
+			resultats->rapporter(bureau++ % 1000, voix);
+		}
+		else
+		{
+			benchmark::DoNotOptimize(resultats->reqInstantane()->voixParParti);
+		}
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations());
+}
+BENCHMARK(BM_resultatsEnDirect)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+
+/**
+ * Latence d'une inscription journalisée, forcée sur disque avant le retour
+ * (Arg 0, SYNCHRONE) ou dans les 2 ms (Arg 1, DIFFERE), avec 1, 4 ou 16 fils
+ * qui se partagent les forçages
+ */
+
+static void BM_journalInscription(benchmark::State& p_etat)
+{
+	static const std::string FICHIER = "bancEssaisJournal.circ";
+	static std::unique_ptr<JournalCirconscription> journal;
+
+	if (p_etat.thread_index() == 0)
+	{
+		std::remove((FICHIER + JournalCirconscription::EXTENSION_JOURNAL).c_str());
+		journal.reset(new JournalCirconscription(FICHIER, p_etat.range(0) == 0 ? JournalCirconscription::SYNCHRONE
+		                                                                       : JournalCirconscription::DIFFERE));
+	}
+	const Electeur electeur = electeurSynthetique(p_etat.thread_index());
+
+	for (auto _ : p_etat)
+	{
+		journal->journaliserInscription(electeur);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations());
+
+	if (p_etat.thread_index() == 0)
+	{
+		journal.reset();
+		std::remove((FICHIER + JournalCirconscription::EXTENSION_JOURNAL).c_str());
+	}
+}
+BENCHMARK(BM_journalInscription)->Arg(0)->Arg(1)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+
+/**
+ * Comparaison d'une liste de taille N avec une version à jour où 1 % des
+ * inscrits est retiré et autant est ajouté
+ */
+
+static void BM_deltaCirconscription(benchmark::State& p_etat)
+{
+	const unsigned int taille = p_etat.range(0);
+	const Circonscription& ancienne = circonscriptionSynthetique(taille);
+	Circonscription nouvelle(ancienne);
+	for (unsigned int i = 0; i < taille / 100; ++i)
+	{
+		nouvelle.desinscrire(electeurSynthetique(i * 100).reqNas());
+		nouvelle.inscrire(electeurSynthetique(taille + i));
+	}
+
+	for (auto _ : p_etat)
+	{
+		DeltaCirconscription delta(ancienne, nouvelle);
+		benchmark::DoNotOptimize(delta.reqNbAjouts());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * taille);
+}
+BENCHMARK(BM_deltaCirconscription)->Apply(taillesDeReference);
+
+/**
+ * Recherche des doublons dans une liste de taille N
+ */
+
+static void BM_detecterDoublons(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+
+	for (auto _ : p_etat)
+	{
+		benchmark::DoNotOptimize(detecterDoublons(circonscription));
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_detecterDoublons)->Apply(taillesDeReference);
+
+/**
+ * Validation de N codes postaux, dont un sur huit en minuscules
+ */
+
+static void BM_validerCodePostal(benchmark::State& p_etat)
+{
+	std::vector<std::string> codes;
+	for (unsigned int i = 0; i < p_etat.range(0); ++i)
+	{
+		codes.push_back(GENERATEUR.reqElecteur(i + 1).reqAdresse().reqCodePostal());
+		if (i % 8 == 0) codes.back()[2] = static_cast<char>(codes.back()[2] - 'A' + 'a');
+	}
+
+	for (auto _ : p_etat)
+	{
+		unsigned int nbValides = 0;
+		for (const std::string& code : codes) nbValides += util::validerCodePostal(code);
+		benchmark::DoNotOptimize(nbValides);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_validerCodePostal)->Apply(taillesDeReference);
+
+/**
+ * Construction de l'index des codes postaux d'une liste de taille N
+ */
+
+static void BM_indexCodesPostaux(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+
+	for (auto _ : p_etat)
+	{
+		IndexCodesPostaux index(circonscription);
+		benchmark::DoNotOptimize(index.reqNbInscrits());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_indexCodesPostaux)->Apply(taillesDeReference);
+
+/**
+ * Parcours des inscrits de chaque région de tri, comparé à un balayage de la
+ * liste par région: O(k) par région au lieu de O(N)
+ */
+
+static void BM_inscritsParRegion(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+	IndexCodesPostaux index(circonscription);
+	util::CodePostal code = (*circonscription.reqDebutInscrits())->reqAdresse().reqCodePostalCompact();
+
+	for (auto _ : p_etat)
+	{
+		std::size_t nbInscrits = 0;
+		IndexCodesPostaux::Intervalle_t region = index.reqInscritsRegion(code.reqRegionTri());
+		for (auto it = region.first; it != region.second; ++it) nbInscrits += (*it)->reqNas().size();
+		benchmark::DoNotOptimize(nbInscrits);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * index.reqNbInscritsRegion(code.reqRegionTri()));
+}
+BENCHMARK(BM_inscritsParRegion)->Apply(taillesDeReference);
+
+/**
+ * Analyse de N noms de provinces, français, anglais, abréviations et états
+ * américains mêlés
+ */
+
+static void BM_analyserProvince(benchmark::State& p_etat)
+{
+	std::vector<std::string> noms;
+	for (unsigned int i = 0; i < p_etat.range(0); ++i)
+	{
+		util::Province province = static_cast<util::Province>(i % util::NB_PROVINCES);
+		switch (i % 4)
+		{
+		case 0: noms.push_back(util::reqNomProvince(province)); break;
+		case 1: noms.push_back(util::reqNomAnglaisProvince(province)); break;
+		case 2: noms.push_back(util::reqAbreviationProvince(province)); break;
+		default: noms.push_back("NY");
+		}
+	}
+
+	for (auto _ : p_etat)
+	{
+		unsigned int nbValides = 0;
+		for (const std::string& nom : noms) nbValides += util::analyserProvince(nom).estValide();
+		benchmark::DoNotOptimize(nbValides);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_analyserProvince)->Apply(taillesDeReference);
+
+/**
+ * Décompte des inscrits par province d'une liste de taille N
+ */
+
+static void BM_reqNbInscritsParProvince(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+
+	for (auto _ : p_etat)
+	{
+		benchmark::DoNotOptimize(circonscription.reqNbInscritsParProvince());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_reqNbInscritsParProvince)->Apply(taillesDeReference);
+
+/**
+ * Validation de chaque inscrit d'une liste de taille N: appel virtuel
+ * (Arg 0) ou visite par le type (Arg 1)
+ */
+
+static void BM_validerInscrits(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+	const bool parVisite = p_etat.range(1) != 0;
+
+	for (auto _ : p_etat)
+	{
+		std::size_t nbValides = 0;
+		for (auto it = circonscription.reqDebutInscrits(); it != circonscription.reqFinInscrits(); ++it)
+			nbValides += parVisite ? validerPersonne(**it) : (*it)->valider();
+		benchmark::DoNotOptimize(nbValides);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_validerInscrits)->ArgsProduct({{1000, 100000, 1000000}, {0, 1}});
+
+/**
+ * Sélection des candidats d'une liste de taille N: dynamic_cast (Arg 0) ou
+ * type de la personne (Arg 1)
+ */
+
+static void BM_selectionCandidats(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+	const bool parType = p_etat.range(1) != 0;
+
+	for (auto _ : p_etat)
+	{
+		std::size_t nbCandidats = 0;
+		for (auto it = circonscription.reqDebutInscrits(); it != circonscription.reqFinInscrits(); ++it)
+			nbCandidats += (parType ? commeCandidat(**it) : dynamic_cast<const Candidat*>(*it)) != nullptr;
+		benchmark::DoNotOptimize(nbCandidats);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_selectionCandidats)->ArgsProduct({{1000, 100000, 1000000}, {0, 1}});
+
+/**
+ * Formatage de chaque inscrit d'une liste de 10 000: appel virtuel (Arg 0)
+ * ou visite par le type (Arg 1)
+ */
+
+static void BM_formaterInscrits(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(10000);
+	const bool parVisite = p_etat.range(0) != 0;
+
+	for (auto _ : p_etat)
+	{
+		std::size_t taille = 0;
+		for (auto it = circonscription.reqDebutInscrits(); it != circonscription.reqFinInscrits(); ++it)
+			taille += (parVisite ? formaterPersonne(**it) : (*it)->reqPersonneFormate()).size();
+		benchmark::DoNotOptimize(taille);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * 10000);
+}
+BENCHMARK(BM_formaterInscrits)->Arg(0)->Arg(1);
+
+/**
+ * Copie puis destruction d'une liste de taille N, les inscrits alloués par
+ * new (Arg 0), dans une std::pmr::monotonic_buffer_resource (Arg 1) ou une
+ * std::pmr::unsynchronized_pool_resource (Arg 2)
+ */
+
+static void BM_copieDansRessource(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(p_etat.range(0));
+
+	for (auto _ : p_etat)
+	{
+		std::pmr::monotonic_buffer_resource arene;
+		std::pmr::unsynchronized_pool_resource bassin;
+		std::pmr::memory_resource* ressources[] = {nullptr, &arene, &bassin};
+
+		Circonscription copie(circonscription, ressources[p_etat.range(1)]);
+		benchmark::DoNotOptimize(copie.reqNbInscrits());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_copieDansRessource)->ArgsProduct({{1000, 100000}, {0, 1, 2}})->Unit(benchmark::kMillisecond);
+
+/**
+ * Même copie, avec des adresses réalistes dont la rue et la ville dépassent
+ * la capacité locale de std::string (15 caractères avec libstdc++): ces deux
+ * chaînes restent allouées par new, hors de la ressource
+ */
+
+static void BM_copieDansRessourceAdressesLongues(benchmark::State& p_etat)
+{
+	static std::map<unsigned int, std::unique_ptr<Circonscription> > cache;
+
+	std::unique_ptr<Circonscription>& circonscription = cache[p_etat.range(0)];
+	if (!circonscription)
+	{
+		circonscription.reset(new Circonscription("Saint-Jean", GENERATEUR.reqDepute()));
+		for (unsigned int i = 0; i < p_etat.range(0); ++i)
+		{
+			Electeur electeur = electeurSynthetique(i);
+			circonscription->inscrire(Electeur(electeur.reqNas(), electeur.reqNom(), electeur.reqPrenom(), electeur.reqDateNaissance(),
+			                                   util::Adresse(1 + i % 2000, "boulevard René-Lévesque Est", "Saint-Jean-sur-Richelieu",
+			                                                 electeur.reqAdresse().reqCodePostal(), "Québec")));
+		}
+	}
+
+	for (auto _ : p_etat)
+	{
+		std::pmr::monotonic_buffer_resource arene;
+		std::pmr::unsynchronized_pool_resource bassin;
+		std::pmr::memory_resource* ressources[] = {nullptr, &arene, &bassin};
+
+		Circonscription copie(*circonscription, ressources[p_etat.range(1)]);
+		benchmark::DoNotOptimize(copie.reqNbInscrits());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_copieDansRessourceAdressesLongues)->ArgsProduct({{1000, 100000}, {0, 1, 2}})->Unit(benchmark::kMillisecond);
+
+/**
+ * Inscription des N électeurs d'une liste dans une liste vide: inscription
+ * vérifiée (Arg 0) ou de confiance, sans revalidation (Arg 1)
+ */
+
+static void BM_inscrireDejaValide(benchmark::State& p_etat)
+{
+	const Circonscription& source = circonscriptionSynthetique(p_etat.range(0));
+	const bool confiance = p_etat.range(1) != 0;
+
+	for (auto _ : p_etat)
+	{
+		Circonscription circonscription("Lac Saint-Jean", GENERATEUR.reqDepute());
+		for (auto it = source.reqDebutInscrits(); it != source.reqFinInscrits(); ++it)
+		{
+			if (confiance) circonscription.tenterInscrire(**it, util::DEJA_VALIDE);
+			else circonscription.tenterInscrire(**it);
+		}
+		benchmark::DoNotOptimize(circonscription.reqNbInscrits());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_inscrireDejaValide)->ArgsProduct({{1000, 100000}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+/**
+ * Rafraîchissement répété de l'affichage d'une liste de taille N: texte
+ * reconstruit (Arg 0) ou mémorisé par inscrit (Arg 1).  La liste est une
+ * copie, pour ne pas garder les textes des autres bancs en mémoire.
+ */
+
+static void BM_reqCirconscriptionFormateMemorise(benchmark::State& p_etat)
+{
+	const Circonscription circonscription(circonscriptionSynthetique(p_etat.range(0)));
+	const bool memoriser = p_etat.range(1) != 0;
+
+	for (auto _ : p_etat)
+	{
+		std::string texte = circonscription.reqCirconscriptionFormate(memoriser);
+		benchmark::DoNotOptimize(texte.data());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_reqCirconscriptionFormateMemorise)->ArgsProduct({{1000, 100000}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+/**
+ * Formatage de la date de naissance des inscrits d'une liste de 10 000
+ *
+ * Arg 0: comme l'ancien Date::reqDateFormatee(), un ostringstream et cinq
+ * décompositions de la date
+ * Arg 1: reqDateFormatee()
+ * Arg 2: formaterDate() dans un tampon réutilisé
+ * Arg 3: formaterDates() sur le tableau des dates
+ */
+
+static std::string formaterDateParFlux(const util::Date& p_date)
+{
+	static const char* const JOURS[] = {"Dimanche", "Lundi", "Mardi", "Mercredi", "Jeudi", "Vendredi", "Samedi"};
+	static const char* const MOIS[] = {"janvier", "fevrier", "mars", "avril", "mai", "juin", "juillet", "aout",
+	                                   "septembre", "octobre", "novembre", "decembre"};
+	static const int DECALAGES[] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+	std::ostringstream os;
+
+	long annee = p_date.reqAnnee() - (p_date.reqMois() < 3);
+	long jourSemaine = (annee + annee / 4 - annee / 100 + annee / 400 + DECALAGES[p_date.reqMois() - 1] + p_date.reqJour()) % 7;
+
+	os << JOURS[jourSemaine] << " le ";
+	if (p_date.reqJour() < 10) os << "0";
+	os << p_date.reqJour() << " " << MOIS[p_date.reqMois() - 1] << " " << p_date.reqAnnee();
+	return os.str();
+}
+
+static void BM_formaterDates(benchmark::State& p_etat)
+{
+	const Circonscription& circonscription = circonscriptionSynthetique(10000);
+	std::vector<util::Date> dates;
+	for (auto it = circonscription.reqDebutInscrits(); it != circonscription.reqFinInscrits(); ++it)
+		dates.push_back((*it)->reqDateNaissance());
+	std::vector<char> tampon(dates.size() * (util::Date::TAILLE_MAX_DATE_FORMATEE + 1));
+
+	for (auto _ : p_etat)
+	{
+		std::size_t taille = 0;
+		switch (p_etat.range(0))
+		{
+		case 0:
+			for (const util::Date& date: dates) taille += formaterDateParFlux(date).size();
+			break;
+		case 1:
+			for (const util::Date& date: dates) taille += date.reqDateFormatee().size();
+			break;
+		case 2:
+			for (const util::Date& date: dates)
+				taille += date.formaterDate(tampon.data(), tampon.data() + tampon.size()) - tampon.data();
+			break;
+		default:
+			taille = util::Date::formaterDates(dates.data(), dates.size(), tampon.data(), tampon.data() + tampon.size()) - tampon.data();
+		}
+		benchmark::DoNotOptimize(taille);
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * dates.size());
+}
+BENCHMARK(BM_formaterDates)->DenseRange(0, 3);
+
+/**
+ * Construction de l'index alphabétique d'une liste de taille N, dans le fil
+ * appelant (Arg 0) ou par un bassin de 4 fils (Arg 4)
+ */
+
+static void BM_indexerParNom(benchmark::State& p_etat)
+{
+	Circonscription circonscription(circonscriptionSynthetique(p_etat.range(0)));
+	util::BassinDeTaches bassin(4);
+
+	for (auto _ : p_etat)
+	{
+		circonscription.indexerParNom(p_etat.range(1) ? &bassin : nullptr);
+		benchmark::DoNotOptimize(circonscription.reqIndexAlphabetique());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_indexerParNom)->ArgsProduct({{1000, 100000}, {0, 4}})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Découpage d'une liste de taille N en 40 sections de vote, listes
+ * alphabétiques triées dans le fil appelant (Arg 0) ou par un bassin de 4 fils
+ * (Arg 4)
+ */
+
+static void BM_sectionsDeVote(benchmark::State& p_etat)
+{
+	Circonscription circonscription(circonscriptionSynthetique(p_etat.range(0)));
+	util::BassinDeTaches bassin(4);
+
+	for (auto _ : p_etat)
+	{
+		SectionsDeVote sections(circonscription, 40, p_etat.range(1) ? &bassin : nullptr);
+		benchmark::DoNotOptimize(sections.reqNbSections());
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * p_etat.range(0));
+}
+BENCHMARK(BM_sectionsDeVote)->ArgsProduct({{1000, 100000}, {0, 4}})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Redécoupage: la moitié des 10 000 inscrits d'une circonscription passe dans
+ * une autre et revient, par désinscription et inscription (Arg 0) ou par
+ * transfererSi sans copie (Arg 1)
+ */
+
+static void BM_transfererSi(benchmark::State& p_etat)
+{
+	Circonscription source(circonscriptionSynthetique(10000));
+	Circonscription destination("Chicoutimi", source.reqDeputeElu());
+	auto pair = [](const Personne& p) { return (p.reqNas().back() - '0') % 2 == 0; };
+	auto tous = [](const Personne&) { return true; };
+
+	for (auto _ : p_etat)
+	{
+		if (p_etat.range(0))
+		{
+			source.transfererSi(pair, destination);
+			destination.transfererSi(tous, source);
+			continue;
+		}
+		std::vector<std::string> transferes;
+		for (auto it = source.reqDebutInscrits(); it != source.reqFinInscrits(); ++it)
+			if (pair(**it)) transferes.push_back((*it)->reqNas());
+		for (const std::string& nas: transferes)
+		{
+			destination.inscrire(*source.reqInscrit(nas));
+			source.desinscrire(nas);
+		}
+		for (const std::string& nas: transferes)
+		{
+			source.inscrire(*destination.reqInscrit(nas));
+			destination.desinscrire(nas);
+		}
+	}
+	p_etat.SetItemsProcessed(p_etat.iterations() * source.reqNbInscrits());
+}
+BENCHMARK(BM_transfererSi)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/**
+ * Vue stable d'une liste de taille N pour un rapport: copie profonde de la
+ * Circonscription (Arg 0) ou instantané partagé (Arg 1)
+ */
+
+static void BM_reqInstantane(benchmark::State& p_etat)
+{
+	Circonscription circonscription(circonscriptionSynthetique(p_etat.range(0)));
+	circonscription.activerInstantanes();
+
+	for (auto _ : p_etat)
+	{
+		if (p_etat.range(1))
+		{
+			InstantaneCirconscription instantane = circonscription.reqInstantane();
+			benchmark::DoNotOptimize(instantane.reqNbInscrits());
+		}
+		else
+		{
+			Circonscription copie(circonscription);
+			benchmark::DoNotOptimize(copie.reqNbInscrits());
+		}
+	}
+}
+BENCHMARK(BM_reqInstantane)->ArgsProduct({{1000, 100000}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
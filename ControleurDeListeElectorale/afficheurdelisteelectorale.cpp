@@ -17,7 +17,7 @@ AfficheurDeListeElectorale::AfficheurDeListeElectorale(elections::Circonscriptio
 
 	elections::Circonscription* circonscription = circ;
 
-	liste = new QPlainTextEdit(convertirTexte(circonscription->reqCirconscriptionFormate()));
+	liste = new QPlainTextEdit(convertirTexte(circonscription->reqCirconscriptionFormate(true)));
 	liste->setReadOnly(true);
 	boutonNouvelElecteur = new QPushButton(TXT_BOUTON_ELECTEUR);
 	boutonNouveauCandidat = new QPushButton(TXT_BOUTON_CANDIDAT);
@@ -53,7 +53,7 @@ QPushButton* AfficheurDeListeElectorale::reqBoutonCreerNouveauCandidat()
 void AfficheurDeListeElectorale::rafraichir(const elections::Circonscription* circonscription)
 {
     liste->clear();
-    liste->setPlainText(convertirTexte(circonscription->reqCirconscriptionFormate()));
+    liste->setPlainText(convertirTexte(circonscription->reqCirconscriptionFormate(true)));
 }
 
 AfficheurDeListeElectorale::~AfficheurDeListeElectorale()
@@ -1,9 +1,11 @@
 #include "controleurdelisteelectorale.h"
 #include "PersonneException.h"
 #include <iostream>
+#include <fstream>
 
 const QString TXT_MENU_FICHIER = QString::fromUtf8("&Fichier");
 const QString TXT_MENU_ACTIONS = QString::fromUtf8("&Opérations");
+const QString TXT_MENU_EDITION = QString::fromUtf8("&Édition");
 const QString TXT_NOUVEAU_ACTION = QString::fromUtf8("&Nouvelle circonscription");
 const QString TXT_SAUVEGARDER_ACTION = QString::fromUtf8("&Sauvegarder");
 const QString TXT_RECUPERER_ACTION = QString::fromUtf8("&Récupérer");
@@ -11,27 +13,49 @@ const QString TXT_QUITTER_ACTION = QString::fromUtf8("&Quitter");
 const QString TXT_NOUVELECTEUR_ACTION = QString::fromUtf8("Nouvel &électeur");
 const QString TXT_NOUVCANDIDAT_ACTION = QString::fromUtf8("Nouveau &candidat");
 const QString TXT_DESINSCRIRE_ACTION = QString::fromUtf8("&Désinscrire");
-const QString TXT_DESINSCRIRE_CONFIRMATION = QString::fromUtf8("Êtes-vous certain de vouloir désinscrire cet électeur? Cette action est irréversible!");
+const QString TXT_CHANGERADRESSE_ACTION = QString::fromUtf8("Changer d'&adresse");
+const QString TXT_CHANGERADRESSE_TITRE = QString::fromUtf8("Changement d'adresse");
+const QString TXT_ANNULER_ACTION = QString::fromUtf8("&Annuler %1");
+const QString TXT_RETABLIR_ACTION = QString::fromUtf8("&Rétablir %1");
+const QString TXT_MODIFICATIONS[] = { QString::fromUtf8("l'inscription"), QString::fromUtf8("la désinscription"),
+                                      QString::fromUtf8("le changement d'adresse") };
+const QString TXT_DESINSCRIRE_CONFIRMATION = QString::fromUtf8("Êtes-vous certain de vouloir désinscrire cet électeur? Le menu Édition permet de l'annuler.");
 const QString TXT_ATTENTION = QString::fromUtf8("Attention!");
 const QString TXT_NAS_INEXISTANT = QString::fromUtf8("Numéro inexistant!");
 const QString TXT_PERSONNE_ABSENTE = QString::fromUtf8("Désolé, le numéro %1 n'est pas dans la liste électorale.");
 const QString TXT_ERREUR_INSCRIPTION = QString::fromUtf8("Erreur d'inscription!");
 const QString TXT_PERSONNE_PRESENTE = QString::fromUtf8("Une personne avec ce numéro existe déjà dans la liste");
+const QString TXT_SAUVEGARDE_EN_COURS = QString::fromUtf8("Sauvegarde en cours...");
+const QString TXT_RECUPERATION_EN_COURS = QString::fromUtf8("Récupération en cours...");
+const QString TXT_ANNULER = QString::fromUtf8("&Annuler");
+const QString TXT_ERREUR_SAUVEGARDE = QString::fromUtf8("Erreur de sauvegarde!");
+const QString TXT_ERREUR_RECUPERATION = QString::fromUtf8("Erreur de récupération!");
+const QString TXT_ERREUR_JOURNAL = QString::fromUtf8("Erreur de journalisation!");
+const QString TXT_REMPLACEMENT_IMPOSSIBLE = QString::fromUtf8("Impossible de remplacer %1. La nouvelle sauvegarde est restée dans %2.");
+const QString TXT_ERREUR_ANNULATION = QString::fromUtf8("La liste a changé: cette modification ne peut plus être annulée ou rétablie.");
+const QString EXTENSION_TEMPORAIRE = QString::fromUtf8(".tmp");
+
+const int PERIODE_PROGRESSION_MS = 100;
+const int PROGRESSION_MAX = 1000;
+const unsigned int SEUIL_COMPACTAGE = 10000;
 
 // Classe ControleurDeListeElectorale
 // Fenêtre principale de notre programme de gestion de liste électorale.
 // Son rôle est de coordonner l'affichage de la liste, par un widget AfficheurDeListeElectorale qui est le central widget
 // Et permettre l'inscription ainsi que la désinscription d'électeurs sur la liste.
+// Toutes les modifications passent par l'historique, qui permet de les annuler et de les rétablir.
 
 
 ControleurDeListeElectorale::ControleurDeListeElectorale(QWidget *parent)
     : QMainWindow(parent)
 {
 
+    historique = new elections::HistoriqueModifications;
     initialiserCirconscription();
 	initialiserBarreDeMenu();
 	initialiserAfficheur();
 	initialiserFenetrePrincipale();
+	initialiserTraitementsEnArrierePlan();
 }
 
 void ControleurDeListeElectorale::initialiserCirconscription()
@@ -44,6 +68,7 @@ void ControleurDeListeElectorale::initialiserCirconscription()
 void ControleurDeListeElectorale::initialiserBarreDeMenu()
 {
 	initialiserMenuFichier();
+	initialiserMenuEdition();
     initialiserMenuActions();
 }
 
@@ -75,6 +100,32 @@ void ControleurDeListeElectorale::initialiserFenetrePrincipale()
 
 }
 
+// La sauvegarde et la récupération s'exécutent dans un fil de travail (QtConcurrent).
+// Le fil principal affiche la progression en interrogeant périodiquement l'objet SuiviTraitement,
+// et ne touche à la circonscription qu'une fois le traitement terminé.
+
+void ControleurDeListeElectorale::initialiserTraitementsEnArrierePlan()
+{
+	surveillantSauvegarde = new QFutureWatcher<bool>(this);
+	surveillantRecuperation = new QFutureWatcher<elections::Circonscription*>(this);
+
+	dialogueProgression = new QProgressDialog(this);
+	dialogueProgression->setWindowModality(Qt::WindowModal);
+	dialogueProgression->setCancelButtonText(TXT_ANNULER);
+	dialogueProgression->setRange(0, PROGRESSION_MAX);
+	dialogueProgression->setAutoClose(false);
+	dialogueProgression->setAutoReset(false);
+	dialogueProgression->hide();
+
+	minuterieProgression = new QTimer(this);
+	minuterieProgression->setInterval(PERIODE_PROGRESSION_MS);
+
+	connect(surveillantSauvegarde, SIGNAL(finished()), this, SLOT(sauvegardeTerminee()));
+	connect(surveillantRecuperation, SIGNAL(finished()), this, SLOT(recuperationTerminee()));
+	connect(minuterieProgression, SIGNAL(timeout()), this, SLOT(actualiserProgression()));
+	connect(dialogueProgression, SIGNAL(canceled()), this, SLOT(annulerTraitement()));
+}
+
 void ControleurDeListeElectorale::initialiserMenuActions()
 {
 	menuActions = menuBar()->addMenu(TXT_MENU_ACTIONS);
@@ -82,17 +133,48 @@ void ControleurDeListeElectorale::initialiserMenuActions()
 	actionCreerNouvelElecteur = new QAction(TXT_NOUVELECTEUR_ACTION, this);
 	actionCreerNouveauCandidat = new QAction(TXT_NOUVCANDIDAT_ACTION, this);
 	actionDesinscrire = new QAction(TXT_DESINSCRIRE_ACTION, this);
+	actionChangerAdresse = new QAction(TXT_CHANGERADRESSE_ACTION, this);
 
 	menuActions->addAction(actionCreerNouvelElecteur);
 	menuActions->addAction(actionCreerNouveauCandidat);
 	menuActions->addAction(actionDesinscrire);
+	menuActions->addAction(actionChangerAdresse);
 
 	connect(actionCreerNouvelElecteur, SIGNAL(triggered()), this, SLOT(creerNouvelElecteur()));
 	connect(actionCreerNouveauCandidat, SIGNAL(triggered()), this, SLOT(creerNouveauCandidat()));
 	connect(actionDesinscrire, SIGNAL(triggered()), this, SLOT(desinscrire()));
+	connect(actionChangerAdresse, SIGNAL(triggered()), this, SLOT(changerAdresse()));
 
 }
 
+void ControleurDeListeElectorale::initialiserMenuEdition()
+{
+	menuEdition = menuBar()->addMenu(TXT_MENU_EDITION);
+
+	actionAnnuler = new QAction(this);
+	actionAnnuler->setShortcut(QKeySequence::Undo);
+	actionRetablir = new QAction(this);
+	actionRetablir->setShortcut(QKeySequence::Redo);
+
+	menuEdition->addAction(actionAnnuler);
+	menuEdition->addAction(actionRetablir);
+
+	connect(actionAnnuler, SIGNAL(triggered()), this, SLOT(annuler()));
+	connect(actionRetablir, SIGNAL(triggered()), this, SLOT(retablir()));
+
+	actualiserMenuEdition();
+}
+
+// Le texte des actions nomme la modification qu'elles déferont ou referont.
+
+void ControleurDeListeElectorale::actualiserMenuEdition()
+{
+	actionAnnuler->setEnabled(historique->peutAnnuler());
+	actionAnnuler->setText(TXT_ANNULER_ACTION.arg(historique->peutAnnuler() ? TXT_MODIFICATIONS[historique->reqTypeAnnulation()] : QString()).trimmed());
+	actionRetablir->setEnabled(historique->peutRetablir());
+	actionRetablir->setText(TXT_RETABLIR_ACTION.arg(historique->peutRetablir() ? TXT_MODIFICATIONS[historique->reqTypeRetablissement()] : QString()).trimmed());
+}
+
 void ControleurDeListeElectorale::initialiserMenuFichier()
 {
 	menuFichier = menuBar()->addMenu(TXT_MENU_FICHIER);
@@ -100,9 +182,7 @@ void ControleurDeListeElectorale::initialiserMenuFichier()
 	actionNouveau = new QAction(TXT_NOUVEAU_ACTION, this);
 	actionNouveau->setEnabled(false);
 	actionSauvegarder = new QAction(TXT_SAUVEGARDER_ACTION, this);
-	actionSauvegarder->setEnabled(false);
 	actionRecuperer = new QAction(TXT_RECUPERER_ACTION, this);
-	actionRecuperer->setEnabled(false);
 	actionQuitter = new QAction(TXT_QUITTER_ACTION, this);
 
 	connect(actionNouveau, SIGNAL(triggered()), this, SLOT(nouveau()));
@@ -126,8 +206,6 @@ void ControleurDeListeElectorale::nouveau()
 
 void ControleurDeListeElectorale::sauvegarder()
 {
-	// TODO implémenter en JSON?
-
 	static const QString message = QString::fromUtf8("Sauvegarde des données");
 	static const QString typeFichier = QString::fromUtf8("Circonscription (*.circ); ; Tous (*)");
 	static const QString messageErreur = QString::fromUtf8("Fichier impossible à ouvrir.");
@@ -135,20 +213,23 @@ void ControleurDeListeElectorale::sauvegarder()
 	QString nomFichier = QFileDialog::getSaveFileName(this, message, "", typeFichier);
 	if (nomFichier.isEmpty()) return;
 
-	QFile fichier(nomFichier);
+	// On écrit dans un fichier temporaire, renommé seulement si la sauvegarde se termine:
+	// une annulation ou une erreur ne détruit pas l'ancienne version du fichier.
+
+	QFile fichier(nomFichier + EXTENSION_TEMPORAIRE);
 	if (!fichier.open(QIODevice::WriteOnly)) {
 		QMessageBox::information(this, messageErreur, fichier.errorString());
 		return;
 	}
+	fichier.close();
 
-	std::cerr << "Sauvegarde pas encore implémentée\n";
-
+	fichierDestination = nomFichier;
+	demarrerTraitement(TXT_SAUVEGARDE_EN_COURS, circonscription->reqNbInscrits());
+	surveillantSauvegarde->setFuture(QtConcurrent::run(&ControleurDeListeElectorale::sauvegarderEnArrierePlan, this, nomFichier + EXTENSION_TEMPORAIRE));
 }
 
 void ControleurDeListeElectorale::recuperer()
 {
-	// TODO implémenter en JSON?
-
 	static const QString message = QString::fromUtf8("Récupération des données");
 	static const QString typeFichier = QString::fromUtf8("Circonscription (*.circ); ; Tous (*)");
 	static const QString messageErreur = QString::fromUtf8("Fichier impossible à ouvrir.");
@@ -161,10 +242,198 @@ void ControleurDeListeElectorale::recuperer()
 		QMessageBox::information(this, messageErreur, fichier.errorString());
 		return;
 	}
+	qint64 taille = fichier.size();
+	fichier.close();
+
+	fichierDestination = nomFichier;
+	demarrerTraitement(TXT_RECUPERATION_EN_COURS, taille);
+	surveillantRecuperation->setFuture(QtConcurrent::run(&ControleurDeListeElectorale::recupererEnArrierePlan, this, nomFichier));
+}
+
+// Exécutée dans le fil de travail.  La circonscription courante n'est que lue: le dialogue de progression
+// est modal, aucune inscription ne peut survenir pendant la sauvegarde.
+
+bool ControleurDeListeElectorale::sauvegarderEnArrierePlan(ControleurDeListeElectorale* controleur, QString nomFichier)
+{
+	std::ofstream fichier(nomFichier.toLocal8Bit().constData(), std::ios::binary);
+	bool reussi = false;
+	try
+	{
+		reussi = elections::sauvegarderCirconscription(fichier, *controleur->circonscription, controleur->suivi);
+	}
+	catch (std::exception& e)
+	{
+		controleur->erreurTraitement = QString::fromUtf8(e.what());
+	}
+	return reussi;
+}
+
+// Exécutée dans le fil de travail.  La nouvelle circonscription est construite à part; elle ne remplace
+// la courante qu'à la fin, dans le fil principal (recuperationTerminee).
+
+elections::Circonscription* ControleurDeListeElectorale::recupererEnArrierePlan(ControleurDeListeElectorale* controleur, QString nomFichier)
+{
+	std::ifstream fichier(nomFichier.toLocal8Bit().constData(), std::ios::binary);
+	elections::Circonscription* nouvelle = nullptr;
+	try
+	{
+		nouvelle = elections::recupererCirconscription(fichier, controleur->suivi);
+	}
+	catch (std::exception& e)
+	{
+		controleur->erreurTraitement = QString::fromUtf8(e.what());
+	}
+	return nouvelle;
+}
+
+void ControleurDeListeElectorale::demarrerTraitement(const QString& message, double total)
+{
+	delete suivi;
+	suivi = new elections::SuiviTraitement;
+	erreurTraitement.clear();
+	echelleProgression = (total > 0) ? PROGRESSION_MAX / total : 0;
+
+	actionSauvegarder->setEnabled(false);
+	actionRecuperer->setEnabled(false);
+
+	dialogueProgression->setLabelText(message);
+	dialogueProgression->setValue(0);
+	dialogueProgression->show();
+	minuterieProgression->start();
+}
+
+void ControleurDeListeElectorale::terminerTraitement()
+{
+	minuterieProgression->stop();
+	dialogueProgression->hide();
+
+	actionSauvegarder->setEnabled(true);
+	actionRecuperer->setEnabled(true);
+}
+
+void ControleurDeListeElectorale::actualiserProgression()
+{
+	int valeur = static_cast<int>(suivi->reqProgression() * echelleProgression);
+	dialogueProgression->setValue(qMin(valeur, PROGRESSION_MAX));
+}
+
+void ControleurDeListeElectorale::annulerTraitement()
+{
+	if (suivi) suivi->annuler();
+}
 
-	std::cerr << "Récupération pas encore implémentée\n";
+void ControleurDeListeElectorale::sauvegardeTerminee()
+{
+	terminerTraitement();
+
+	QString temporaire = fichierDestination + EXTENSION_TEMPORAIRE;
+	if (surveillantSauvegarde->result())
+	{
+		// Sans remplacement, l'ancienne sauvegarde et son journal restent les seuls à jour:
+		// la nouvelle est laissée dans le fichier temporaire.
+
+		if (!elections::remplacerFichier(temporaire.toLocal8Bit().constData(), fichierDestination.toLocal8Bit().constData()))
+		{
+			QMessageBox::information(this, TXT_ERREUR_SAUVEGARDE, TXT_REMPLACEMENT_IMPOSSIBLE.arg(fichierDestination, temporaire));
+			return;
+		}
 
+		// La sauvegarde contient tout: le journal repart à vide.
 
+		ouvrirJournal(fichierDestination);
+		try
+		{
+			if (journal) journal->reinitialiser();
+		}
+		catch (elections::JournalException& e)
+		{
+			QMessageBox::information(this, TXT_ERREUR_JOURNAL, QString::fromUtf8(e.what()));
+		}
+	}
+	else
+	{
+		QFile::remove(temporaire);
+		if (!erreurTraitement.isEmpty())
+			QMessageBox::information(this, TXT_ERREUR_SAUVEGARDE, erreurTraitement);
+	}
+}
+
+void ControleurDeListeElectorale::recuperationTerminee()
+{
+	terminerTraitement();
+
+	elections::Circonscription* nouvelle = surveillantRecuperation->result();
+	if (nouvelle == nullptr)
+	{
+		if (!erreurTraitement.isEmpty())
+			QMessageBox::information(this, TXT_ERREUR_RECUPERATION, erreurTraitement);
+		return;
+	}
+
+	// Échange dans le fil principal: l'affichage ne voit jamais une circonscription partiellement chargée.
+
+	std::swap(circonscription, nouvelle);
+	delete nouvelle;
+	historique->vider();
+
+	// Les modifications journalisées après la sauvegarde récupérée sont rejouées.
+
+	ouvrirJournal(fichierDestination);
+	try
+	{
+		if (journal) journal->rejouer(*circonscription);
+	}
+	catch (std::exception& e)
+	{
+		QMessageBox::information(this, TXT_ERREUR_RECUPERATION, QString::fromUtf8(e.what()));
+	}
+
+	afficheur->rafraichir(circonscription);
+	actualiserMenuEdition();
+	std::string titre = "Circonscription: " + circonscription->reqNomCirconscription();
+	setWindowTitle(QString::fromStdString(titre));
+}
+
+// Chaque sauvegarde a son journal, fichier voisin où sont ajoutées les inscriptions et les
+// désinscriptions faites depuis.  Sans journal ouvert, les modifications ne sont qu'en mémoire.
+
+void ControleurDeListeElectorale::ouvrirJournal(const QString& nomFichier)
+{
+	delete journal;
+	journal = nullptr;
+	try
+	{
+		journal = new elections::JournalCirconscription(nomFichier.toLocal8Bit().constData());
+	}
+	catch (std::exception& e)
+	{
+		QMessageBox::information(this, TXT_ERREUR_JOURNAL, QString::fromUtf8(e.what()));
+	}
+	historique->asgJournal(journal);
+}
+
+// Lancent les mêmes exceptions que Circonscription::inscrire et desinscrire.  L'historique écrit
+// au journal, s'il y en a un; le journal est compacté dans la sauvegarde lorsqu'il devient long.
+
+void ControleurDeListeElectorale::inscrireEtJournaliser(const elections::Personne& personne)
+{
+	if (historique->inscrire(*circonscription, personne).reqErreur() == util::PERSONNE_DEJA_PRESENTE)
+		throw PersonneDejaPresenteException(personne.reqNas());
+	compacterJournal();
+}
+
+void ControleurDeListeElectorale::desinscrireEtJournaliser(const std::string& nas)
+{
+	if (historique->desinscrire(*circonscription, nas).reqErreur() == util::PERSONNE_ABSENTE)
+		throw PersonneAbsenteException(nas);
+	compacterJournal();
+}
+
+void ControleurDeListeElectorale::compacterJournal()
+{
+	if (journal and journal->reqNbEnregistrements() >= SEUIL_COMPACTAGE)
+		journal->compacter(*circonscription);
+	actualiserMenuEdition();
 }
 
 void ControleurDeListeElectorale::quitter()
@@ -181,12 +450,16 @@ void ControleurDeListeElectorale::creerNouvelElecteur()
 		try
 		{
 			p = inscripteurElecteur->reqPersonne();
-		    circonscription->inscrire( *p );
+		    inscrireEtJournaliser( *p );
 		}
 		catch(PersonneDejaPresenteException& e)
 		{
 			QMessageBox::information(this, TXT_ERREUR_INSCRIPTION, TXT_PERSONNE_PRESENTE);
 		}
+		catch(elections::JournalException& e)
+		{
+			QMessageBox::information(this, TXT_ERREUR_JOURNAL, QString::fromUtf8(e.what()));
+		}
 		delete p;
 	}
 	afficheur->rafraichir(circonscription);
@@ -202,12 +475,16 @@ void ControleurDeListeElectorale::creerNouveauCandidat()
 		try
 		{
 			p = inscripteurCandidat->reqPersonne();
-		    circonscription->inscrire( *p );
+		    inscrireEtJournaliser( *p );
 		}
 		catch(PersonneDejaPresenteException& e)
 		{
 			QMessageBox::information(this, TXT_ERREUR_INSCRIPTION, TXT_PERSONNE_PRESENTE);
 		}
+		catch(elections::JournalException& e)
+		{
+			QMessageBox::information(this, TXT_ERREUR_JOURNAL, QString::fromUtf8(e.what()));
+		}
 		delete p;
 	}
 	afficheur->rafraichir(circonscription);
@@ -226,21 +503,97 @@ void ControleurDeListeElectorale::desinscrire()
 		{
 			try
 			{
-			    circonscription->desinscrire(nasADesinscrire.toStdString());
+			    desinscrireEtJournaliser(nasADesinscrire.toStdString());
 			}
 			catch(PersonneAbsenteException& e)
 			{
 				QMessageBox::information(this, TXT_NAS_INEXISTANT, TXT_PERSONNE_ABSENTE.arg(nasADesinscrire));
 			    return;
 			}
+			catch(elections::JournalException& e)
+			{
+				QMessageBox::information(this, TXT_ERREUR_JOURNAL, QString::fromUtf8(e.what()));
+			    return;
+			}
 			afficheur->rafraichir(circonscription);
 		}
 	}
 	desinscripteur->hide();
 }
 
+// Le formulaire d'électeur sert aussi au changement d'adresse: seuls le NAS et l'adresse saisis sont retenus.
+
+void ControleurDeListeElectorale::changerAdresse()
+{
+	QString titre = inscripteurElecteur->windowTitle();
+	inscripteurElecteur->setWindowTitle(TXT_CHANGERADRESSE_TITRE);
+	inscripteurElecteur->show();
+	if (inscripteurElecteur->exec() == QDialog::Accepted)
+	{
+		elections::Personne* p = nullptr;
+		try
+		{
+			p = inscripteurElecteur->reqPersonne();
+			if (historique->changerAdresse(*circonscription, p->reqNas(), p->reqAdresse()).reqErreur() == util::PERSONNE_ABSENTE)
+				QMessageBox::information(this, TXT_NAS_INEXISTANT, TXT_PERSONNE_ABSENTE.arg(QString::fromStdString(p->reqNas())));
+			compacterJournal();
+		}
+		catch(elections::JournalException& e)
+		{
+			QMessageBox::information(this, TXT_ERREUR_JOURNAL, QString::fromUtf8(e.what()));
+		}
+		delete p;
+	}
+	afficheur->rafraichir(circonscription);
+	inscripteurElecteur->hide();
+	inscripteurElecteur->setWindowTitle(titre);
+}
+
+void ControleurDeListeElectorale::annuler()
+{
+	if (!historique->peutAnnuler()) return;
+	try
+	{
+		if (!historique->annuler(*circonscription))
+			QMessageBox::information(this, TXT_ATTENTION, TXT_ERREUR_ANNULATION);
+		compacterJournal();
+	}
+	catch(elections::JournalException& e)
+	{
+		QMessageBox::information(this, TXT_ERREUR_JOURNAL, QString::fromUtf8(e.what()));
+	}
+	afficheur->rafraichir(circonscription);
+}
+
+void ControleurDeListeElectorale::retablir()
+{
+	if (!historique->peutRetablir()) return;
+	try
+	{
+		if (!historique->retablir(*circonscription))
+			QMessageBox::information(this, TXT_ATTENTION, TXT_ERREUR_ANNULATION);
+		compacterJournal();
+	}
+	catch(elections::JournalException& e)
+	{
+		QMessageBox::information(this, TXT_ERREUR_JOURNAL, QString::fromUtf8(e.what()));
+	}
+	afficheur->rafraichir(circonscription);
+}
 
 ControleurDeListeElectorale::~ControleurDeListeElectorale()
 {
+	// Un traitement encore en cours est annulé et attendu avant de libérer ce qu'il utilise.
+
+	if (suivi) suivi->annuler();
+	surveillantSauvegarde->waitForFinished();
+	if (surveillantRecuperation->isRunning())
+	{
+		surveillantRecuperation->waitForFinished();
+		delete surveillantRecuperation->result();
+	}
+	delete suivi;
+	delete journal;
+	delete historique;
     delete circonscription;
 }
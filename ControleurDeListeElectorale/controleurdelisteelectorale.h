@@ -2,6 +2,8 @@
 #define CONTROLEURDELISTEELECTORALE_H
 
 #include <QtGui>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 #include "ui_controleurdelisteelectorale.h"
 
 #include "afficheurdelisteelectorale.h"
@@ -11,6 +13,9 @@
 #include "Circonscription.h"
 #include "Electeur.h"
 #include "Candidat.h"
+#include "persistance.h"
+#include "JournalCirconscription.h"
+#include "HistoriqueModifications.h"
 
 class ControleurDeListeElectorale : public QMainWindow
 {
@@ -30,6 +35,15 @@ private slots:
     void creerNouvelElecteur();
     void creerNouveauCandidat();
     void desinscrire();
+    void changerAdresse();
+
+    void annuler();
+    void retablir();
+
+    void actualiserProgression();
+    void annulerTraitement();
+    void sauvegardeTerminee();
+    void recuperationTerminee();
 
 private:
     //Ui::ControleurDeListeElectoraleClass ui;
@@ -38,6 +52,7 @@ private:
 
     QMenu* menuFichier;
     QMenu* menuActions;
+    QMenu* menuEdition;
 
     QAction* actionNouveau;
     QAction* actionSauvegarder;
@@ -47,20 +62,56 @@ private:
     QAction* actionCreerNouvelElecteur;
     QAction* actionCreerNouveauCandidat;
     QAction* actionDesinscrire;
+    QAction* actionChangerAdresse;
+
+    QAction* actionAnnuler;
+    QAction* actionRetablir;
 
     AfficheurDeListeElectorale* afficheur;
     DesinscrireElecteur* desinscripteur;
     CreerElecteur* inscripteurElecteur;
     CreerCandidat* inscripteurCandidat;
 
+    // Sauvegarde et récupération en arrière-plan
+
+    QFutureWatcher<bool>* surveillantSauvegarde;
+    QFutureWatcher<elections::Circonscription*>* surveillantRecuperation;
+    QProgressDialog* dialogueProgression;
+    QTimer* minuterieProgression;
+    elections::SuiviTraitement* suivi = nullptr;
+    QString erreurTraitement;
+    QString fichierDestination;
+    double echelleProgression;
+
+    // Journal des modifications depuis la dernière sauvegarde ou récupération
+
+    elections::JournalCirconscription* journal = nullptr;
+
+    // Modifications à annuler ou à rétablir depuis la dernière récupération
+
+    elections::HistoriqueModifications* historique = nullptr;
 
 
     void initialiserBarreDeMenu();
     void initialiserMenuFichier();
     void initialiserMenuActions();
+    void initialiserMenuEdition();
     void initialiserAfficheur();
     void initialiserCirconscription();
     void initialiserFenetrePrincipale();
+    void initialiserTraitementsEnArrierePlan();
+
+    void ouvrirJournal(const QString& nomFichier);
+    void inscrireEtJournaliser(const elections::Personne& personne);
+    void desinscrireEtJournaliser(const std::string& nas);
+    void compacterJournal();
+    void actualiserMenuEdition();
+
+    void demarrerTraitement(const QString& message, double total);
+    void terminerTraitement();
+
+    static bool sauvegarderEnArrierePlan(ControleurDeListeElectorale* controleur, QString nomFichier);
+    static elections::Circonscription* recupererEnArrierePlan(ControleurDeListeElectorale* controleur, QString nomFichier);
 
 
 };
@@ -1,7 +1,21 @@
 #include "creerpersonne.h"
 #include "validationFormat.h"
+#include "Province.h"
 //#include <iostream>
 
+/**
+ * Provinces et territoires offerts, dans l'ordre alphabétique de leur nom
+ * français: le texte choisi est reconnu par util::analyserProvince()
+ */
+
+static const util::Province PROVINCES_ALPHABETIQUES[] =
+{
+	util::Province::ALBERTA, util::Province::COLOMBIE_BRITANNIQUE, util::Province::ILE_DU_PRINCE_EDOUARD,
+	util::Province::MANITOBA, util::Province::NOUVEAU_BRUNSWICK, util::Province::NOUVELLE_ECOSSE,
+	util::Province::NUNAVUT, util::Province::ONTARIO, util::Province::QUEBEC, util::Province::SASKATCHEWAN,
+	util::Province::TERRE_NEUVE, util::Province::TERRITOIRES_DU_NORD_OUEST, util::Province::YUKON
+};
+
 const QString TXT_SOUMETTRE     = QString::fromUtf8("&Soumettre");
 const QString TXT_ANNULER       = QString::fromUtf8("&Annuler");
 const QString TXT_REINITIALISER = QString::fromUtf8("&Réinitialiser");
@@ -126,19 +140,10 @@ void CreerPersonne::initialiserZonesDeSaisie()
     codePostalSaisie	->setPlaceholderText(TXT_CODEPOSTAL_PHOLDER);
 
     provinceSaisie		= new QComboBox;
-    provinceSaisie->addItem(tr("Alberta"));
-    provinceSaisie->addItem(tr("Colombie-Britannique"));
-    provinceSaisie->addItem(tr("Ile du Prince Edouard"));
-    provinceSaisie->addItem(tr("Manitoba"));
-    provinceSaisie->addItem(tr("Nouveau-Brunswick"));
-    provinceSaisie->addItem(tr("Nouvelle-Ecosse"));
-    provinceSaisie->addItem(tr("Nunavut"));
-    provinceSaisie->addItem(tr("Ontario"));
-    provinceSaisie->addItem(tr("Quebec"));
-    provinceSaisie->addItem(tr("Saskatchewan"));
-    provinceSaisie->addItem(tr("Terre-Neuve"));
-    provinceSaisie->addItem(tr("Territoires du Nord-Ouest"));
-    provinceSaisie->addItem(tr("Yukon"));
+    for (util::Province province: PROVINCES_ALPHABETIQUES)
+    {
+        provinceSaisie->addItem(QString::fromStdString(util::reqNomProvince(province)));
+    }
 
 
 	zoneSaisies 		= new QVBoxLayout;
@@ -13,6 +13,8 @@
 #include <string>
 #include <cstring>
 #include <sstream>
+#include <mutex>
+#include <unordered_set>
 
 #include "environnementTest.h"
 
@@ -77,6 +79,68 @@ bool Adresse::validerAdresse(
 			validerLigneNonVide(p_ville);
 }
 
+/****************************************************************************//**
+ * Construit une adresse sans lancer d'exception si les champs sont invalides.
+ *
+ * \param[in] p_numero Le numéro civique
+ * \param[in] p_nomRue Le nom de la rue
+ * \param[in] p_ville Le nom de la ville
+ * \param[in] p_codePostal Le code postal
+ * \param[in] p_province La province ou le territoire
+ *
+ * \return l'adresse, ou le code ADRESSE_INVALIDE
+ *
+ *//****************************************************************************/
+
+Resultat<Adresse> Adresse::creer(
+		const int          p_numero,
+		const std::string& p_nomRue,
+		const std::string& p_ville,
+		const std::string& p_codePostal,
+		const std::string& p_province)
+{
+	if (!validerAdresse(p_numero, p_nomRue, p_ville, p_codePostal, p_province))
+		return ADRESSE_INVALIDE;
+	return Adresse(p_numero, p_nomRue, p_ville, p_codePostal, p_province);
+}
+
+/**************************************************************************//**
+ * Forme compacte d'un code postal; invalide s'il n'est pas au format canadien
+ *//***************************************************************************/
+
+static CodePostal compacterCodePostal(const std::string& p_codePostal)
+{
+	Resultat<CodePostal> code = CodePostal::creer(p_codePostal);
+	return code ? code.reqValeur() : CodePostal();
+}
+
+/**************************************************************************//**
+ * Nom d'une province étrangère, conservé une seule fois pour toutes les
+ * adresses.  Les noms ne sont jamais libérés: ils sont peu nombreux.
+ *//***************************************************************************/
+
+static const std::string* internerProvince(const std::string& p_province)
+{
+	static std::mutex verrou;
+	static std::unordered_set<std::string>* noms = new std::unordered_set<std::string>;
+
+	std::lock_guard<std::mutex> garde(verrou);
+	return &*noms->insert(p_province).first;
+}
+
+/**************************************************************************//**
+ * Assigne la province: une province canadienne est reconnue par son nom
+ * français, son nom anglais ou son abréviation
+ *//***************************************************************************/
+
+void Adresse::asgProvince(const std::string& p_province)
+{
+	Resultat<Province> province = analyserProvince(p_province);
+
+	m_province = province ? province.reqValeur() : Province::AUTRE;
+	m_provinceAutre = province ? nullptr : internerProvince(p_province);
+}
+
 /**************************************************************************//**
  * Constructeur de base de la classe
  * \n
@@ -102,15 +166,47 @@ Adresse::Adresse(
 				m_nomRue(p_nomRue),
 				m_ville(p_ville),
 				m_codePostal(p_codePostal),
-				m_province(p_province)
+				m_codePostalCompact(compacterCodePostal(p_codePostal)),
+				m_province(Province::AUTRE),
+				m_provinceAutre(nullptr)
 {
 	PRECONDITION(validerAdresse(p_numeroCivic, p_nomRue, p_ville, p_codePostal, p_province));
 
+	asgProvince(p_province);
+
 	INVARIANTS();
 
 	verifiePostCondition(p_numeroCivic, p_nomRue, p_ville, p_codePostal, p_province);
 }
 
+/****************************************************************************//**
+ * Constructeur de confiance, pour des champs déjà validés: ni invariant ni
+ * postcondition, et la précondition n'est vérifiée qu'en échantillon.
+ *
+ * \pre les champs sont valides, voir le constructeur vérifié
+ *
+ *//***************************************************************************/
+
+Adresse::Adresse(
+		const int          p_numeroCivic,
+		const std::string& p_nomRue,
+    	const std::string& p_ville,
+		const std::string& p_codePostal,
+		const std::string& p_province,
+		DejaValide) :
+				m_numeroCivic(p_numeroCivic),
+				m_nomRue(p_nomRue),
+				m_ville(p_ville),
+				m_codePostal(p_codePostal),
+				m_codePostalCompact(compacterCodePostal(p_codePostal)),
+				m_province(Province::AUTRE),
+				m_provinceAutre(nullptr)
+{
+	PRECONDITION_COUTEUSE(validerAdresse(p_numeroCivic, p_nomRue, p_ville, p_codePostal, p_province));
+
+	asgProvince(p_province);
+}
+
 /**************************************************************************//**
  * Valide chacun des 5 champs d'un objet adresse.
  *
@@ -120,7 +216,7 @@ Adresse::Adresse(
 
 bool Adresse::validerAdresse() const
 {
-	return validerAdresse(m_numeroCivic, m_nomRue, m_ville, m_codePostal, m_province);
+	return validerAdresse(m_numeroCivic, m_nomRue, m_ville, m_codePostal, reqProvince());
 }
 
 /****************************************************************************//**
@@ -139,6 +235,7 @@ bool Adresse::validerAdresse() const
 void Adresse::verifieInvariant() const
 {
     INVARIANT(validerAdresse());
+    INVARIANT((m_province == Province::AUTRE) == (m_provinceAutre != nullptr));
 }
 
 /*****************************************************************************//**
@@ -160,7 +257,8 @@ void Adresse::verifiePostCondition(const int p_numero, const std::string& p_rue,
 	POSTCONDITION(p_rue == m_nomRue);
 	POSTCONDITION(p_ville == m_ville);
 	POSTCONDITION(p_code == m_codePostal);
-	POSTCONDITION(p_province == m_province);
+	POSTCONDITION(!m_codePostalCompact.estValide() or m_codePostalCompact.reqTexte() == m_codePostal);
+	POSTCONDITION(p_province == reqProvince() or m_province == analyserProvince(p_province).reqValeur());
 }
 
 /****************************************************************************//**
@@ -200,13 +298,27 @@ std::string Adresse::reqVille() const
 }
 
 /****************************************************************************//**
- * Accesseur du membre m_province
+ * Accesseur du nom de la province
  *
- * \return Un objet string contenant le nom de la province
+ * \return Un objet string contenant le nom de la province: le nom français
+ * pour une province ou un territoire canadien, quelle que soit la graphie
+ * reçue, sinon le nom tel qu'il a été reçu.
  *
  *//***************************************************************************/
 
 std::string Adresse::reqProvince() const
+{
+	return m_province == Province::AUTRE ? *m_provinceAutre : reqNomProvince(m_province);
+}
+
+/****************************************************************************//**
+ * Accesseur du membre m_province
+ *
+ * \return la province ou le territoire; Province::AUTRE hors du Canada
+ *
+ *//***************************************************************************/
+
+Province Adresse::reqProvinceTerritoire() const
 {
 	return m_province;
 }
@@ -223,6 +335,20 @@ std::string Adresse::reqCodePostal() const
 	return m_codePostal;
 }
 
+/****************************************************************************//**
+ * Accesseur de la forme compacte du code postal, calculée une fois à
+ * l'assignation
+ *
+ * \return le code postal compact; invalide si le code n'est pas au format
+ * canadien LDL DLD, une adresse étrangère par exemple.
+ *
+ *//****************************************************************************/
+
+CodePostal Adresse::reqCodePostalCompact() const
+{
+	return m_codePostalCompact;
+}
+
 
 /****************************************************************************//**
  * Mutateur d'objet Adresse.  Permet de modifier les 5 champs de l'objet.
@@ -255,7 +381,8 @@ void Adresse::asg(const unsigned int p_nouveauNumero,
 	m_ville = p_nouvelleVille;
 	m_nomRue = p_nouveauNomRue;
 	m_codePostal = p_nouveauCodePostal;
-	m_province = p_nouvelleProvince;
+	m_codePostalCompact = compacterCodePostal(p_nouveauCodePostal);
+	asgProvince(p_nouvelleProvince);
 
     INVARIANTS();
 
@@ -279,6 +406,7 @@ bool Adresse::operator == (const Adresse& p_droite) const
 			(m_nomRue     == p_droite.m_nomRue) and
 			(m_ville      == p_droite.m_ville) and
 			(m_province   == p_droite.m_province) and
+			(m_provinceAutre == p_droite.m_provinceAutre) and
 			(m_codePostal == p_droite.m_codePostal);
 }
 
@@ -309,7 +437,7 @@ std::string Adresse::reqAdresseFormatee() const
 	std::stringstream adresse;
 	static const std::string sep = ", ";
 
-	adresse << m_numeroCivic << sep << m_nomRue << sep << m_ville << sep << m_codePostal << sep << m_province;
+	adresse << m_numeroCivic << sep << m_nomRue << sep << m_ville << sep << m_codePostal << sep << reqProvince();
 
 	return adresse.str();
 }
@@ -11,6 +11,9 @@
 #define ADRESSE_H_
 
 #include "environnementTest.h"
+#include "Resultat.h"
+#include "CodePostal.h"
+#include "Province.h"
 
 #include <string>
 
@@ -26,7 +29,17 @@ namespace util
  * Le nom de la rue\n
  * La ville\n
  * Le code postal\n
- * La province ou territoire, en français.\n
+ * La province ou territoire.\n
+ *
+ * La province est tenue dans un octet.  Une province étrangère, un état
+ * américain par exemple, est Province::AUTRE; son nom est alors conservé dans
+ * une table de noms partagée par toutes les adresses.
+ *
+ * Limite: la rue et la ville sont des std::string, sans allocateur.  Celles
+ * qui dépassent la capacité locale de std::string (15 caractères avec
+ * libstdc++), comme « boulevard René-Lévesque Est » ou
+ * « Saint-Jean-sur-Richelieu », sont allouées par new même quand l'inscrit
+ * est placé dans la ressource mémoire d'une Circonscription.
  *
  */
 
@@ -39,7 +52,11 @@ private:
 	std::string  m_nomRue;
 	std::string  m_ville;
 	std::string  m_codePostal;
-	std::string  m_province;
+	CodePostal   m_codePostalCompact;
+	Province     m_province;
+	const std::string* m_provinceAutre;
+
+	void asgProvince(const std::string& p_province);
 
 	/* Méthodes privées de vérification du contrat */
 
@@ -60,6 +77,15 @@ public:
 			const std::string& p_codePostal,
 			const std::string& p_province);
 
+	/* Construction sans exception */
+
+	static Resultat<Adresse> creer(
+			const int          p_numero,
+			const std::string& p_nomRue,
+			const std::string& p_ville,
+			const std::string& p_codePostal,
+			const std::string& p_province);
+
 	/* Constructeur */
 
     Adresse(const int numeroCivic,
@@ -67,6 +93,12 @@ public:
 			const std::string& ville,
 			const std::string& codePostal,
 			const std::string& province);
+    Adresse(const int numeroCivic,
+    		const std::string& nomRue,
+			const std::string& ville,
+			const std::string& codePostal,
+			const std::string& province,
+			DejaValide);
 
     /* Accesseurs */
 
@@ -74,7 +106,9 @@ public:
     std::string  reqNomRue() const;
     std::string  reqVille() const;
     std::string  reqCodePostal() const;
+    CodePostal   reqCodePostalCompact() const;
     std::string  reqProvince() const;
+    Province     reqProvinceTerritoire() const;
 
     /* Validateur */
 
@@ -0,0 +1,76 @@
+/****************************************************************************//**
+ * \file BassinDeTaches.cpp
+ *
+ * \brief Implantation de la classe BassinDeTaches
+ *
+ *  Created on: 2020-12-16
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "BassinDeTaches.h"
+
+namespace util
+{
+
+/****************************************************************************//**
+ * Démarre les fils d'exécution
+ *
+ * \param[in] p_nbFils nombre de fils; 0 pour un fil par cœur disponible
+ *//****************************************************************************/
+
+BassinDeTaches::BassinDeTaches(std::size_t p_nbFils) : m_arret(false)
+{
+	if (p_nbFils == 0) p_nbFils = std::thread::hardware_concurrency();
+	if (p_nbFils == 0) p_nbFils = 1;
+
+	for (std::size_t i = 0; i < p_nbFils; ++i)
+	{
+		m_fils.emplace_back(&BassinDeTaches::executer, this);
+	}
+}
+
+/****************************************************************************//**
+ * Termine les tâches en attente, puis joint les fils
+ *//****************************************************************************/
+
+BassinDeTaches::~BassinDeTaches()
+{
+	{
+		std::lock_guard<std::mutex> verrou(m_mutex);
+		m_arret = true;
+	}
+	m_condition.notify_all();
+	for (std::thread& fil: m_fils) fil.join();
+}
+
+/****************************************************************************//**
+ * \return le nombre de fils d'exécution du bassin
+ *//****************************************************************************/
+
+std::size_t BassinDeTaches::reqNbFils() const
+{
+	return m_fils.size();
+}
+
+/****************************************************************************//**
+ * Boucle d'un fil: prend la prochaine tâche de la file et l'exécute, jusqu'à
+ * ce que l'arrêt soit demandé et la file vide.
+ *//****************************************************************************/
+
+void BassinDeTaches::executer()
+{
+	for (;;)
+	{
+		std::function<void()> tache;
+		{
+			std::unique_lock<std::mutex> verrou(m_mutex);
+			m_condition.wait(verrou, [this]() { return m_arret or !m_taches.empty(); });
+			if (m_taches.empty()) return;
+			tache = std::move(m_taches.front());
+			m_taches.pop_front();
+		}
+		tache();
+	}
+}
+
+} // namespace util
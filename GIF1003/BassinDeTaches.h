@@ -0,0 +1,107 @@
+/**
+ * \file BassinDeTaches.h
+ *
+ * \brief Déclaration de la classe BassinDeTaches: un nombre fixe de fils
+ * d'exécution qui exécutent les tâches soumises, dans l'ordre de soumission.
+ *
+ *  Created on: 2020-12-16
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef BASSINDETACHES_H_
+#define BASSINDETACHES_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace util
+{
+
+/****************************************************************************//**
+ * \class BassinDeTaches
+ *
+ * Bassin de fils d'exécution créés une fois pour toutes.  soumettre() retourne
+ * un std::future qui livre le résultat de la tâche, ou l'exception qu'elle a
+ * lancée.  Le destructeur termine les tâches déjà soumises avant de joindre les
+ * fils.
+ *
+ *//*****************************************************************************/
+
+class BassinDeTaches
+{
+public:
+
+	explicit BassinDeTaches(std::size_t p_nbFils = 0);
+	~BassinDeTaches();
+
+	BassinDeTaches(const BassinDeTaches&) = delete;
+	BassinDeTaches& operator=(const BassinDeTaches&) = delete;
+
+	std::size_t reqNbFils() const;
+
+	template <typename Fonction>
+	std::future<typename std::invoke_result<Fonction>::type> soumettre(Fonction p_tache);
+
+private:
+
+	void executer();
+
+	std::vector<std::thread>          m_fils;
+	std::deque<std::function<void()>> m_taches;
+	std::mutex                        m_mutex;
+	std::condition_variable           m_condition;
+	bool                              m_arret;
+};
+
+/**
+ * Ajoute une tâche à la file
+ *
+ * \param[in] p_tache objet appelable sans paramètre
+ * \return le futur résultat de la tâche
+ */
+
+template <typename Fonction>
+std::future<typename std::invoke_result<Fonction>::type> BassinDeTaches::soumettre(Fonction p_tache)
+{
+	typedef typename std::invoke_result<Fonction>::type Resultat_t;
+
+	std::shared_ptr<std::packaged_task<Resultat_t()>> tache =
+			std::make_shared<std::packaged_task<Resultat_t()>>(std::move(p_tache));
+	std::future<Resultat_t> futur = tache->get_future();
+	{
+		std::lock_guard<std::mutex> verrou(m_mutex);
+		m_taches.push_back([tache]() { (*tache)(); });
+	}
+	m_condition.notify_one();
+	return futur;
+}
+
+/**
+ * Attend la fin de toutes les tâches, sans lever leurs exceptions.  À appeler
+ * avant le premier get(): une exception levée par get() ne doit pas détruire
+ * ce que les tâches encore en cours utilisent.
+ *
+ * \param[in] p_futurs les futurs retournés par soumettre()
+ */
+
+template <typename T>
+void attendreToutes(std::vector<std::future<T>>& p_futurs)
+{
+	for (std::future<T>& futur: p_futurs)
+	{
+		if (futur.valid()) futur.wait();
+	}
+}
+
+} // namespace util
+
+#endif /* BASSINDETACHES_H_ */
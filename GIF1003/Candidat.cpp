@@ -78,13 +78,43 @@ std::string Candidat::formatterPartiPolitique(PartisPolitiques p_parti)
  *//*****************************************************************************/
 
 Candidat::Candidat(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom, const util::Date& p_date, const util::Adresse& p_adresse, const PartisPolitiques p_parti)
-                 : Personne(p_nas, p_nom,p_prenom, p_date, p_adresse), m_partiPolitique(p_parti)
+                 : Personne(p_nas, p_nom,p_prenom, p_date, p_adresse, TypePersonne::CANDIDAT), m_partiPolitique(p_parti)
 {
 	PRECONDITION(validerPartiPolitique(p_parti));
 	INVARIANTS();
 	POSTCONDITION(p_parti == m_partiPolitique);
 }
 
+/****************************************************************************//**
+ * Constructeur de confiance, pour des champs déjà validés
+ *
+ * \pre les champs et le parti sont valides
+ *
+ *//*****************************************************************************/
+
+Candidat::Candidat(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom, const util::Date& p_date, const util::Adresse& p_adresse, const PartisPolitiques p_parti, util::DejaValide)
+                 : Personne(p_nas, p_nom, p_prenom, p_date, p_adresse, TypePersonne::CANDIDAT, util::DEJA_VALIDE), m_partiPolitique(p_parti)
+{
+	PRECONDITION(validerPartiPolitique(p_parti));
+}
+
+/****************************************************************************//**
+ * Construit un candidat sans lancer d'exception si un paramètre est invalide.
+ *
+ * \return le candidat, ou le code d'erreur du premier champ invalide
+ *
+ *//*****************************************************************************/
+
+util::Resultat<Candidat> Candidat::creer(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom, const util::Date& p_date, const util::Adresse& p_adresse, const PartisPolitiques p_parti)
+{
+	util::CodeErreur code = Personne::diagnostiquerIdentite(p_nas, p_nom, p_prenom);
+	if (code != util::AUCUNE_ERREUR)
+		return code;
+	if (!validerPartiPolitique(p_parti))
+		return util::PARTI_INVALIDE;
+	return Candidat(p_nas, p_nom, p_prenom, p_date, p_adresse, p_parti, util::DEJA_VALIDE);
+}
+
 /****************************************************************************//**
  * Accesseur de l'attribut parti politique.
  *
@@ -35,7 +35,7 @@ enum PartisPolitiques {BLOC_QUEBECOIS, CONSERVATEUR, INDEPENDANT, LIBERAL, NOUVE
  *
  *//*****************************************************************************/
 
-class Candidat: public Personne {
+class Candidat final: public Personne {
 
 private:
 
@@ -55,6 +55,11 @@ public:
 	/* Constructeurs */
 
 	Candidat(const std::string&, const std::string&, const std::string&, const util::Date&, const util::Adresse&, const PartisPolitiques p_parti);
+	Candidat(const std::string&, const std::string&, const std::string&, const util::Date&, const util::Adresse&, const PartisPolitiques p_parti, util::DejaValide);
+
+	/* Construction sans exception */
+
+	static util::Resultat<Candidat> creer(const std::string&, const std::string&, const std::string&, const util::Date&, const util::Adresse&, const PartisPolitiques p_parti);
 
 	/* Accesseurs */
 
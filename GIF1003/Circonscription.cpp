@@ -12,6 +12,11 @@
 #include "validationFormat.h"
 #include "ContratException.h"
 #include "PersonneException.h"
+#include "DeltaCirconscription.h"
+#include "VisiteurPersonne.h"
+#include "IndexAlphabetique.h"
+#include "IndexNasPersistant.h"
+#include "InstantaneCirconscription.h"
 
 #include <vector>
 #include <algorithm>
@@ -26,6 +31,7 @@ namespace elections {
  *
  * \param[in]  p_nom Nom de la circonscription
  * \param[in] p_depute Objet Candidat représentant le député sortant de la circonscription
+ * \param[in] p_ressource ressource mémoire des inscrits; nullptr pour new et delete
  *
  * \pre p_nom est non-vide
  * \pre p_depute est un objet valide
@@ -39,11 +45,15 @@ namespace elections {
  *
  *//*****************************************************************************/
 
-Circonscription::Circonscription(const std::string& p_nom, const Candidat& p_depute) :
+Circonscription::Circonscription(const std::string& p_nom, const Candidat& p_depute, std::pmr::memory_resource* p_ressource) :
 
 		m_nomCirconscription(p_nom),
 		m_deputeElu         (p_depute),
-		m_vInscrits         ()
+		m_vInscrits         (),
+		m_indexNas          (),
+		m_ressource         (p_ressource),
+		m_indexAlphabetique (nullptr),
+		m_versions          (nullptr)
 {
 	PRECONDITION(util::estUnNom(p_nom)) ;
 	PRECONDITION(p_depute.valider());
@@ -70,19 +80,47 @@ Circonscription::Circonscription(const std::string& p_nom, const Candidat& p_dep
 
 Circonscription::Circonscription(const Circonscription& p_circonscription) :
 
+		Circonscription(p_circonscription, nullptr)
+{
+}
+
+/****************************************************************************//**
+ * Constructeur de recopie dans une ressource mémoire
+ *
+ * \param[in] p_circonscription l'objet à recopier
+ * \param[in] p_ressource ressource mémoire des inscrits de la copie
+ *
+ * \pre l'objet à recopier est valide
+ *
+ *//*****************************************************************************/
+
+Circonscription::Circonscription(const Circonscription& p_circonscription, std::pmr::memory_resource* p_ressource) :
+
 		m_nomCirconscription(p_circonscription.m_nomCirconscription) ,
 		m_deputeElu         (p_circonscription.m_deputeElu) ,
-		m_vInscrits         ()
+		m_vInscrits         () ,
+		m_indexNas          () ,
+		m_ressource         (p_ressource) ,
+		m_indexAlphabetique (nullptr) ,
+		m_versions          (nullptr)
 {
-	PRECONDITION(p_circonscription.validerCirconscription()) ;
+	PRECONDITION_COUTEUSE(p_circonscription.validerCirconscription()) ;
+
+	m_vInscrits.reserve(p_circonscription.m_vInscrits.size()) ;
+	m_indexNas.reserver(p_circonscription.m_vInscrits.size()) ;
 
 	for (Personne* personne: p_circonscription.m_vInscrits)
 	{
-		inscrire(*personne);
+		util::Resultat<void> resultat = tenterInscrire(*personne, util::DEJA_VALIDE);
+		ASSERTION(resultat.estValide());
 	}
+	if (p_circonscription.m_indexAlphabetique)
+		indexerParNom();
+	if (p_circonscription.m_versions)
+		m_versions = new InstantaneCirconscription::Inscrits_t(*p_circonscription.m_versions);
 
 	INVARIANTS() ;
-	POSTCONDITION(reqCirconscriptionFormate() == p_circonscription.reqCirconscriptionFormate());
+	POSTCONDITION_COUTEUSE(reqCirconscriptionFormate() == p_circonscription.reqCirconscriptionFormate());
 }
 
 /****************************************************************************//**
@@ -99,7 +137,8 @@ bool Circonscription::pointeurEstNul(Personne* p)
 }
 
 /****************************************************************************//**
- * Détecte la présence d'une personne dans la liste électorale
+ * Détecte la présence d'une personne dans la liste électorale, en temps
+ * constant grâce à l'index des NAS.
  *
  * \return true si une personne inscrite a le nas passé en argument
  * \precondition le nas est valide
@@ -107,11 +146,12 @@ bool Circonscription::pointeurEstNul(Personne* p)
 
 bool Circonscription::personneEstDejaPresente(const std::string& p_nas) const
 {
-	return trouver(p_nas) != m_vInscrits.end();
+	return m_indexNas.trouver(util::compacterNas(p_nas)) != nullptr;
 }
 
 /****************************************************************************//**
- * Localise un nas donné dans la liste électorale.
+ * Localise un nas donné dans la liste électorale, en temps constant: l'index
+ * des NAS donne sa position dans la liste.
  *
  * \param[in] p_nas le numéro d'assurance sociale à localiser, au format 888 888 888
  *
@@ -122,23 +162,18 @@ bool Circonscription::personneEstDejaPresente(const std::string& p_nas) const
 
 Circonscription::Iterateur_t Circonscription::trouver(const std::string& p_nas) const
 {
-	Iterateur_t iter = m_vInscrits.begin();
-	bool trouve = false;
+	const std::size_t* position = m_indexNas.trouver(util::compacterNas(p_nas));
 
-	while ( (!trouve) and (iter != m_vInscrits.end()) )
-	{
-		if ( (*iter)->reqNas() == p_nas )
-			trouve = true;
-		else
-			++iter;
-	}
-   return iter;
+	if (!position)
+		return m_vInscrits.end();
+	return m_vInscrits.begin() + *position;
 }
 
 /****************************************************************************//**
  * Vérifie qu'il n'y a aucun pointeur nul dans la liste électorale
  *
- * \return true si aucun pointeur de la liste n'est nul
+ * \return true si aucun pointeur de la liste n'est nul et si l'index des NAS
+ * donne la position de chaque inscrit
  *
  *//****************************************************************************/
 
@@ -153,7 +188,8 @@ bool Circonscription::validerVecteurDesInscrits() const
 	{
 		for (auto it = m_vInscrits.begin(); valide and it != m_vInscrits.end(); ++it)
 		{
-			valide = !pointeurEstNul(*it);
+			const std::size_t* position = pointeurEstNul(*it) ? nullptr : m_indexNas.trouver(util::compacterNas((*it)->reqNas()));
+			valide = position and *position == static_cast<std::size_t>(it - m_vInscrits.begin());
 		}
 	}
 	return valide ;
@@ -174,7 +210,9 @@ bool Circonscription::validerCirconscription() const
 
 /****************************************************************************//**
  * Appelé par la macro INVARIANTS()
- * Appelle à son tour une macro qui vérifie la validité interne de l'objet courant
+ * Appelle à son tour une macro qui vérifie la validité interne de l'objet courant.
+ * Le parcours de la liste électorale est en O(n): il n'est fait qu'aux niveaux
+ * de contrat qui le permettent.
  *
  * \exception InvariantException si l'objet Courant est jugé invalide.
  *
@@ -182,7 +220,11 @@ bool Circonscription::validerCirconscription() const
 
 void Circonscription::verifieInvariant() const
 {
-    INVARIANT(validerCirconscription());
+    INVARIANT(m_deputeElu.valider() and util::estUnNom(m_nomCirconscription));
+    INVARIANT(m_indexNas.reqNbElements() == m_vInscrits.size());
+    INVARIANT(!m_indexAlphabetique or m_indexAlphabetique->reqNbInscrits() == m_vInscrits.size());
+    INVARIANT(!m_versions or m_versions->reqNbElements() == m_vInscrits.size());
+    INVARIANT_COUTEUX(validerVecteurDesInscrits());
 }
 
 /****************************************************************************//**
@@ -209,6 +251,173 @@ const Candidat& Circonscription::reqDeputeElu() const
 	return m_deputeElu ;
 }
 
+/****************************************************************************//**
+ * \return la ressource mémoire des inscrits, nullptr pour new et delete
+ *//*****************************************************************************/
+
+std::pmr::memory_resource* Circonscription::reqRessource() const
+{
+	return m_ressource ;
+}
+
+/****************************************************************************//**
+ * Début de la liste électorale, dans l'ordre d'inscription
+ *
+ * \return un itérateur au premier inscrit
+ *
+ *//****************************************************************************/
+
+Circonscription::Iterateur_t Circonscription::reqDebutInscrits() const
+{
+	return m_vInscrits.begin() ;
+}
+
+/****************************************************************************//**
+ * Fin de la liste électorale
+ *
+ * \return un itérateur suivant le dernier inscrit
+ *
+ *//****************************************************************************/
+
+Circonscription::Iterateur_t Circonscription::reqFinInscrits() const
+{
+	return m_vInscrits.end() ;
+}
+
+/****************************************************************************//**
+ * Nombre de personnes inscrites sur la liste électorale
+ *
+ * \return la taille de la liste, sans compter le député sortant
+ *
+ *//****************************************************************************/
+
+std::size_t Circonscription::reqNbInscrits() const
+{
+	return m_vInscrits.size() ;
+}
+
+/****************************************************************************//**
+ * Nombre d'inscrits par province de résidence, en un seul parcours
+ *
+ * \return un compteur par valeur de util::Province, indicé par cette valeur;
+ * le dernier compte les adresses hors du Canada
+ *
+ *//****************************************************************************/
+
+std::array<std::size_t, util::NB_PROVINCES + 1> Circonscription::reqNbInscritsParProvince() const
+{
+	std::array<std::size_t, util::NB_PROVINCES + 1> nbInscrits = {};
+
+	for (const Personne* p: m_vInscrits)
+		++nbInscrits[static_cast<std::size_t>(p->reqAdresse().reqProvinceTerritoire())];
+	return nbInscrits;
+}
+
+/****************************************************************************//**
+ * Recherche un inscrit par son NAS, en temps constant
+ *
+ * \param[in] p_nas le numéro d'assurance sociale cherché
+ *
+ * \return l'inscrit, ou nullptr si aucun inscrit n'a ce NAS ou si p_nas n'a
+ * pas le format d'un NAS
+ *
+ *//****************************************************************************/
+
+const Personne* Circonscription::reqInscrit(const std::string& p_nas) const
+{
+	const std::size_t* position = m_indexNas.trouver(util::compacterNas(p_nas)) ;
+	return position ? m_vInscrits[*position] : nullptr ;
+}
+
+/****************************************************************************//**
+ * Range les inscrits par nom et prénom dans un IndexAlphabetique, tenu à jour
+ * ensuite par chaque inscription et désinscription.  Un index existant est
+ * reconstruit.
+ *
+ * \param[in] p_bassin le bassin qui calcule les clés et trie en parallèle;
+ * nullptr pour construire l'index dans le fil appelant
+ *
+ * \post reqIndexAlphabetique() contient tous les inscrits
+ *
+ *//****************************************************************************/
+
+void Circonscription::indexerParNom(util::BassinDeTaches* p_bassin)
+{
+	IndexAlphabetique* index = new IndexAlphabetique() ;
+
+	try
+	{
+		index->construire(m_vInscrits.begin(), m_vInscrits.end(), p_bassin) ;
+	}
+	catch (...)
+	{
+		delete index ;
+		throw ;
+	}
+	delete m_indexAlphabetique ;
+	m_indexAlphabetique = index ;
+
+	POSTCONDITION(m_indexAlphabetique->reqNbInscrits() == m_vInscrits.size()) ;
+	INVARIANTS() ;
+}
+
+/****************************************************************************//**
+ * \return l'index alphabétique des inscrits, ou nullptr si indexerParNom()
+ * n'a pas été appelée
+ *//****************************************************************************/
+
+const IndexAlphabetique* Circonscription::reqIndexAlphabetique() const
+{
+	return m_indexAlphabetique ;
+}
+
+/****************************************************************************//**
+ * Garde une version immuable de chaque inscrit, pour que reqInstantane() soit
+ * en temps constant.  Chaque inscrit est recopié une fois ici, puis à chacune
+ * de ses modifications; les versions sont partagées par tous les instantanés.
+ * Sans effet si les instantanés sont déjà actifs.
+ *
+ * \post reqInstantane() peut être appelée
+ *
+ *//****************************************************************************/
+
+void Circonscription::activerInstantanes()
+{
+	if (m_versions)
+		return ;
+
+	InstantaneCirconscription::Inscrits_t* versions = new InstantaneCirconscription::Inscrits_t() ;
+	try
+	{
+		for (Personne* inscrit: m_vInscrits)
+			versions->inserer(util::compacterNas(inscrit->reqNas()), std::shared_ptr<const Personne>(inscrit->clone())) ;
+	}
+	catch (...)
+	{
+		delete versions ;
+		throw ;
+	}
+	m_versions = versions ;
+
+	INVARIANTS() ;
+}
+
+/****************************************************************************//**
+ * Vue figée de la liste électorale, en temps constant et sans recopier
+ * d'inscrit.  L'instantané reste inchangé quand la circonscription est
+ * modifiée ensuite, et peut lui survivre.
+ *
+ * \pre activerInstantanes() a été appelée
+ *
+ *//****************************************************************************/
+
+InstantaneCirconscription Circonscription::reqInstantane() const
+{
+	PRECONDITION(m_versions) ;
+
+	return InstantaneCirconscription(m_nomCirconscription, m_deputeElu, *m_versions) ;
+}
+
 /****************************************************************************//**
  * Rajoute un nouvel électeur ou candidat à la liste électorale
  *
@@ -228,26 +437,78 @@ const Candidat& Circonscription::reqDeputeElu() const
  *//****************************************************************************/
 
 void Circonscription::inscrire(const Personne& p_nouveau)
+{
+	util::Resultat<void> resultat = tenterInscrire(p_nouveau) ;
+
+	PRECONDITION(resultat.reqErreur() != util::PERSONNE_INVALIDE) ;
+
+	if (resultat.reqErreur() == util::PERSONNE_DEJA_PRESENTE)
+		throw (PersonneDejaPresenteException(p_nouveau.reqNas()));
+}
+
+/****************************************************************************//**
+ * Rajoute un nouvel électeur ou candidat à la liste électorale, sans lancer
+ * d'exception si l'inscription est refusée.
+ *
+ * \param p_nouveau Nouvelle personne à inscrire, soit un objet Candidat ou Electeur
+ *
+ * \return PERSONNE_INVALIDE si l'objet est invalide, PERSONNE_DEJA_PRESENTE si
+ * une personne avec le même NAS est dans la liste.  La liste est alors inchangée.
+ *
+ * \post Si l'inscription réussit, le dernier élément de la liste est le nouvel inscrit
+ * \post Si l'inscription réussit, la liste est allongée d'un élément
+ *
+ *//****************************************************************************/
+
+util::Resultat<void> Circonscription::tenterInscrire(const Personne& p_nouveau)
+{
+	if (!validerPersonne(p_nouveau))
+		return util::PERSONNE_INVALIDE ;
+	return tenterInscrire(p_nouveau, util::DEJA_VALIDE) ;
+}
+
+/****************************************************************************//**
+ * Inscription de confiance: la personne a déjà été validée par l'appelant,
+ * au chargement d'un fichier ou dans une passe de validation en lot.  Seul
+ * le doublon de NAS est vérifié.
+ *
+ * \pre p_nouveau est valide
+ *
+ * \return PERSONNE_DEJA_PRESENTE si une personne avec le même NAS est dans la
+ * liste.  La liste est alors inchangée.
+ *
+ *//****************************************************************************/
+
+util::Resultat<void> Circonscription::tenterInscrire(const Personne& p_nouveau, util::DejaValide)
 {
 	std::vector<Personne*>::size_type precedent = m_vInscrits.size() ;
 
-	PRECONDITION(p_nouveau.valider()) ;
+	PRECONDITION_COUTEUSE(validerPersonne(p_nouveau)) ;
 
 	if (personneEstDejaPresente(p_nouveau.reqNas()))
-		throw (PersonneDejaPresenteException(p_nouveau.reqNas()));
-	m_vInscrits.push_back(p_nouveau.clone()) ;
+		return util::PERSONNE_DEJA_PRESENTE ;
+
+	std::uint32_t cle = util::compacterNas(p_nouveau.reqNas()) ;
+	m_vInscrits.push_back(clonerPersonne(p_nouveau, m_ressource)) ;
+	m_indexNas.inserer(cle, m_vInscrits.size() - 1) ;
+	if (m_indexAlphabetique)
+		m_indexAlphabetique->inserer(*m_vInscrits.back()) ;
+	if (m_versions)
+		m_versions->inserer(cle, std::shared_ptr<const Personne>(p_nouveau.clone())) ;
 
 	INVARIANTS() ;
 
 	POSTCONDITION(*(m_vInscrits.back()) == p_nouveau);
 	POSTCONDITION(m_vInscrits.size() == (precedent + 1));
+
+	return util::AUCUNE_ERREUR ;
 }
 
 /****************************************************************************//**
  * Retire une inscription de la liste électorale
  *
- * Fait deux actions: désalloue le pointeur à la personne inscrite.  Efface ce
- * pointeur de la liste.
+ * Fait deux actions: désalloue le pointeur à la personne inscrite.  Met le
+ * dernier inscrit à sa place dans la liste, en temps constant.
  *
  * \param[in] p_nas Numéro d'assurance sociale de la personne à retirer
  *
@@ -260,19 +521,421 @@ void Circonscription::inscrire(const Personne& p_nouveau)
  *//*****************************************************************************/
 
 void Circonscription::desinscrire(const std::string& p_nas)
+{
+	util::Resultat<void> resultat = tenterDesinscrire(p_nas) ;
+
+	PRECONDITION(resultat.reqErreur() != util::NAS_INVALIDE);
+
+	if (resultat.reqErreur() == util::PERSONNE_ABSENTE)
+		throw PersonneAbsenteException(p_nas);
+}
+
+/****************************************************************************//**
+ * Retire une inscription de la liste électorale, sans lancer d'exception si
+ * le retrait est impossible.
+ *
+ * \param[in] p_nas Numéro d'assurance sociale de la personne à retirer
+ *
+ * \return NAS_INVALIDE si le nas est mal formé, PERSONNE_ABSENTE s'il n'est pas
+ * localisé dans la liste.  La liste est alors inchangée.
+ *
+ * \post Si le retrait réussit, la liste est raccourcie d'un élément et le
+ * dernier inscrit a pris la place du retiré
+ *
+ *//*****************************************************************************/
+
+util::Resultat<void> Circonscription::tenterDesinscrire(const std::string& p_nas)
 {
 	size_t precedent = m_vInscrits.size();
-	PRECONDITION(util::validerNas(p_nas));
 
-	Iterateur_t localise = trouver(p_nas);
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE ;
 
-	if (localise == m_vInscrits.end()) throw PersonneAbsenteException(p_nas);
-	delete *localise;
-	m_vInscrits.erase(localise);
+	std::uint32_t cle = util::compacterNas(p_nas);
+	const std::size_t* localise = m_indexNas.trouver(cle);
 
+	if (!localise)
+		return util::PERSONNE_ABSENTE ;
+	std::size_t position = *localise;
+	Personne* inscrit = m_vInscrits[position];
+
+	if (m_indexAlphabetique)
+		m_indexAlphabetique->retirer(*inscrit);
+	if (m_versions)
+		m_versions->retirer(cle);
+	m_indexNas.retirer(cle);
+	if (position + 1 != m_vInscrits.size())
+	{
+		m_vInscrits[position] = m_vInscrits.back();
+		*m_indexNas.trouver(util::compacterNas(m_vInscrits[position]->reqNas())) = position;
+	}
+	m_vInscrits.pop_back();
+	detruirePersonne(inscrit, m_ressource);
 
 	POSTCONDITION(m_vInscrits.size() == (precedent - 1) );
 	INVARIANTS();
+
+	return util::AUCUNE_ERREUR ;
+}
+
+/****************************************************************************//**
+ * Remplace un inscrit par une nouvelle version de même NAS, à la même place
+ * dans la liste, en temps constant
+ *
+ * \param[in] p_remplacant La nouvelle version, soit un objet Candidat ou Electeur
+ *
+ * \return PERSONNE_INVALIDE si l'objet est invalide, PERSONNE_ABSENTE si son NAS
+ * n'est pas dans la liste.  La liste est alors inchangée.
+ *
+ * \post Si le remplacement réussit, la taille de la liste est inchangée
+ *
+ *//*****************************************************************************/
+
+util::Resultat<void> Circonscription::remplacer(const Personne& p_remplacant)
+{
+	size_t precedent = m_vInscrits.size();
+
+	if (!validerPersonne(p_remplacant))
+		return util::PERSONNE_INVALIDE ;
+
+	const std::size_t* position = m_indexNas.trouver(util::compacterNas(p_remplacant.reqNas()));
+	if (!position)
+		return util::PERSONNE_ABSENTE ;
+
+	Personne*& inscrit = m_vInscrits[*position];
+
+	// La nouvelle version des instantanés est dérivée d'une copie, en temps
+	// constant, et l'index alphabétique est modifié en dernier: si une
+	// allocation échoue, la liste et ses index sont intacts.
+
+	Personne* nouveau = clonerPersonne(p_remplacant, m_ressource) ;
+	InstantaneCirconscription::Inscrits_t versions ;
+	try
+	{
+		if (m_versions)
+		{
+			versions = *m_versions ;
+			versions.remplacer(util::compacterNas(p_remplacant.reqNas()), std::shared_ptr<const Personne>(p_remplacant.clone())) ;
+		}
+		if (m_indexAlphabetique)
+			m_indexAlphabetique->remplacer(*inscrit, *nouveau) ;
+	}
+	catch (...)
+	{
+		detruirePersonne(nouveau, m_ressource) ;
+		throw ;
+	}
+
+	if (m_versions)
+		swap(*m_versions, versions) ;
+	detruirePersonne(inscrit, m_ressource) ;
+	inscrit = nouveau ;
+
+	POSTCONDITION(m_vInscrits.size() == precedent);
+	INVARIANTS();
+
+	return util::AUCUNE_ERREUR ;
+}
+
+/****************************************************************************//**
+ * Reporte un DeltaCirconscription sur la liste: retraits, remplacements puis
+ * ajouts.  Tout le delta est vérifié avant la première modification, et la
+ * liste n'est parcourue qu'une fois, quel que soit le nombre de retraits.
+ *
+ * \param[in] p_delta La différence à appliquer
+ *
+ * \return PERSONNE_ABSENTE si un NAS retiré ou modifié n'est pas dans la liste,
+ * PERSONNE_DEJA_PRESENTE si un ajout y est déjà, PERSONNE_INVALIDE si un
+ * inscrit du delta est invalide.  La liste est alors inchangée.
+ *
+ * \post Si l'application réussit, la liste contient les inscrits de la liste
+ * « nouvelle » du delta; les inscrits conservés gardent leur ordre, les ajouts
+ * suivent
+ *
+ *//*****************************************************************************/
+
+util::Resultat<void> Circonscription::appliquer(const DeltaCirconscription& p_delta)
+{
+	size_t precedent = m_vInscrits.size();
+	std::vector<std::size_t> retraits ;
+
+	for (std::size_t i = 0; i < p_delta.reqNbRetraits(); ++i)
+	{
+		const std::string& nas = p_delta.reqRetrait(i) ;
+		if (!util::validerNas(nas) or !m_indexNas.trouver(util::compacterNas(nas)))
+			return util::PERSONNE_ABSENTE ;
+	}
+	for (std::size_t i = 0; i < p_delta.reqNbModifications(); ++i)
+	{
+		const Personne& modification = p_delta.reqModification(i) ;
+		if (!validerPersonne(modification))
+			return util::PERSONNE_INVALIDE ;
+		if (!m_indexNas.trouver(util::compacterNas(modification.reqNas())))
+			return util::PERSONNE_ABSENTE ;
+	}
+	for (std::size_t i = 0; i < p_delta.reqNbAjouts(); ++i)
+	{
+		const Personne& ajout = p_delta.reqAjout(i) ;
+		if (!validerPersonne(ajout))
+			return util::PERSONNE_INVALIDE ;
+		if (personneEstDejaPresente(ajout.reqNas()))
+			return util::PERSONNE_DEJA_PRESENTE ;
+	}
+
+	// Toutes les copies sont faites avant la première modification: si l'une
+	// échoue, la liste et ses index sont intacts.
+
+	std::size_t nbModifications = p_delta.reqNbModifications() ;
+	std::vector<Personne*> nouveaux ;
+	std::vector<std::shared_ptr<const Personne>> versions ;
+	nouveaux.reserve(nbModifications + p_delta.reqNbAjouts()) ;
+	try
+	{
+		for (std::size_t i = 0; i < nbModifications; ++i)
+			nouveaux.push_back(clonerPersonne(p_delta.reqModification(i), m_ressource)) ;
+		for (std::size_t i = 0; i < p_delta.reqNbAjouts(); ++i)
+			nouveaux.push_back(clonerPersonne(p_delta.reqAjout(i), m_ressource)) ;
+		if (m_versions)
+		{
+			versions.reserve(nouveaux.size()) ;
+			for (Personne* nouveau: nouveaux)
+				versions.push_back(std::shared_ptr<const Personne>(nouveau->clone())) ;
+		}
+
+		retraits.reserve(p_delta.reqNbRetraits()) ;
+		for (std::size_t i = 0; i < p_delta.reqNbRetraits(); ++i)
+			retraits.push_back(*m_indexNas.trouver(util::compacterNas(p_delta.reqRetrait(i)))) ;
+		std::sort(retraits.begin(), retraits.end()) ;
+
+		m_vInscrits.reserve(precedent + p_delta.reqNbAjouts()) ;
+		m_indexNas.reserver(precedent + p_delta.reqNbAjouts()) ;
+	}
+	catch (...)
+	{
+		for (Personne* nouveau: nouveaux)
+			detruirePersonne(nouveau, m_ressource) ;
+		throw ;
+	}
+
+	for (std::size_t i = 0; i < p_delta.reqNbRetraits(); ++i)
+	{
+		std::uint32_t cle = util::compacterNas(p_delta.reqRetrait(i)) ;
+		Personne* inscrit = m_vInscrits[*m_indexNas.trouver(cle)] ;
+		m_indexNas.retirer(cle) ;
+		if (m_indexAlphabetique)
+			m_indexAlphabetique->retirer(*inscrit) ;
+		if (m_versions)
+			m_versions->retirer(cle) ;
+		detruirePersonne(inscrit, m_ressource) ;
+	}
+	for (std::size_t i = 0; i < nbModifications; ++i)
+	{
+		std::uint32_t cle = util::compacterNas(nouveaux[i]->reqNas()) ;
+		Personne*& inscrit = m_vInscrits[*m_indexNas.trouver(cle)] ;
+		if (m_indexAlphabetique)
+			m_indexAlphabetique->remplacer(*inscrit, *nouveaux[i]) ;
+		if (m_versions)
+			m_versions->remplacer(cle, versions[i]) ;
+		detruirePersonne(inscrit, m_ressource) ;
+		inscrit = nouveaux[i] ;
+	}
+
+	if (!retraits.empty())
+		retirerPositions(retraits) ;
+
+	for (std::size_t i = nbModifications; i < nouveaux.size(); ++i)
+	{
+		std::uint32_t cle = util::compacterNas(nouveaux[i]->reqNas()) ;
+		m_vInscrits.push_back(nouveaux[i]) ;
+		m_indexNas.inserer(cle, m_vInscrits.size() - 1) ;
+		if (m_indexAlphabetique)
+			m_indexAlphabetique->inserer(*nouveaux[i]) ;
+		if (m_versions)
+			m_versions->inserer(cle, versions[i]) ;
+	}
+
+	POSTCONDITION(m_vInscrits.size() == precedent - p_delta.reqNbRetraits() + p_delta.reqNbAjouts());
+	INVARIANTS();
+
+	return util::AUCUNE_ERREUR ;
+}
+
+/****************************************************************************//**
+ * Transfère un inscrit dans une autre circonscription, par exemple après un
+ * déménagement.  L'inscrit n'est pas recopié si les deux circonscriptions
+ * partagent la même ressource mémoire; sinon il est recopié dans celle de la
+ * destination.
+ *
+ * \param[in] p_nas Numéro d'assurance sociale de l'inscrit à transférer
+ * \param[in,out] p_destination la circonscription d'accueil
+ *
+ * \pre p_destination n'est pas la circonscription courante
+ *
+ * \return NAS_INVALIDE si le nas est mal formé, PERSONNE_ABSENTE s'il n'est pas
+ * dans la liste, PERSONNE_DEJA_PRESENTE s'il est déjà dans la destination.  Les
+ * deux listes sont alors inchangées.
+ *
+ * \post Si le transfert réussit, l'inscrit est le dernier de la destination
+ *
+ *//*****************************************************************************/
+
+util::Resultat<void> Circonscription::transferer(const std::string& p_nas, Circonscription& p_destination)
+{
+	PRECONDITION(&p_destination != this) ;
+
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE ;
+
+	Iterateur_t localise = trouver(p_nas) ;
+	if (localise == m_vInscrits.end())
+		return util::PERSONNE_ABSENTE ;
+	if (p_destination.personneEstDejaPresente(p_nas))
+		return util::PERSONNE_DEJA_PRESENTE ;
+
+	deplacer(std::vector<std::size_t>(1, localise - m_vInscrits.begin()), p_destination) ;
+
+	POSTCONDITION(p_destination.m_vInscrits.back()->reqNas() == p_nas) ;
+	return util::AUCUNE_ERREUR ;
+}
+
+/****************************************************************************//**
+ * Transfère en bloc les inscrits choisis par un prédicat, par exemple ceux
+ * des codes postaux cédés lors d'un redécoupage.  Le transfert est entier ou
+ * nul: si un seul NAS choisi est déjà dans la destination, rien ne bouge.
+ *
+ * \param[in] p_selection vrai pour chaque inscrit à transférer; appelé une
+ * fois par inscrit, dans l'ordre de la liste
+ * \param[in,out] p_destination la circonscription d'accueil
+ *
+ * \pre p_destination n'est pas la circonscription courante
+ *
+ * \return le nombre d'inscrits transférés, ou PERSONNE_DEJA_PRESENTE.  Les
+ * inscrits restants gardent leur ordre, les transférés suivent ceux de la
+ * destination dans le même ordre.
+ *
+ *//*****************************************************************************/
+
+util::Resultat<std::size_t> Circonscription::transfererSi(const Selection_t& p_selection, Circonscription& p_destination)
+{
+	PRECONDITION(&p_destination != this) ;
+
+	std::vector<std::size_t> positions ;
+
+	for (std::size_t i = 0; i < m_vInscrits.size(); ++i)
+	{
+		if (!p_selection(*m_vInscrits[i]))
+			continue ;
+		if (p_destination.personneEstDejaPresente(m_vInscrits[i]->reqNas()))
+			return util::PERSONNE_DEJA_PRESENTE ;
+		positions.push_back(i) ;
+	}
+	if (!positions.empty())
+		deplacer(positions, p_destination) ;
+
+	return positions.size() ;
+}
+
+/****************************************************************************//**
+ * Déplace des inscrits dans une autre circonscription, sans vérification.
+ * Les réservations et les copies éventuelles précèdent la première
+ * modification: si l'une d'elles échoue, les deux listes sont inchangées.
+ *
+ * \param[in] p_positions les positions des inscrits dans la liste, croissantes
+ * \param[in,out] p_destination la circonscription d'accueil, où aucun de ces
+ * NAS n'est inscrit
+ *
+ *//*****************************************************************************/
+
+void Circonscription::deplacer(const std::vector<std::size_t>& p_positions, Circonscription& p_destination)
+{
+	size_t precedent = m_vInscrits.size() ;
+	size_t precedentDestination = p_destination.m_vInscrits.size() ;
+	std::vector<Personne*> transferes ;
+
+	transferes.reserve(p_positions.size()) ;
+	for (std::size_t i: p_positions)
+		transferes.push_back(m_vInscrits[i]) ;
+
+	p_destination.m_vInscrits.reserve(precedentDestination + transferes.size()) ;
+	p_destination.m_indexNas.reserver(precedentDestination + transferes.size()) ;
+
+	std::vector<Personne*> copies ;
+	if (p_destination.m_ressource != m_ressource)
+	{
+		copies.reserve(transferes.size()) ;
+		try
+		{
+			for (Personne* inscrit: transferes)
+				copies.push_back(clonerPersonne(*inscrit, p_destination.m_ressource)) ;
+		}
+		catch (...)
+		{
+			for (Personne* copie: copies)
+				detruirePersonne(copie, p_destination.m_ressource) ;
+			throw ;
+		}
+	}
+
+	retirerPositions(p_positions) ;
+
+	for (std::size_t i = 0; i < transferes.size(); ++i)
+	{
+		Personne* inscrit = transferes[i] ;
+		std::uint32_t cle = util::compacterNas(inscrit->reqNas()) ;
+
+		std::shared_ptr<const Personne> version ;
+
+		m_indexNas.retirer(cle) ;
+		if (m_indexAlphabetique)
+			m_indexAlphabetique->retirer(*inscrit) ;
+		if (m_versions)
+		{
+			version = *m_versions->trouver(cle) ;
+			m_versions->retirer(cle) ;
+		}
+		if (!copies.empty())
+		{
+			detruirePersonne(inscrit, m_ressource) ;
+			inscrit = copies[i] ;
+		}
+		p_destination.m_vInscrits.push_back(inscrit) ;
+		p_destination.m_indexNas.inserer(cle, p_destination.m_vInscrits.size() - 1) ;
+		if (p_destination.m_indexAlphabetique)
+			p_destination.m_indexAlphabetique->inserer(*inscrit) ;
+		if (p_destination.m_versions)
+			p_destination.m_versions->inserer(cle, version ? version : std::shared_ptr<const Personne>(inscrit->clone())) ;
+	}
+
+	POSTCONDITION(m_vInscrits.size() == precedent - transferes.size()) ;
+	POSTCONDITION(p_destination.m_vInscrits.size() == precedentDestination + transferes.size()) ;
+	INVARIANTS() ;
+}
+
+/****************************************************************************//**
+ * Retire des pointeurs de la liste, sans les détruire.  Les inscrits qui
+ * restent gardent leur ordre, et l'index des NAS suit leur nouvelle position.
+ *
+ * \param[in] p_positions les positions à retirer, croissantes et distinctes
+ *
+ *//*****************************************************************************/
+
+void Circonscription::retirerPositions(const std::vector<std::size_t>& p_positions)
+{
+	PRECONDITION(!p_positions.empty() and p_positions.back() < m_vInscrits.size()) ;
+
+	std::vector<Personne*>::size_type conserves = p_positions.front() ;
+	for (std::size_t i = p_positions.front(), suivante = 0; i < m_vInscrits.size(); ++i)
+	{
+		if (suivante < p_positions.size() and p_positions[suivante] == i)
+		{
+			++suivante ;
+			continue ;
+		}
+		m_vInscrits[conserves] = m_vInscrits[i] ;
+		*m_indexNas.trouver(util::compacterNas(m_vInscrits[conserves]->reqNas())) = conserves ;
+		++conserves ;
+	}
+	m_vInscrits.resize(conserves) ;
 }
 
 /****************************************************************************//**
@@ -288,16 +951,20 @@ void Circonscription::desinscrire(const std::string& p_nas)
 
 void swap(Circonscription& lhs, Circonscription& rhs)
 {
-	PRECONDITION(lhs.validerCirconscription());
-	PRECONDITION(rhs.validerCirconscription());
+	PRECONDITION_COUTEUSE(lhs.validerCirconscription());
+	PRECONDITION_COUTEUSE(rhs.validerCirconscription());
 
 	using std::swap;
 	swap(lhs.m_nomCirconscription, rhs.m_nomCirconscription) ;
 	swap(lhs.m_deputeElu, rhs.m_deputeElu) ;
 	swap(lhs.m_vInscrits, rhs.m_vInscrits) ;
+	swap(lhs.m_indexNas, rhs.m_indexNas) ;
+	swap(lhs.m_ressource, rhs.m_ressource) ;
+	swap(lhs.m_indexAlphabetique, rhs.m_indexAlphabetique) ;
+	swap(lhs.m_versions, rhs.m_versions) ;
 
-	POSTCONDITION(lhs.validerCirconscription());
-	POSTCONDITION(rhs.validerCirconscription());
+	POSTCONDITION_COUTEUSE(lhs.validerCirconscription());
+	POSTCONDITION_COUTEUSE(rhs.validerCirconscription());
 }
 
 /****************************************************************************//**
@@ -311,7 +978,7 @@ void swap(Circonscription& lhs, Circonscription& rhs)
 
 Circonscription& Circonscription::operator = (Circonscription rhs)
 {
-	PRECONDITION(rhs.validerCirconscription());
+	PRECONDITION_COUTEUSE(rhs.validerCirconscription());
     swap(rhs, *this);
     INVARIANTS();
 	return *this ;
@@ -323,11 +990,15 @@ Circonscription& Circonscription::operator = (Circonscription rhs)
 * Les infos du député sortant
 * Les infos de chaque Personne, candidat ou électeur, sur la liste électorale
 *
+* \param[in] p_memoriser si vrai, la représentation de chaque personne est
+* mémorisée et réutilisée aux appels suivants (Personne::reqTexteFormate()):
+* pour un affichage rafraîchi souvent, au prix d'une copie du texte par inscrit
+*
 * \return Le texte contenant ces informations
 *
 *//******************************************************************************/
 
-std::string Circonscription::reqCirconscriptionFormate() const
+std::string Circonscription::reqCirconscriptionFormate(bool p_memoriser) const
 {
 	static std::string circonscriptionStr("Circonscription: ");
 	static std::string deputeStr("Député sortant: ");
@@ -337,7 +1008,10 @@ std::string Circonscription::reqCirconscriptionFormate() const
 
 
 	os <<  circonscriptionStr << m_nomCirconscription << ret;
-	os << deputeStr << ret << m_deputeElu.reqPersonneFormate() << ret << ret;
+	os << deputeStr << ret;
+	if (p_memoriser) os << *m_deputeElu.reqTexteFormate();
+	else os << m_deputeElu.reqPersonneFormate();
+	os << ret << ret;
 
 	os << listeStr << ret;
 	if (m_vInscrits.empty())
@@ -348,7 +1022,9 @@ std::string Circonscription::reqCirconscriptionFormate() const
 	{
 		for (Personne* inscrit: m_vInscrits)
 		{
-			os << inscrit->reqPersonneFormate() << ret << ret;
+			if (p_memoriser) os << *inscrit->reqTexteFormate();
+			else os << formaterPersonne(*inscrit);
+			os << ret << ret;
 		}
 	}
 	return os.str();
@@ -361,8 +1037,10 @@ std::string Circonscription::reqCirconscriptionFormate() const
 
 Circonscription::~Circonscription()
 {
+	delete m_indexAlphabetique;
+	delete m_versions;
 	for (auto it = m_vInscrits.begin(); it != m_vInscrits.end(); ++it)
-		delete (*it);
+		detruirePersonne(*it, m_ressource);
 }
 
 } /* namespace elections */
@@ -11,13 +11,28 @@
 #ifndef CIRCONSCRIPTION_H_
 #define CIRCONSCRIPTION_H_
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <string>
 #include "Candidat.h"
 #include "Personne.h"
+#include "Resultat.h"
+#include "IndexNas.h"
+#include "Province.h"
+
+namespace util {
+class BassinDeTaches;
+template <typename T> class IndexNasPersistant;
+}
 
 namespace elections {
 
+class DeltaCirconscription;
+class IndexAlphabetique;
+class InstantaneCirconscription;
 
 
 /****************************************************************************//**
@@ -26,6 +41,32 @@ namespace elections {
  * Classe contenant le nom de la circonscription, les informations du député sortant
  * et la liste des électeurs.
  *
+ * Les inscrits sont des copies possédées par la circonscription.  Elles sont
+ * allouées dans une ressource mémoire optionnelle: une
+ * std::pmr::monotonic_buffer_resource pour une liste chargée en bloc puis
+ * surtout consultée, une std::pmr::unsynchronized_pool_resource pour une liste
+ * souvent modifiée.  La ressource doit survivre à la circonscription.  Une
+ * copie n'hérite pas de la ressource de l'original, comme les conteneurs pmr.
+ * Seul l'objet Personne y est placé: ses chaînes plus longues que la capacité
+ * locale de std::string restent allouées par new (voir Personne et Adresse).
+ *
+ * Un index des NAS donne la position de chaque inscrit dans la liste: le
+ * trouver, le remplacer ou le désinscrire se fait en temps constant.  Une
+ * désinscription met le dernier inscrit à la place du retiré.
+ *
+ * Un inscrit qui change de circonscription y est transféré sans être recopié
+ * quand les deux circonscriptions partagent la même ressource: le pointeur
+ * obtenu de reqInscrit() reste valide et désigne l'inscrit de la destination.
+ *
+ * Sur demande, un IndexAlphabetique range aussi les inscrits par nom et
+ * prénom; il est alors tenu à jour à chaque modification de la liste, et
+ * reconstruit dans une copie.
+ *
+ * Une fois activerInstantanes() appelée, la circonscription garde aussi une
+ * version immuable de chaque inscrit dans un util::IndexNasPersistant.  Chaque
+ * modification n'y recopie que l'inscrit touché, et reqInstantane() rend en
+ * temps constant une vue figée de la liste, partagée avec la circonscription.
+ *
  *//*****************************************************************************/
 
 class Circonscription {
@@ -38,12 +79,22 @@ public:
 
 	typedef std::vector<Personne*>::const_iterator Iterateur_t;
 
+	/************************************************************************//**
+	 * \type Selection_t Choisit les inscrits à transférer
+	 *//************************************************************************/
+
+	typedef std::function<bool(const Personne&)> Selection_t;
+
 private:
 
 
 	std::string            m_nomCirconscription;
 	Candidat               m_deputeElu;
 	std::vector<Personne*> m_vInscrits;
+	util::IndexNas<std::size_t> m_indexNas;
+	std::pmr::memory_resource* m_ressource;
+	IndexAlphabetique*     m_indexAlphabetique;
+	util::IndexNasPersistant<std::shared_ptr<const Personne>>* m_versions;
 
 	void verifieInvariant() const ;
 
@@ -51,6 +102,8 @@ private:
 
 	Iterateur_t trouver(const std::string&) const;
 	bool personneEstDejaPresente(const std::string& p_nas) const;
+	void deplacer(const std::vector<std::size_t>& p_positions, Circonscription& p_destination);
+	void retirerPositions(const std::vector<std::size_t>& p_positions);
 
 public:
 
@@ -60,13 +113,33 @@ public:
 
 	/* Constructeurs */
 
-	Circonscription(const std::string&, const Candidat&);
+	Circonscription(const std::string&, const Candidat&, std::pmr::memory_resource* p_ressource = nullptr);
 	Circonscription(const Circonscription&);
+	Circonscription(const Circonscription&, std::pmr::memory_resource* p_ressource);
 
 	/* Accesseurs */
 
 	const std::string& reqNomCirconscription() const ;
 	const Candidat& reqDeputeElu() const ;
+	std::pmr::memory_resource* reqRessource() const ;
+
+	/* Parcours de la liste */
+
+	Iterateur_t reqDebutInscrits() const ;
+	Iterateur_t reqFinInscrits() const ;
+	std::size_t reqNbInscrits() const ;
+	const Personne* reqInscrit(const std::string& p_nas) const ;
+	std::array<std::size_t, util::NB_PROVINCES + 1> reqNbInscritsParProvince() const ;
+
+	/* Ordre alphabétique */
+
+	void indexerParNom(util::BassinDeTaches* p_bassin = nullptr) ;
+	const IndexAlphabetique* reqIndexAlphabetique() const ;
+
+	/* Instantanés */
+
+	void activerInstantanes() ;
+	InstantaneCirconscription reqInstantane() const ;
 
 	/* Validation interne */
 
@@ -76,13 +149,29 @@ public:
 
 	/* Affichage */
 
-	std::string reqCirconscriptionFormate() const ;
+	std::string reqCirconscriptionFormate(bool p_memoriser = false) const ;
 
 	/* Manipulations de la liste */
 
 	void inscrire(const Personne& ) ;
 	void desinscrire(const std::string& p_nas) ;
 
+	/* Manipulations sans exception, pour les traitements en lot */
+
+	util::Resultat<void> tenterInscrire(const Personne& ) ;
+	util::Resultat<void> tenterInscrire(const Personne& , util::DejaValide) ;
+	util::Resultat<void> tenterDesinscrire(const std::string& p_nas) ;
+
+	/* Mise à jour à partir d'une autre version de la liste */
+
+	util::Resultat<void> remplacer(const Personne& ) ;
+	util::Resultat<void> appliquer(const DeltaCirconscription& p_delta) ;
+
+	/* Transfert vers une autre circonscription, sans copie */
+
+	util::Resultat<void> transferer(const std::string& p_nas, Circonscription& p_destination) ;
+	util::Resultat<std::size_t> transfererSi(const Selection_t& p_selection, Circonscription& p_destination) ;
+
 	/* Opérateurs */
 
 	Circonscription& operator=(Circonscription) ;
@@ -0,0 +1,276 @@
+/****************************************************************************//**
+ * \file CirconscriptionConcurrente.cpp
+ *
+ * \brief Implantation de la classe CirconscriptionConcurrente
+ *
+ *  Created on: 2020-12-17
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "CirconscriptionConcurrente.h"
+#include "ContratException.h"
+#include "PersonneException.h"
+#include "VisiteurPersonne.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Constructeur: liste vide
+ *
+ * \param[in] p_nom nom de la circonscription
+ * \param[in] p_depute député sortant
+ * \param[in] p_nbFragments nombre de fragments, une puissance de 2
+ *
+ * \pre p_nom est un nom valide, p_depute est valide
+ * \pre p_nbFragments est une puissance de 2
+ *//****************************************************************************/
+
+CirconscriptionConcurrente::CirconscriptionConcurrente(const std::string& p_nom, const Candidat& p_depute, std::size_t p_nbFragments)
+: m_nomCirconscription(p_nom), m_deputeElu(p_depute), m_nbFragments(p_nbFragments), m_decalage(64),
+  m_fragments(new Fragment[p_nbFragments]), m_nbInscrits(0), m_sequence(0)
+{
+	PRECONDITION(util::estUnNom(p_nom));
+	PRECONDITION(p_depute.valider());
+	PRECONDITION(p_nbFragments > 0 and (p_nbFragments & (p_nbFragments - 1)) == 0);
+
+	for (std::size_t n = p_nbFragments; n > 1; n /= 2) --m_decalage;
+
+	INVARIANTS();
+}
+
+/****************************************************************************//**
+ * Construit une liste partagée à partir d'une Circonscription, dont les
+ * inscrits sont copiés dans leur ordre d'inscription
+ *//****************************************************************************/
+
+CirconscriptionConcurrente::CirconscriptionConcurrente(const Circonscription& p_circonscription, std::size_t p_nbFragments)
+: CirconscriptionConcurrente(p_circonscription.reqNomCirconscription(), p_circonscription.reqDeputeElu(), p_nbFragments)
+{
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		tenterInscrire(**it);
+	}
+
+	POSTCONDITION(reqNbInscrits() == p_circonscription.reqNbInscrits());
+}
+
+/****************************************************************************//**
+ * Destructeur: désalloue chaque inscrit.  Aucun autre fil ne doit utiliser
+ * l'objet pendant sa destruction.
+ *//****************************************************************************/
+
+CirconscriptionConcurrente::~CirconscriptionConcurrente()
+{
+	for (std::size_t i = 0; i < m_nbFragments; ++i)
+	{
+		m_fragments[i].index.parcourir([](std::uint32_t, const Inscription& p_inscription)
+		{
+			delete p_inscription.personne;
+		});
+	}
+}
+
+/****************************************************************************//**
+ * \return le fragment responsable d'un NAS compacté: les bits de poids fort
+ * d'un hachage multiplicatif, pour ne pas réutiliser les bits qui choisissent
+ * la case dans l'index du fragment
+ *//****************************************************************************/
+
+CirconscriptionConcurrente::Fragment& CirconscriptionConcurrente::fragment(std::uint32_t p_cle) const
+{
+	if (m_decalage == 64) return m_fragments[0];
+	return m_fragments[static_cast<std::size_t>((p_cle * 0x9E3779B97F4A7C15ULL) >> m_decalage)];
+}
+
+const std::string& CirconscriptionConcurrente::reqNomCirconscription() const
+{
+	return m_nomCirconscription;
+}
+
+const Candidat& CirconscriptionConcurrente::reqDeputeElu() const
+{
+	return m_deputeElu;
+}
+
+/****************************************************************************//**
+ * \return le nombre d'inscrits.  Pendant des inscriptions concurrentes, la
+ * valeur peut être dépassée dès qu'elle est retournée.
+ *//****************************************************************************/
+
+std::size_t CirconscriptionConcurrente::reqNbInscrits() const
+{
+	return m_nbInscrits.load(std::memory_order_relaxed);
+}
+
+/****************************************************************************//**
+ * \return true si une personne inscrite a le NAS donné
+ *//****************************************************************************/
+
+bool CirconscriptionConcurrente::estInscrit(const std::string& p_nas) const
+{
+	return consulter(p_nas, [](const Personne&) {});
+}
+
+/****************************************************************************//**
+ * \return une copie allouée dynamiquement de l'inscrit, à désallouer par
+ * l'appelant; nullptr si aucun inscrit n'a ce NAS
+ *//****************************************************************************/
+
+Personne* CirconscriptionConcurrente::reqCopieInscrit(const std::string& p_nas) const
+{
+	Personne* copie = nullptr;
+	consulter(p_nas, [&copie](const Personne& p_personne) { copie = p_personne.clone(); });
+	return copie;
+}
+
+/****************************************************************************//**
+ * Copie cohérente de la liste: tous les fragments sont verrouillés en lecture,
+ * dans l'ordre, pendant la copie.  Les inscrits y sont dans leur ordre
+ * d'inscription.
+ *//****************************************************************************/
+
+Circonscription CirconscriptionConcurrente::reqCirconscription() const
+{
+	std::vector<std::shared_lock<std::shared_mutex>> verrous;
+	std::vector<Inscription> inscriptions;
+
+	verrous.reserve(m_nbFragments);
+	for (std::size_t i = 0; i < m_nbFragments; ++i)
+	{
+		verrous.emplace_back(m_fragments[i].verrou);
+		m_fragments[i].index.parcourir([&inscriptions](std::uint32_t, const Inscription& p_inscription)
+		{
+			inscriptions.push_back(p_inscription);
+		});
+	}
+	std::sort(inscriptions.begin(), inscriptions.end(), [](const Inscription& a, const Inscription& b)
+	{
+		return a.sequence < b.sequence;
+	});
+
+	Circonscription copie(m_nomCirconscription, m_deputeElu);
+	for (const Inscription& inscription: inscriptions)
+	{
+		copie.tenterInscrire(*inscription.personne, util::DEJA_VALIDE);
+	}
+	return copie;
+}
+
+/****************************************************************************//**
+ * Inscrit une personne
+ *
+ * \pre la personne est valide
+ * \exception PersonneDejaPresenteException si une personne avec le même NAS est inscrite
+ *//****************************************************************************/
+
+void CirconscriptionConcurrente::inscrire(const Personne& p_nouveau)
+{
+	util::Resultat<void> resultat = tenterInscrire(p_nouveau);
+
+	PRECONDITION(resultat.reqErreur() != util::PERSONNE_INVALIDE);
+
+	if (resultat.reqErreur() == util::PERSONNE_DEJA_PRESENTE)
+		throw PersonneDejaPresenteException(p_nouveau.reqNas());
+}
+
+/****************************************************************************//**
+ * Retire une personne
+ *
+ * \pre le NAS est valide
+ * \exception PersonneAbsenteException si aucun inscrit n'a ce NAS
+ *//****************************************************************************/
+
+void CirconscriptionConcurrente::desinscrire(const std::string& p_nas)
+{
+	util::Resultat<void> resultat = tenterDesinscrire(p_nas);
+
+	PRECONDITION(resultat.reqErreur() != util::NAS_INVALIDE);
+
+	if (resultat.reqErreur() == util::PERSONNE_ABSENTE)
+		throw PersonneAbsenteException(p_nas);
+}
+
+/****************************************************************************//**
+ * Inscrit une personne sans lancer d'exception.  La copie est faite avant de
+ * verrouiller le fragment, et détruite si le NAS est déjà présent ou si
+ * l'index ne peut grandir.  Le compte est augmenté sous le verrou: une
+ * désinscription concurrente du même NAS ne peut le diminuer avant.
+ *
+ * \return PERSONNE_INVALIDE ou PERSONNE_DEJA_PRESENTE si l'inscription est refusée
+ *//****************************************************************************/
+
+util::Resultat<void> CirconscriptionConcurrente::tenterInscrire(const Personne& p_nouveau)
+{
+	if (!validerPersonne(p_nouveau))
+		return util::PERSONNE_INVALIDE;
+
+	std::uint32_t cle = util::compacterNas(p_nouveau.reqNas());
+	std::unique_ptr<Personne> copie(p_nouveau.clone());
+	Inscription inscription;
+	inscription.personne = copie.get();
+	inscription.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+
+	bool insere;
+	{
+		Fragment& f = fragment(cle);
+		std::unique_lock<std::shared_mutex> verrou(f.verrou);
+		insere = f.index.inserer(cle, inscription);
+		if (insere)
+		{
+			copie.release();
+			m_nbInscrits.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	if (!insere)
+		return util::PERSONNE_DEJA_PRESENTE;
+	return util::AUCUNE_ERREUR;
+}
+
+/****************************************************************************//**
+ * Retire une personne sans lancer d'exception.  Le compte est diminué sous le
+ * verrou, comme il est augmenté par tenterInscrire(); la personne est
+ * désallouée après la libération du verrou.
+ *
+ * \return NAS_INVALIDE ou PERSONNE_ABSENTE si le retrait est impossible
+ *//****************************************************************************/
+
+util::Resultat<void> CirconscriptionConcurrente::tenterDesinscrire(const std::string& p_nas)
+{
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE;
+
+	std::uint32_t cle = util::compacterNas(p_nas);
+	Personne* retiree = nullptr;
+	{
+		Fragment& f = fragment(cle);
+		std::unique_lock<std::shared_mutex> verrou(f.verrou);
+		Inscription* inscription = f.index.trouver(cle);
+		if (inscription)
+		{
+			retiree = inscription->personne;
+			f.index.retirer(cle);
+			m_nbInscrits.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+	if (!retiree)
+		return util::PERSONNE_ABSENTE;
+
+	delete retiree;
+	return util::AUCUNE_ERREUR;
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS()
+ *//****************************************************************************/
+
+void CirconscriptionConcurrente::verifieInvariant() const
+{
+	INVARIANT(m_deputeElu.valider() and util::estUnNom(m_nomCirconscription));
+	INVARIANT(m_nbFragments > 0 and m_fragments);
+}
+
+} // namespace elections
@@ -0,0 +1,141 @@
+/**
+ * \file CirconscriptionConcurrente.h
+ *
+ * \brief Déclaration de la classe CirconscriptionConcurrente: une liste
+ * électorale partagée par plusieurs fils d'exécution.
+ *
+ *  Created on: 2020-12-17
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef CIRCONSCRIPTIONCONCURRENTE_H_
+#define CIRCONSCRIPTIONCONCURRENTE_H_
+
+#include "Circonscription.h"
+#include "IndexNas.h"
+#include "Resultat.h"
+#include "validationFormat.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class CirconscriptionConcurrente
+ *
+ * Variante de Circonscription dont toutes les méthodes peuvent être appelées
+ * en même temps par plusieurs fils d'exécution, par exemple un fil par bureau
+ * de scrutin.
+ *
+ * Les inscrits sont répartis en fragments selon leur NAS.  Chaque fragment a
+ * son propre index et son propre verrou lecteurs-rédacteur: deux opérations
+ * sur des NAS de fragments différents ne se bloquent jamais, et les lectures
+ * d'un même fragment se font en parallèle.  La copie d'une personne se fait
+ * avant de prendre le verrou, pour garder les sections critiques courtes.
+ *
+ * Le nom et le député sortant sont fixés à la construction.  Un numéro de
+ * séquence conserve l'ordre d'inscription, que reqCirconscription() rétablit.
+ *
+ *//*****************************************************************************/
+
+class CirconscriptionConcurrente
+{
+public:
+
+	static const std::size_t NB_FRAGMENTS_DEFAUT = 64;
+
+	CirconscriptionConcurrente(const std::string& p_nom, const Candidat& p_depute, std::size_t p_nbFragments = NB_FRAGMENTS_DEFAUT);
+	explicit CirconscriptionConcurrente(const Circonscription& p_circonscription, std::size_t p_nbFragments = NB_FRAGMENTS_DEFAUT);
+	~CirconscriptionConcurrente();
+
+	CirconscriptionConcurrente(const CirconscriptionConcurrente&) = delete;
+	CirconscriptionConcurrente& operator=(const CirconscriptionConcurrente&) = delete;
+
+	/* Accesseurs */
+
+	const std::string& reqNomCirconscription() const;
+	const Candidat& reqDeputeElu() const;
+	std::size_t reqNbInscrits() const;
+
+	/* Consultation */
+
+	bool estInscrit(const std::string& p_nas) const;
+	Personne* reqCopieInscrit(const std::string& p_nas) const;
+	template <typename Fonction>
+	bool consulter(const std::string& p_nas, Fonction p_fonction) const;
+	Circonscription reqCirconscription() const;
+
+	/* Manipulations de la liste */
+
+	void inscrire(const Personne& p_nouveau);
+	void desinscrire(const std::string& p_nas);
+	util::Resultat<void> tenterInscrire(const Personne& p_nouveau);
+	util::Resultat<void> tenterDesinscrire(const std::string& p_nas);
+
+private:
+
+	/**
+	 * Un inscrit et son rang d'inscription
+	 */
+
+	struct Inscription
+	{
+		Personne*     personne = nullptr;
+		std::uint64_t sequence = 0;
+	};
+
+	/**
+	 * Fragment de la liste, aligné sur une ligne de cache pour que les
+	 * verrous de deux fragments voisins ne se partagent pas une ligne.
+	 */
+
+	struct alignas(64) Fragment
+	{
+		mutable std::shared_mutex         verrou;
+		util::IndexNas<Inscription>       index;
+	};
+
+	Fragment& fragment(std::uint32_t p_cle) const;
+	void verifieInvariant() const;
+
+	const std::string            m_nomCirconscription;
+	const Candidat               m_deputeElu;
+	std::size_t                  m_nbFragments;
+	unsigned int                 m_decalage;
+	std::unique_ptr<Fragment[]>  m_fragments;
+	std::atomic<std::size_t>     m_nbInscrits;
+	std::atomic<std::uint64_t>   m_sequence;
+};
+
+/**
+ * Appelle p_fonction(const Personne&) sur l'inscrit de NAS donné, pendant que
+ * son fragment est verrouillé en lecture.  La référence ne doit pas être
+ * conservée après l'appel.
+ *
+ * \return false si aucun inscrit n'a ce NAS
+ */
+
+template <typename Fonction>
+bool CirconscriptionConcurrente::consulter(const std::string& p_nas, Fonction p_fonction) const
+{
+	std::uint32_t cle = util::compacterNas(p_nas);
+	Fragment& f = fragment(cle);
+	std::shared_lock<std::shared_mutex> verrou(f.verrou);
+
+	const Inscription* inscription = f.index.trouver(cle);
+	if (!inscription) return false;
+	p_fonction(static_cast<const Personne&>(*inscription->personne));
+	return true;
+}
+
+} // namespace elections
+
+#endif /* CIRCONSCRIPTIONCONCURRENTE_H_ */
@@ -0,0 +1,184 @@
+/**
+ * \file CodePostal.cpp
+ * \brief Implantation de la classe CodePostal
+ *
+ *  Created on: 2020-12-22
+ *  \version 0.1
+ *  \author Pascal Charpentier
+ */
+
+#include "CodePostal.h"
+#include "ContratException.h"
+
+namespace util
+{
+
+/****************************************************************************//**
+ * Numérote un triplet lettre-chiffre-lettre ou chiffre-lettre-chiffre, de 0 à
+ * NB_REGIONS_TRI - 1.  Les caractères sont vérifiés par différence non
+ * signée: un seul test par caractère, sans table ni appel.
+ *
+ * \return false si un caractère n'est pas du type attendu
+ *//****************************************************************************/
+
+static bool numeroterRegion(const char* p_texte, std::uint32_t& p_numero)
+{
+	std::uint32_t l1 = static_cast<unsigned char>(p_texte[0]) - 'A';
+	std::uint32_t d = static_cast<unsigned char>(p_texte[1]) - '0';
+	std::uint32_t l2 = static_cast<unsigned char>(p_texte[2]) - 'A';
+
+	p_numero = (l1 * 10 + d) * 26 + l2;
+	return l1 < 26 and d < 10 and l2 < 26;
+}
+
+static bool numeroterUnite(const char* p_texte, std::uint32_t& p_numero)
+{
+	std::uint32_t d1 = static_cast<unsigned char>(p_texte[0]) - '0';
+	std::uint32_t l = static_cast<unsigned char>(p_texte[1]) - 'A';
+	std::uint32_t d2 = static_cast<unsigned char>(p_texte[2]) - '0';
+
+	p_numero = (d1 * 26 + l) * 10 + d2;
+	return d1 < 10 and l < 26 and d2 < 10;
+}
+
+/****************************************************************************//**
+ * Analyse un code postal au format de util::validerCodePostal(): LDL DLD en
+ * majuscules
+ *
+ * \param[in] p_texte Le code postal
+ *
+ * \return le code, ou ADRESSE_INVALIDE si le format n'est pas respecté
+ *//****************************************************************************/
+
+Resultat<CodePostal> CodePostal::creer(const std::string& p_texte)
+{
+	std::uint32_t region;
+	std::uint32_t unite;
+
+	if (p_texte.size() != 7 or p_texte[3] != ' ')
+		return ADRESSE_INVALIDE;
+	if (!numeroterRegion(p_texte.data(), region) or !numeroterUnite(p_texte.data() + 4, unite))
+		return ADRESSE_INVALIDE;
+
+	CodePostal code;
+	code.m_valeur = region * NB_UNITES + unite + 1;
+	return code;
+}
+
+/****************************************************************************//**
+ * Analyse une région de tri d'acheminement: les trois premiers caractères
+ * d'un code postal
+ *
+ * \return le numéro de la région, ou ADRESSE_INVALIDE
+ *//****************************************************************************/
+
+Resultat<std::uint32_t> CodePostal::analyserRegionTri(const std::string& p_texte)
+{
+	std::uint32_t region;
+
+	if (p_texte.size() != 3 or !numeroterRegion(p_texte.data(), region))
+		return ADRESSE_INVALIDE;
+	return region;
+}
+
+/****************************************************************************//**
+ * Constructeur par défaut: aucun code postal canadien
+ *//****************************************************************************/
+
+CodePostal::CodePostal() : m_valeur(0)
+{
+}
+
+/****************************************************************************//**
+ * Constructeur à partir du texte
+ *
+ * \pre p_texte respecte le format de util::validerCodePostal()
+ *//****************************************************************************/
+
+CodePostal::CodePostal(const std::string& p_texte) : m_valeur(0)
+{
+	Resultat<CodePostal> code = creer(p_texte);
+
+	PRECONDITION(code.estValide());
+
+	m_valeur = code.reqValeur().m_valeur;
+}
+
+/****************************************************************************//**
+ * \return true s'il s'agit d'un code postal canadien
+ *//****************************************************************************/
+
+bool CodePostal::estValide() const
+{
+	return m_valeur != 0;
+}
+
+std::uint32_t CodePostal::reqValeur() const
+{
+	return m_valeur;
+}
+
+/****************************************************************************//**
+ * \return le numéro de la région de tri, de 0 à NB_REGIONS_TRI - 1
+ *
+ * \pre le code est valide
+ *//****************************************************************************/
+
+std::uint32_t CodePostal::reqRegionTri() const
+{
+	PRECONDITION(estValide());
+
+	return (m_valeur - 1) / NB_UNITES;
+}
+
+/****************************************************************************//**
+ * \return le code au format LDL DLD, ou une chaîne vide s'il n'est pas valide
+ *//****************************************************************************/
+
+std::string CodePostal::reqTexte() const
+{
+	if (!estValide()) return std::string();
+
+	std::uint32_t unite = (m_valeur - 1) % NB_UNITES;
+	std::string texte = reqTexteRegionTri();
+
+	texte += ' ';
+	texte += static_cast<char>('0' + unite / (26 * 10));
+	texte += static_cast<char>('A' + unite / 10 % 26);
+	texte += static_cast<char>('0' + unite % 10);
+	return texte;
+}
+
+/****************************************************************************//**
+ * \return les trois premiers caractères du code, ou une chaîne vide
+ *//****************************************************************************/
+
+std::string CodePostal::reqTexteRegionTri() const
+{
+	if (!estValide()) return std::string();
+
+	std::uint32_t region = reqRegionTri();
+	std::string texte;
+
+	texte += static_cast<char>('A' + region / 260);
+	texte += static_cast<char>('0' + region / 26 % 10);
+	texte += static_cast<char>('A' + region % 26);
+	return texte;
+}
+
+bool CodePostal::operator == (const CodePostal& p_code) const
+{
+	return m_valeur == p_code.m_valeur;
+}
+
+bool CodePostal::operator != (const CodePostal& p_code) const
+{
+	return m_valeur != p_code.m_valeur;
+}
+
+bool CodePostal::operator < (const CodePostal& p_code) const
+{
+	return m_valeur < p_code.m_valeur;
+}
+
+} // namespace util
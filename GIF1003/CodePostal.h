@@ -0,0 +1,64 @@
+/**
+ * \file CodePostal.h
+ * \brief Déclaration de la classe CodePostal
+ *
+ *  Created on: 2020-12-22
+ *  \version 0.1
+ *  \author Pascal Charpentier
+ */
+
+#ifndef CODEPOSTAL_H_
+#define CODEPOSTAL_H_
+
+#include "Resultat.h"
+
+#include <cstdint>
+#include <string>
+
+namespace util
+{
+
+/**
+ * \class CodePostal
+ * \brief Code postal canadien LDL DLD, tenu dans un entier
+ *
+ * Les trois premiers caractères forment la région de tri d'acheminement
+ * (RTA, « FSA » en anglais), numérotée de 0 à NB_REGIONS_TRI - 1; les trois
+ * derniers, l'unité de distribution locale, numérotée de 0 à NB_UNITES - 1.
+ * La valeur compacte vaut RTA * NB_UNITES + unité + 1: l'ordre des valeurs est
+ * celui des codes, les codes d'une même région sont contigus, et 0 désigne
+ * l'absence de code canadien.
+ *
+ */
+
+class CodePostal
+{
+public:
+
+	static const std::uint32_t NB_REGIONS_TRI = 26 * 10 * 26;
+	static const std::uint32_t NB_UNITES = 10 * 26 * 10;
+
+	static Resultat<CodePostal> creer(const std::string& p_texte);
+	static Resultat<std::uint32_t> analyserRegionTri(const std::string& p_texte);
+
+	CodePostal();
+	explicit CodePostal(const std::string& p_texte);
+
+	bool estValide() const;
+	std::uint32_t reqValeur() const;
+	std::uint32_t reqRegionTri() const;
+	std::string reqTexte() const;
+	std::string reqTexteRegionTri() const;
+
+	bool operator == (const CodePostal& p_code) const;
+	bool operator != (const CodePostal& p_code) const;
+	bool operator < (const CodePostal& p_code) const;
+
+private:
+
+	std::uint32_t m_valeur;
+};
+
+} // namespace util
+
+#endif /* CODEPOSTAL_H_ */
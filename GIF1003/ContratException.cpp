@@ -8,14 +8,16 @@
 
 using namespace std;
 /**
- * \brief Constructeur de la classe de base ContratException
+ * \brief Constructeur de la classe de base ContratException.  Le fichier et
+ * 		  l'expression sont des littéraux (__FILE__ et #f): on conserve les pointeurs
+ * 		  sans recopier les chaînes.
  * \param p_fichP chaîne de caractères représentant le fichier source dans lequel a eu lieu l'erreur
  * \param p_prmLigne un entier représentant la ligne où a eu lieu l'erreur
  * \param p_msgP Message décrivant l'erreur
  * \param p_exprP Test logique qui a échoué
  */
-ContratException::ContratException(std::string p_fichP, unsigned int p_prmLigne,
-		std::string p_exprP, std::string p_msgP) :
+ContratException::ContratException(const char* p_fichP, unsigned int p_prmLigne,
+		const char* p_exprP, const char* p_msgP) :
 	logic_error(p_msgP), m_expression(p_exprP), m_fichier(p_fichP), m_ligne(p_prmLigne)
 {
 }
@@ -45,8 +47,8 @@ std::string ContratException::reqTexteException() const
  *
  */
 
- AssertionException::AssertionException(std::string p_fichP, unsigned int p_prmLigne,
- std::string p_exprP)
+ AssertionException::AssertionException(const char* p_fichP, unsigned int p_prmLigne,
+ const char* p_exprP)
  : ContratException(p_fichP, p_prmLigne, p_exprP, "ERREUR D'ASSERTION")
  {
  }
@@ -58,8 +60,8 @@ std::string ContratException::reqTexteException() const
   * \param p_prmLigne un entier représentant la ligne où a eu lieu l'erreur
   * \param p_exprP Test logique qui a échoué
   */
- PreconditionException::PreconditionException(std::string p_fichP, unsigned int p_prmLigne,
- std::string p_exprP)
+ PreconditionException::PreconditionException(const char* p_fichP, unsigned int p_prmLigne,
+ const char* p_exprP)
  : ContratException(p_fichP, p_prmLigne, p_exprP, "ERREUR DE PRECONDITION")
  {
  }
@@ -70,8 +72,8 @@ std::string ContratException::reqTexteException() const
  * \param p_prmLigne un entier représentant la ligne où a eu lieu l'erreur
  * \param p_exprP Test logique qui a échoué
  */
- PostconditionException::PostconditionException(std::string p_fichP, unsigned int p_prmLigne,
- std::string p_exprP)
+ PostconditionException::PostconditionException(const char* p_fichP, unsigned int p_prmLigne,
+ const char* p_exprP)
  : ContratException(p_fichP, p_prmLigne, p_exprP, "ERREUR DE POSTCONDITION")
  {
  }
@@ -83,8 +85,8 @@ std::string ContratException::reqTexteException() const
   * \param p_prmLigne un entier représentant la ligne où a eu lieu l'erreur
   * \param p_exprP Test logique qui a échoué
   */
- InvariantException::InvariantException(std::string p_fichP, unsigned int p_prmLigne,
- std::string p_exprP)
+ InvariantException::InvariantException(const char* p_fichP, unsigned int p_prmLigne,
+ const char* p_exprP)
  : ContratException(p_fichP, p_prmLigne, p_exprP, "ERREUR D'INVARIANT")
  {
  }
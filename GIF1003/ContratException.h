@@ -16,7 +16,7 @@
 class ContratException: public std::logic_error
 {
 public:
-	ContratException(std::string, unsigned int, std::string, std::string);
+	ContratException(const char*, unsigned int, const char*, const char*);
 	~ContratException() throw ()
 	{
 	}
@@ -24,8 +24,8 @@ public:
 	std::string reqTexteException() const;
 
 private:
-	std::string m_expression;
-	std::string m_fichier;
+	const char*  m_expression;
+	const char*  m_fichier;
 	unsigned int m_ligne;
 };
 /**
@@ -36,7 +36,7 @@ private:
 class AssertionException: public ContratException
 {
 public:
-	AssertionException(std::string, unsigned int, std::string);
+	AssertionException(const char*, unsigned int, const char*);
 };
 /**
  * \class PreconditionException
@@ -46,7 +46,7 @@ public:
 class PreconditionException: public ContratException
 {
 public:
-	PreconditionException(std::string, unsigned int, std::string);
+	PreconditionException(const char*, unsigned int, const char*);
 };
 /**
  * \class PostconditionException
@@ -55,7 +55,7 @@ public:
 class PostconditionException: public ContratException
 {
 public:
-	PostconditionException(std::string, unsigned int, std::string);
+	PostconditionException(const char*, unsigned int, const char*);
 };
 
 /**
@@ -65,36 +65,86 @@ public:
 class InvariantException: public ContratException
 {
 public:
-	InvariantException(std::string, unsigned int, std::string);
+	InvariantException(const char*, unsigned int, const char*);
 };
 
 
-// --- Définition des macros de contrôle de la théorie du contrat
+// --- Niveaux de vérification du contrat
+//
+// NIVEAU_CONTRAT est fixé à la compilation (-DNIVEAU_CONTRAT=n):
+//   0 : aucun test, le contrat disparaît du code généré
+//   1 : tests en temps constant seulement (défaut avec NDEBUG)
+//   2 : tests en temps constant, et tests coûteux (en O(n)) un appel sur
+//       contrat::PERIODE_ECHANTILLON (défaut en mode debug)
+//   3 : tous les tests, à chaque appel
+//
+// Les macros PRECONDITION, POSTCONDITION, INVARIANT et ASSERTION sont
+// réservées aux tests en temps constant.  Un test dont le coût dépend de la
+// taille de l'objet utilise la variante _COUTEUSE ou _COUTEUX.
 
-#if !defined(NDEBUG)
-// --- Mode debug
+#ifndef NIVEAU_CONTRAT
+#  if defined(NDEBUG)
+#    define NIVEAU_CONTRAT 1
+#  else
+#    define NIVEAU_CONTRAT 2
+#  endif
+#endif
 
-#  define INVARIANTS() \
-      verifieInvariant()
+namespace contrat
+{
 
-#  define ASSERTION(f)     \
-      if (!(f)) throw AssertionException(__FILE__,__LINE__, #f);
-#  define PRECONDITION(f)  \
-      if (!(f)) throw PreconditionException(__FILE__, __LINE__, #f);
-#  define POSTCONDITION(f) \
-      if (!(f)) throw PostconditionException(__FILE__, __LINE__, #f);
-#  define INVARIANT(f)   \
-      if (!(f)) throw InvariantException(__FILE__,__LINE__, #f);
+enum Niveau {AUCUN, ECONOMIQUE, ECHANTILLONNE, EXHAUSTIF};
 
-// --- LE MODE RELEASE
-#else
+constexpr Niveau NIVEAU_COURANT = static_cast<Niveau>(NIVEAU_CONTRAT);
+constexpr unsigned int PERIODE_ECHANTILLON = 64;
 
-#  define PRECONDITION(f);
-#  define POSTCONDITION(f);
-#  define INVARIANTS();
-#  define INVARIANT(f);
-#  define ASSERTION(f);
+/**
+ * \brief Vrai si les tests du niveau N sont compilés.  Évalué à la compilation:
+ * un test inactif est éliminé par le compilateur.
+ */
+template <Niveau N>
+struct EstActif
+{
+	static constexpr bool valeur = (N <= NIVEAU_COURANT);
+};
 
-#endif  // --- if !defined (NDEBUG)
-#endif  // --- ifndef CONTRATEXCEPTION_H_DEJA_INCLU
+/**
+ * \brief Décide si un test coûteux doit être exécuté à cet appel.
+ * \return toujours vrai au niveau EXHAUSTIF, vrai un appel sur PERIODE_ECHANTILLON
+ * au niveau ECHANTILLONNE, toujours faux en-dessous.
+ */
+inline bool echantillonner()
+{
+	if (EstActif<EXHAUSTIF>::valeur) return true;
+	if (!EstActif<ECHANTILLONNE>::valeur) return false;
 
+	static thread_local unsigned int compteur = 0;
+	return (compteur++ % PERIODE_ECHANTILLON) == 0;
+}
+
+} // namespace contrat
+
+// --- Définition des macros de contrôle de la théorie du contrat
+
+#define INVARIANTS() \
+      if (contrat::EstActif<contrat::ECONOMIQUE>::valeur) verifieInvariant()
+
+#define ASSERTION(f)     \
+      if (contrat::EstActif<contrat::ECONOMIQUE>::valeur and !(f)) throw AssertionException(__FILE__,__LINE__, #f);
+#define PRECONDITION(f)  \
+      if (contrat::EstActif<contrat::ECONOMIQUE>::valeur and !(f)) throw PreconditionException(__FILE__, __LINE__, #f);
+#define POSTCONDITION(f) \
+      if (contrat::EstActif<contrat::ECONOMIQUE>::valeur and !(f)) throw PostconditionException(__FILE__, __LINE__, #f);
+#define INVARIANT(f)   \
+      if (contrat::EstActif<contrat::ECONOMIQUE>::valeur and !(f)) throw InvariantException(__FILE__,__LINE__, #f);
+
+// --- Tests coûteux, exécutés selon contrat::echantillonner()
+
+#define PRECONDITION_COUTEUSE(f)  \
+      if (contrat::echantillonner() and !(f)) throw PreconditionException(__FILE__, __LINE__, #f);
+#define POSTCONDITION_COUTEUSE(f) \
+      if (contrat::echantillonner() and !(f)) throw PostconditionException(__FILE__, __LINE__, #f);
+#define INVARIANT_COUTEUX(f)   \
+      if (contrat::echantillonner() and !(f)) throw InvariantException(__FILE__,__LINE__, #f);
+
+#endif  // --- ifndef CONTRATEXCEPTION_H_DEJA_INCLU
@@ -10,7 +10,10 @@
  */
 
 #include "Date.h"
+#include <charconv>
+#include <cstring>
 #include <sstream>
+#include <string_view>
 #include <ctime>
 #include <iostream>
 static const long MAX_SECONDE = 2145848400;
@@ -28,11 +31,10 @@ Date::Date()
 {
 	m_temps = time(NULL);
 
-	struct tm* infoTempsP = localtime(&m_temps);
-	ASSERTION(infoTempsP != NULL);
+	struct tm infoTemps = decomposer();
 
-	asgDate(infoTempsP->tm_mday, infoTempsP->tm_mon + 1,
-			infoTempsP->tm_year + 1900);
+	asgDate(infoTemps.tm_mday, infoTemps.tm_mon + 1,
+			infoTemps.tm_year + 1900);
 
 	INVARIANTS();
 }
@@ -109,15 +111,32 @@ bool Date::ajouteNbJour(long p_nbJour)
 	INVARIANTS();
 	return bRet;
 }
+/**
+ * \brief Décompose m_temps en jour, mois, année selon l'heure locale.
+ * 		  localtime() retourne un tampon statique partagé par tous les fils
+ * 		  d'exécution: on utilise sa version réentrante, qui écrit dans une
+ * 		  structure locale.
+ * \return la structure tm correspondant à la date
+ */
+struct tm Date::decomposer() const
+{
+	struct tm infoTemps;
+#ifdef _WIN32
+	bool reussi = (localtime_s(&infoTemps, &m_temps) == 0);
+#else
+	bool reussi = (localtime_r(&m_temps, &infoTemps) != NULL);
+#endif
+	ASSERTION(reussi);//AssertionException si l'heure n'a pas correctement été décomposée
+	return infoTemps;
+}
 /**
  * \brief retourne le jour de la date
  * \return un entier long qui représente le jour de la date
  */
 long Date::reqJour() const
 {
-	struct tm* infoTempsP = localtime(&m_temps);
-	ASSERTION(infoTempsP != NULL);
-	return infoTempsP->tm_mday;
+	struct tm infoTemps = decomposer();
+	return infoTemps.tm_mday;
 }
 /**
  * \brief retourne le mois de la date
@@ -125,9 +144,8 @@ long Date::reqJour() const
  */
 long Date::reqMois() const
 {
-	struct tm* infoTempsP = localtime(&m_temps);
-	ASSERTION(infoTempsP != NULL);
-	return infoTempsP->tm_mon + 1;
+	struct tm infoTemps = decomposer();
+	return infoTemps.tm_mon + 1;
 }
 /**
  * \brief retourne l'année de la date
@@ -135,9 +153,8 @@ long Date::reqMois() const
  */
 long Date::reqAnnee() const
 {
-	struct tm* infoTempsP = localtime(&m_temps);
-	ASSERTION(infoTempsP != NULL);
-	return infoTempsP->tm_year + 1900;
+	struct tm infoTemps = decomposer();
+	return infoTemps.tm_year + 1900;
 }
 /**
  * \brief retourne le ième jour de l'année correspondant au jour de la date
@@ -145,9 +162,8 @@ long Date::reqAnnee() const
  */
 long Date::reqJourAnnee() const
 {
-	struct tm* infoTempsP = localtime(&m_temps);
-	ASSERTION(infoTempsP != NULL);
-	return infoTempsP->tm_yday + 1;
+	struct tm infoTemps = decomposer();
+	return infoTemps.tm_yday + 1;
 }
 /**
  * \brief Déterminer si une année est bissextile ou non
@@ -167,51 +183,83 @@ bool Date::estBissextile(long p_annee)
 	return estBissextile;
 }
 /**
- * \brief retourne le nom du jour de la semaine en français
- * \return une chaîne de caractères qui représente le nom du jour de la semaine en français
+ * \brief retourne une date formatée dans une chaîne de caracères (string)
+ * \return la date formatée dans une chaîne de caractères
  */
-string Date::reqNomJourSemaine() const
+ string Date::reqDateFormatee() const
 {
-	static string JourSemaine[] =
-	{ "Dimanche", "Lundi", "Mardi", "Mercredi", "Jeudi", "Vendredi", "Samedi" };
+	char tampon[TAILLE_MAX_DATE_FORMATEE];
+
+	return string(tampon, formaterDate(tampon, tampon + TAILLE_MAX_DATE_FORMATEE));
+}
 
-	struct tm* infoTempsP = localtime(&m_temps);
-	ASSERTION(infoTempsP != NULL);//AssertionException si l'heure système n'a pas correctement été récupérée
-	return JourSemaine[infoTempsP->tm_wday];
+static constexpr string_view NOMS_JOURS[] =
+{ "Dimanche", "Lundi", "Mardi", "Mercredi", "Jeudi", "Vendredi", "Samedi" };
+static constexpr string_view NOMS_MOIS[] =
+{ "janvier", "fevrier", "mars", "avril", "mai", "juin", "juillet", "aout",
+		"septembre", "octobre", "novembre", "decembre" };
 
+/**
+ * \brief Écrit le texte de reqDateFormatee() à partir d'une date décomposée
+ * \return la fin du texte écrit
+ */
+static char* ecrireDate(const struct tm& p_infoTemps, char* p_debut, char* p_fin)
+{
+	const string_view& jour = NOMS_JOURS[p_infoTemps.tm_wday];
+	const string_view& mois = NOMS_MOIS[p_infoTemps.tm_mon];
+	char* p = p_debut;
+
+	memcpy(p, jour.data(), jour.size());
+	p += jour.size();
+	memcpy(p, " le ", 4);
+	p += 4;
+	*p++ = static_cast<char>('0' + p_infoTemps.tm_mday / 10);
+	*p++ = static_cast<char>('0' + p_infoTemps.tm_mday % 10);
+	*p++ = ' ';
+	memcpy(p, mois.data(), mois.size());
+	p += mois.size();
+	*p++ = ' ';
+	return to_chars(p, p_fin, p_infoTemps.tm_year + 1900).ptr;
 }
+
 /**
- * \brief retourne le nom du mois en français
- * \return une chaîne de caractères qui représente le nom du mois en français
+ * \brief Écrit la date formatée comme reqDateFormatee() dans un tampon
+ * 		  fourni, sans allocation: une seule décomposition de la date, les
+ * 		  noms viennent de tables et l'année est écrite par to_chars().
+ * \param[in] p_debut le début du tampon
+ * \param[in] p_fin la fin du tampon
+ * \pre le tampon a au moins TAILLE_MAX_DATE_FORMATEE caractères
+ * \return la fin du texte écrit; le texte n'est pas terminé par un zéro
  */
-string Date::reqNomMois() const
+char* Date::formaterDate(char* p_debut, char* p_fin) const
 {
-	static string NomMois[] =
-	{ "janvier", "fevrier", "mars", "avril", "mai", "juin", "juillet", "aout",
-			"septembre", "octobre", "novembre", "decembre" };
+	PRECONDITION(p_fin - p_debut >= static_cast<ptrdiff_t>(TAILLE_MAX_DATE_FORMATEE));
 
-	struct tm* infoTempsP = localtime(&m_temps);
-	ASSERTION(infoTempsP != NULL);//AssertionException si l'heure système n'a pas correctement été récupérée
-	return NomMois[infoTempsP->tm_mon];
+	return ecrireDate(decomposer(), p_debut, p_fin);
 }
+
 /**
- * \brief retourne une date formatée dans une chaîne de caracères (string)
- * \return la date formatée dans une chaîne de caractères
+ * \brief Écrit les dates d'un tableau, formatées comme reqDateFormatee() et
+ * 		  suivies chacune d'un séparateur, à la suite dans un même tampon.
+ * \param[in] p_dates le tableau de dates
+ * \param[in] p_nbDates le nombre de dates
+ * \param[in] p_debut le début du tampon
+ * \param[in] p_fin la fin du tampon
+ * \param[in] p_separateur le caractère écrit après chaque date
+ * \pre le tampon a au moins p_nbDates * (TAILLE_MAX_DATE_FORMATEE + 1) caractères
+ * \return la fin du texte écrit
  */
- string Date::reqDateFormatee() const
+char* Date::formaterDates(const Date* p_dates, size_t p_nbDates, char* p_debut, char* p_fin, char p_separateur)
 {
-	ostringstream os;
+	PRECONDITION(p_fin - p_debut >= static_cast<ptrdiff_t>(p_nbDates * (TAILLE_MAX_DATE_FORMATEE + 1)));
 
-	os << reqNomJourSemaine() << " le ";
-	if (reqJour() < 10)
+	char* p = p_debut;
+	for (size_t i = 0; i < p_nbDates; ++i)
 	{
-		os << "0";
+		p = ecrireDate(p_dates[i].decomposer(), p, p_fin);
+		*p++ = p_separateur;
 	}
-	os << reqJour() << " ";
-	os << reqNomMois() << " ";
-	os << reqAnnee();
-
-	return os.str();
+	return p;
 }
 
 /**
@@ -285,8 +333,9 @@ int Date::operator-(const Date& p_date) const
  */
  ostream& operator<<( ostream& p_os, const Date& p_date)
 {
-	long jour = p_date.reqJour();
-	long mois = p_date.reqMois();
+	struct tm infoTemps = p_date.decomposer();
+	long jour = infoTemps.tm_mday;
+	long mois = infoTemps.tm_mon + 1;
 
 	if (jour < 10)
 	{
@@ -298,7 +347,7 @@ int Date::operator-(const Date& p_date) const
 		p_os << "0";
 	}
 	p_os << mois << "/";
-	p_os << p_date.reqAnnee();
+	p_os << infoTemps.tm_year + 1900;
 
 	return p_os;
 }
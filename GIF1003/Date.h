@@ -8,6 +8,8 @@
 #ifndef DATE_H_
 #define DATE_H_
 #include "ContratException.h"
+#include <cstddef>
+#include <ctime>
 #include <string>
 
 namespace util
@@ -47,6 +49,10 @@ public:
 	long reqJourAnnee() const;
 	std::string reqDateFormatee() const;
 
+	static const std::size_t TAILLE_MAX_DATE_FORMATEE = 32;
+	char* formaterDate(char* p_debut, char* p_fin) const;
+	static char* formaterDates(const Date* p_dates, std::size_t p_nbDates, char* p_debut, char* p_fin, char p_separateur = '\n');
+
 	bool operator ==(const Date& p_date) const;
 	bool operator <(const Date& p_date) const;
 	int operator -(const Date& p_date) const;
@@ -57,9 +63,8 @@ public:
 	friend std::ostream& operator<<(std::ostream& p_os, const Date& p_date);
 
 private:
-	std::string reqNomJourSemaine() const;
-	std::string reqNomMois() const;
 	void verifieInvariant() const;
+	struct tm decomposer() const;
 	time_t m_temps;
 };
 
@@ -0,0 +1,227 @@
+/****************************************************************************//**
+ * \file DeltaCirconscription.cpp
+ *
+ * \brief Implantation de la classe DeltaCirconscription
+ *
+ *  Created on: 2020-12-21
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "DeltaCirconscription.h"
+#include "Candidat.h"
+#include "ContratException.h"
+#include "validationFormat.h"
+#include "VisiteurPersonne.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Une entrée d'une liste triée par NAS: le NAS compacté et l'inscrit
+ *//****************************************************************************/
+
+typedef std::pair<std::uint32_t, const Personne*> EntreeTriee_t;
+
+/****************************************************************************//**
+ * Range les inscrits d'une circonscription par NAS.  Le tri est omis si la
+ * liste est déjà dans cet ordre.
+ *//****************************************************************************/
+
+static std::vector<EntreeTriee_t> trierParNas(const Circonscription& p_circonscription)
+{
+	std::vector<EntreeTriee_t> entrees;
+	entrees.reserve(p_circonscription.reqNbInscrits());
+
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		entrees.emplace_back(util::compacterNas((*it)->reqNas()), *it);
+	}
+
+	auto parNas = [](const EntreeTriee_t& a, const EntreeTriee_t& b) { return a.first < b.first; };
+	if (!std::is_sorted(entrees.begin(), entrees.end(), parNas))
+		std::sort(entrees.begin(), entrees.end(), parNas);
+	return entrees;
+}
+
+/****************************************************************************//**
+ * Constructeur par défaut: un delta vide
+ *//****************************************************************************/
+
+DeltaCirconscription::DeltaCirconscription() : m_ajouts(), m_retraits(), m_modifications()
+{
+	INVARIANTS();
+}
+
+/****************************************************************************//**
+ * Compare deux listes par fusion de leurs inscrits triés par NAS
+ *
+ * \param[in] p_ancienne la liste à mettre à jour
+ * \param[in] p_nouvelle la liste à obtenir
+ *//****************************************************************************/
+
+DeltaCirconscription::DeltaCirconscription(const Circonscription& p_ancienne, const Circonscription& p_nouvelle)
+: m_ajouts(), m_retraits(), m_modifications()
+{
+	std::vector<EntreeTriee_t> anciens = trierParNas(p_ancienne);
+	std::vector<EntreeTriee_t> nouveaux = trierParNas(p_nouvelle);
+	std::size_t a = 0;
+	std::size_t n = 0;
+
+	try
+	{
+		while (a < anciens.size() or n < nouveaux.size())
+		{
+			if (n == nouveaux.size() or (a < anciens.size() and anciens[a].first < nouveaux[n].first))
+			{
+				m_retraits.push_back(anciens[a++].second->reqNas());
+			}
+			else if (a == anciens.size() or nouveaux[n].first < anciens[a].first)
+			{
+				m_ajouts.push_back(nouveaux[n++].second->clone());
+			}
+			else
+			{
+				if (!sontIdentiques(*anciens[a].second, *nouveaux[n].second))
+					m_modifications.push_back(nouveaux[n].second->clone());
+				++a;
+				++n;
+			}
+		}
+	}
+	catch (...)
+	{
+		for (Personne* p: m_ajouts) delete p;
+		for (Personne* p: m_modifications) delete p;
+		throw;
+	}
+
+	INVARIANTS();
+}
+
+/****************************************************************************//**
+ * Constructeur copie
+ *//****************************************************************************/
+
+DeltaCirconscription::DeltaCirconscription(const DeltaCirconscription& p_delta)
+: m_ajouts(), m_retraits(p_delta.m_retraits), m_modifications()
+{
+	m_ajouts.reserve(p_delta.m_ajouts.size());
+	m_modifications.reserve(p_delta.m_modifications.size());
+	try
+	{
+		for (Personne* p: p_delta.m_ajouts) m_ajouts.push_back(p->clone());
+		for (Personne* p: p_delta.m_modifications) m_modifications.push_back(p->clone());
+	}
+	catch (...)
+	{
+		for (Personne* p: m_ajouts) delete p;
+		for (Personne* p: m_modifications) delete p;
+		throw;
+	}
+
+	INVARIANTS();
+}
+
+void swap(DeltaCirconscription& lhs, DeltaCirconscription& rhs)
+{
+	using std::swap;
+
+	swap(lhs.m_ajouts, rhs.m_ajouts);
+	swap(lhs.m_retraits, rhs.m_retraits);
+	swap(lhs.m_modifications, rhs.m_modifications);
+}
+
+/****************************************************************************//**
+ * Opérateur d'assignation, par copie et échange
+ *//****************************************************************************/
+
+DeltaCirconscription& DeltaCirconscription::operator=(DeltaCirconscription p_delta)
+{
+	swap(*this, p_delta);
+	return *this;
+}
+
+DeltaCirconscription::~DeltaCirconscription()
+{
+	for (Personne* p: m_ajouts) delete p;
+	for (Personne* p: m_modifications) delete p;
+}
+
+/****************************************************************************//**
+ * \return true si les deux listes comparées ont les mêmes inscrits
+ *//****************************************************************************/
+
+bool DeltaCirconscription::estVide() const
+{
+	return m_ajouts.empty() and m_retraits.empty() and m_modifications.empty();
+}
+
+std::size_t DeltaCirconscription::reqNbAjouts() const
+{
+	return m_ajouts.size();
+}
+
+const Personne& DeltaCirconscription::reqAjout(std::size_t p_indice) const
+{
+	PRECONDITION(p_indice < m_ajouts.size());
+
+	return *m_ajouts[p_indice];
+}
+
+std::size_t DeltaCirconscription::reqNbRetraits() const
+{
+	return m_retraits.size();
+}
+
+const std::string& DeltaCirconscription::reqRetrait(std::size_t p_indice) const
+{
+	PRECONDITION(p_indice < m_retraits.size());
+
+	return m_retraits[p_indice];
+}
+
+std::size_t DeltaCirconscription::reqNbModifications() const
+{
+	return m_modifications.size();
+}
+
+const Personne& DeltaCirconscription::reqModification(std::size_t p_indice) const
+{
+	PRECONDITION(p_indice < m_modifications.size());
+
+	return *m_modifications[p_indice];
+}
+
+/****************************************************************************//**
+ * Compare deux inscrits de même NAS.  Personne::operator== ne voit que les
+ * attributs communs: un électeur devenu candidat, ou un candidat qui change de
+ * parti, est aussi une modification.
+ *//****************************************************************************/
+
+bool DeltaCirconscription::sontIdentiques(const Personne& p_premiere, const Personne& p_seconde)
+{
+	const Candidat* premier = commeCandidat(p_premiere);
+	const Candidat* second = commeCandidat(p_seconde);
+
+	if (p_premiere.reqType() != p_seconde.reqType())
+		return false;
+	if (premier and premier->reqPartiPolitique() != second->reqPartiPolitique())
+		return false;
+	return p_premiere == p_seconde;
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS()
+ *//****************************************************************************/
+
+void DeltaCirconscription::verifieInvariant() const
+{
+	INVARIANT_COUTEUX(std::find(m_ajouts.begin(), m_ajouts.end(), nullptr) == m_ajouts.end());
+	INVARIANT_COUTEUX(std::find(m_modifications.begin(), m_modifications.end(), nullptr) == m_modifications.end());
+}
+
+} // namespace elections
@@ -0,0 +1,78 @@
+/**
+ * \file DeltaCirconscription.h
+ *
+ * \brief Déclaration de la classe DeltaCirconscription, différence entre deux
+ * listes électorales d'une même circonscription.
+ *
+ *  Created on: 2020-12-21
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef DELTACIRCONSCRIPTION_H_
+#define DELTACIRCONSCRIPTION_H_
+
+#include "Circonscription.h"
+#include "Personne.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class DeltaCirconscription
+ *
+ * Ce qu'il faut faire à une liste « ancienne » pour obtenir une liste
+ * « nouvelle »: les inscrits ajoutés, les NAS retirés, et les inscrits dont un
+ * attribut, le type ou le parti a changé, dans leur nouvelle version.
+ *
+ * Les deux listes sont triées par NAS puis fusionnées en un seul passage, en
+ * O(n log n); une liste déjà triée par NAS n'est pas retriée, et la
+ * comparaison est alors linéaire.  Chaque partie du delta est ordonnée par NAS.
+ *
+ * Le delta possède ses propres copies des inscrits: il reste valide après la
+ * destruction des deux listes.  Circonscription::appliquer() le reporte sur une
+ * liste.
+ *
+ *//*****************************************************************************/
+
+class DeltaCirconscription
+{
+public:
+
+	friend void swap(DeltaCirconscription& lhs, DeltaCirconscription& rhs);
+
+	DeltaCirconscription();
+	DeltaCirconscription(const Circonscription& p_ancienne, const Circonscription& p_nouvelle);
+	DeltaCirconscription(const DeltaCirconscription& p_delta);
+	DeltaCirconscription& operator=(DeltaCirconscription p_delta);
+	~DeltaCirconscription();
+
+	bool estVide() const;
+
+	std::size_t reqNbAjouts() const;
+	const Personne& reqAjout(std::size_t p_indice) const;
+
+	std::size_t reqNbRetraits() const;
+	const std::string& reqRetrait(std::size_t p_indice) const;
+
+	std::size_t reqNbModifications() const;
+	const Personne& reqModification(std::size_t p_indice) const;
+
+	static bool sontIdentiques(const Personne& p_premiere, const Personne& p_seconde);
+
+private:
+
+	void verifieInvariant() const;
+
+	std::vector<Personne*>    m_ajouts;
+	std::vector<std::string>  m_retraits;
+	std::vector<Personne*>    m_modifications;
+};
+
+} // namespace elections
+
+#endif /* DELTACIRCONSCRIPTION_H_ */
@@ -0,0 +1,169 @@
+/****************************************************************************//**
+ * \file DepouillementBulletins.cpp
+ *
+ * \brief Implantation de la classe DepouillementBulletins
+ *
+ *  Created on: 2020-12-19
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "DepouillementBulletins.h"
+#include "ContratException.h"
+#include "VisiteurPersonne.h"
+
+#include <future>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Taille minimale d'une tranche: en deçà, le coût de la tâche dépasse celui
+ * du comptage
+ *//****************************************************************************/
+
+static const std::size_t TAILLE_MIN_TRANCHE = 65536;
+
+/****************************************************************************//**
+ * Constructeur: relève les candidats de la circonscription
+ *
+ * \param[in] p_circonscription la circonscription dépouillée
+ * \param[in] p_nbBureaux nombre de bureaux de scrutin
+ * \param[in] p_nbFils nombre de fils de dépouillement; 0 pour un par cœur
+ *
+ * \pre p_nbBureaux > 0
+ *//****************************************************************************/
+
+DepouillementBulletins::DepouillementBulletins(const Circonscription& p_circonscription, std::size_t p_nbBureaux, std::size_t p_nbFils)
+: m_candidats(), m_indices(), m_nbBureaux(p_nbBureaux), m_voix(), m_nbBulletins(0), m_mutex(), m_bassin(p_nbFils)
+{
+	PRECONDITION(p_nbBureaux > 0);
+
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		const Candidat* candidat = commeCandidat(**it);
+		if (candidat)
+		{
+			m_indices.inserer(util::compacterNas(candidat->reqNas()), static_cast<std::uint32_t>(m_candidats.size()));
+			m_candidats.push_back(*candidat);
+		}
+	}
+	m_voix.assign(m_candidats.size() + 1, 0);
+
+	INVARIANTS();
+}
+
+std::size_t DepouillementBulletins::reqNbCandidats() const
+{
+	return m_candidats.size();
+}
+
+const Candidat& DepouillementBulletins::reqCandidat(std::uint32_t p_indice) const
+{
+	PRECONDITION(p_indice < m_candidats.size());
+
+	return m_candidats[p_indice];
+}
+
+/****************************************************************************//**
+ * \return l'indice du candidat de NAS donné, à inscrire sur un Bulletin;
+ * PERSONNE_ABSENTE si aucun candidat n'a ce NAS
+ *//****************************************************************************/
+
+util::Resultat<std::uint32_t> DepouillementBulletins::reqIndiceCandidat(const std::string& p_nas) const
+{
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE;
+
+	const std::uint32_t* indice = m_indices.trouver(util::compacterNas(p_nas));
+	if (!indice)
+		return util::PERSONNE_ABSENTE;
+	return *indice;
+}
+
+/****************************************************************************//**
+ * Compte une tranche de bulletins dans des compteurs propres au fil.  La
+ * dernière case reçoit les bulletins rejetés.
+ *//****************************************************************************/
+
+void DepouillementBulletins::compterTranche(const Bulletin* p_debut, const Bulletin* p_fin, std::vector<std::uint64_t>& p_voix) const
+{
+	const std::uint32_t nbCandidats = static_cast<std::uint32_t>(m_candidats.size());
+	const std::uint32_t nbBureaux = static_cast<std::uint32_t>(m_nbBureaux);
+	std::uint64_t* voix = p_voix.data();
+
+	for (const Bulletin* b = p_debut; b != p_fin; ++b)
+	{
+		bool valide = b->candidat < nbCandidats and b->bureau < nbBureaux;
+		++voix[valide ? b->candidat : nbCandidats];
+	}
+}
+
+void DepouillementBulletins::depouiller(const std::vector<Bulletin>& p_bulletins)
+{
+	depouiller(p_bulletins.data(), p_bulletins.size());
+}
+
+/****************************************************************************//**
+ * Compte un lot de bulletins, en parallèle, et l'ajoute aux résultats
+ *
+ * \param[in] p_debut premier bulletin du lot
+ * \param[in] p_nbBulletins taille du lot
+ *//****************************************************************************/
+
+void DepouillementBulletins::depouiller(const Bulletin* p_debut, std::size_t p_nbBulletins)
+{
+	std::size_t nbTranches = m_bassin.reqNbFils();
+	if (p_nbBulletins / TAILLE_MIN_TRANCHE < nbTranches) nbTranches = p_nbBulletins / TAILLE_MIN_TRANCHE;
+	if (nbTranches == 0) nbTranches = 1;
+
+	std::vector<std::vector<std::uint64_t>> voixParTranche(nbTranches, std::vector<std::uint64_t>(m_voix.size(), 0));
+	std::vector<std::future<void>> taches;
+
+	for (std::size_t t = 1; t < nbTranches; ++t)
+	{
+		const Bulletin* debut = p_debut + p_nbBulletins * t / nbTranches;
+		const Bulletin* fin = p_debut + p_nbBulletins * (t + 1) / nbTranches;
+		std::vector<std::uint64_t>& voix = voixParTranche[t];
+		taches.push_back(m_bassin.soumettre([this, debut, fin, &voix]() { compterTranche(debut, fin, voix); }));
+	}
+	compterTranche(p_debut, p_debut + p_nbBulletins / nbTranches, voixParTranche[0]);
+	for (std::future<void>& tache: taches) tache.get();
+
+	std::lock_guard<std::mutex> verrou(m_mutex);
+	for (const std::vector<std::uint64_t>& voix: voixParTranche)
+		for (std::size_t c = 0; c < m_voix.size(); ++c)
+			m_voix[c] += voix[c];
+	m_nbBulletins += p_nbBulletins;
+}
+
+/****************************************************************************//**
+ * \return le décompte de tous les lots dépouillés jusqu'ici
+ *//****************************************************************************/
+
+ResultatsDepouillement DepouillementBulletins::reqResultats() const
+{
+	ResultatsDepouillement resultats;
+	std::lock_guard<std::mutex> verrou(m_mutex);
+
+	resultats.voixParCandidat.assign(m_voix.begin(), m_voix.end() - 1);
+	resultats.voixParParti.fill(0);
+	for (std::size_t c = 0; c < m_candidats.size(); ++c)
+		resultats.voixParParti[m_candidats[c].reqPartiPolitique()] += m_voix[c];
+	resultats.nbRejetes = m_voix.back();
+	resultats.nbBulletins = m_nbBulletins;
+
+	return resultats;
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS()
+ *//****************************************************************************/
+
+void DepouillementBulletins::verifieInvariant() const
+{
+	INVARIANT(m_nbBureaux > 0);
+	INVARIANT(m_voix.size() == m_candidats.size() + 1);
+	INVARIANT(m_indices.reqNbElements() == m_candidats.size());
+}
+
+} // namespace elections
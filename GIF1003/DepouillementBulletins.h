@@ -0,0 +1,113 @@
+/**
+ * \file DepouillementBulletins.h
+ *
+ * \brief Déclaration de la classe DepouillementBulletins, qui compte les votes
+ * d'une circonscription par candidat et par parti.
+ *
+ *  Created on: 2020-12-19
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef DEPOUILLEMENTBULLETINS_H_
+#define DEPOUILLEMENTBULLETINS_H_
+
+#include "BassinDeTaches.h"
+#include "Candidat.h"
+#include "Circonscription.h"
+#include "IndexNas.h"
+#include "Resultat.h"
+#include "validationFormat.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \struct Bulletin
+ *
+ * Un bulletin de vote: l'indice du candidat choisi, tel que donné par
+ * DepouillementBulletins::reqIndiceCandidat(), et le bureau de scrutin.
+ *
+ *//*****************************************************************************/
+
+struct Bulletin
+{
+	std::uint32_t candidat;
+	std::uint32_t bureau;
+};
+
+/****************************************************************************//**
+ * \struct ResultatsDepouillement
+ *
+ * Décompte des voix: par candidat, dans l'ordre des indices, et par parti,
+ * dans l'ordre de PartisPolitiques
+ *
+ *//*****************************************************************************/
+
+struct ResultatsDepouillement
+{
+	std::vector<std::uint64_t>                   voixParCandidat;
+	std::array<std::uint64_t, util::NB_PARTIS>   voixParParti;
+	std::uint64_t                                nbRejetes;
+	std::uint64_t                                nbBulletins;
+};
+
+/****************************************************************************//**
+ * \class DepouillementBulletins
+ *
+ * Compte les bulletins d'une circonscription.  Les candidats sont les
+ * inscrits de type Candidat, numérotés dans leur ordre d'inscription.  Un
+ * bulletin dont le candidat ou le bureau n'existe pas est rejeté.
+ *
+ * Les bulletins peuvent arriver en plusieurs lots.  Chaque lot est découpé en
+ * tranches, une par fil du bassin; chaque fil compte dans ses propres
+ * compteurs, sans aucune synchronisation, et les compteurs ne sont fusionnés
+ * qu'à la fin du lot.
+ *
+ *//*****************************************************************************/
+
+class DepouillementBulletins
+{
+public:
+
+	DepouillementBulletins(const Circonscription& p_circonscription, std::size_t p_nbBureaux, std::size_t p_nbFils = 0);
+
+	DepouillementBulletins(const DepouillementBulletins&) = delete;
+	DepouillementBulletins& operator=(const DepouillementBulletins&) = delete;
+
+	/* Candidats */
+
+	std::size_t reqNbCandidats() const;
+	const Candidat& reqCandidat(std::uint32_t p_indice) const;
+	util::Resultat<std::uint32_t> reqIndiceCandidat(const std::string& p_nas) const;
+
+	/* Dépouillement */
+
+	void depouiller(const std::vector<Bulletin>& p_bulletins);
+	void depouiller(const Bulletin* p_debut, std::size_t p_nbBulletins);
+	ResultatsDepouillement reqResultats() const;
+
+private:
+
+	void compterTranche(const Bulletin* p_debut, const Bulletin* p_fin, std::vector<std::uint64_t>& p_voix) const;
+	void verifieInvariant() const;
+
+	std::vector<Candidat>           m_candidats;
+	util::IndexNas<std::uint32_t>   m_indices;
+	std::size_t                     m_nbBureaux;
+	std::vector<std::uint64_t>      m_voix;
+	std::uint64_t                   m_nbBulletins;
+	mutable std::mutex              m_mutex;
+	util::BassinDeTaches            m_bassin;
+};
+
+} // namespace elections
+
+#endif /* DEPOUILLEMENTBULLETINS_H_ */
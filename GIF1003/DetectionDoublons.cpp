@@ -0,0 +1,256 @@
+/****************************************************************************//**
+ * \file DetectionDoublons.cpp
+ *
+ * \brief Détection des inscrits en double sous des NAS différents
+ *
+ *  Created on: 2020-12-22
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "DetectionDoublons.h"
+#include "Date.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Lettre de base des caractères U+00C0 à U+00FF, encodés en UTF-8 par 0xC3
+ * suivi de 0x80 à 0xBF.  0 pour un caractère qui n'est pas une lettre.
+ *//****************************************************************************/
+
+static const char LETTRES_ACCENTUEES[64] =
+{
+	'A', 'A', 'A', 'A', 'A', 'A', 'A', 'C', 'E', 'E', 'E', 'E', 'I', 'I', 'I', 'I',
+	'D', 'N', 'O', 'O', 'O', 'O', 'O',  0 , 'O', 'U', 'U', 'U', 'U', 'Y',  0 , 'S',
+	'A', 'A', 'A', 'A', 'A', 'A', 'A', 'C', 'E', 'E', 'E', 'E', 'I', 'I', 'I', 'I',
+	'D', 'N', 'O', 'O', 'O', 'O', 'O',  0 , 'O', 'U', 'U', 'U', 'U', 'Y',  0 , 'Y'
+};
+
+/****************************************************************************//**
+ * Ramène un nom à ses lettres: majuscules, sans accents, sans espaces, traits
+ * d'union ni apostrophes.  « Saint-Pierre » et « St Pierre » restent
+ * différents; « Bélanger » et « BELANGER » deviennent égaux.
+ *
+ * \param[in] p_nom un nom ou un prénom en UTF-8
+ *
+ * \return le nom normalisé, en ASCII
+ *//****************************************************************************/
+
+std::string normaliserNom(const std::string& p_nom)
+{
+	std::string normalise;
+	normalise.reserve(p_nom.size());
+
+	for (std::string::size_type i = 0; i < p_nom.size(); ++i)
+	{
+		unsigned char c = static_cast<unsigned char>(p_nom[i]);
+		if (c >= 'a' and c <= 'z')
+		{
+			normalise += static_cast<char>(c - 'a' + 'A');
+		}
+		else if ((c >= 'A' and c <= 'Z') or (c >= '0' and c <= '9'))
+		{
+			normalise += static_cast<char>(c);
+		}
+		else if (c == 0xC3 and i + 1 < p_nom.size())
+		{
+			unsigned char suite = static_cast<unsigned char>(p_nom[++i]);
+			if (suite >= 0x80 and suite <= 0xBF and LETTRES_ACCENTUEES[suite - 0x80])
+				normalise += LETTRES_ACCENTUEES[suite - 0x80];
+		}
+	}
+	return normalise;
+}
+
+/****************************************************************************//**
+ * Distance de Levenshtein par programmation dynamique, ligne par ligne
+ *//****************************************************************************/
+
+static unsigned int distanceParLignes(const std::string& p_premiere, const std::string& p_seconde)
+{
+	std::vector<unsigned int> ligne(p_premiere.size() + 1);
+	for (std::size_t i = 0; i <= p_premiere.size(); ++i) ligne[i] = static_cast<unsigned int>(i);
+
+	for (std::size_t j = 1; j <= p_seconde.size(); ++j)
+	{
+		unsigned int diagonale = ligne[0];
+		ligne[0] = static_cast<unsigned int>(j);
+		for (std::size_t i = 1; i <= p_premiere.size(); ++i)
+		{
+			unsigned int dessus = ligne[i];
+			unsigned int substitution = diagonale + (p_premiere[i - 1] != p_seconde[j - 1]);
+			ligne[i] = std::min(std::min(ligne[i - 1], dessus) + 1, substitution);
+			diagonale = dessus;
+		}
+	}
+	return ligne.back();
+}
+
+/****************************************************************************//**
+ * Distance de Levenshtein entre deux chaînes: le nombre minimal d'insertions,
+ * de suppressions et de substitutions d'octets qui changent l'une en l'autre.
+ *
+ * Si la plus courte a au plus 64 octets, ce qui est le cas des noms, chaque
+ * colonne de la matrice est tenue dans un mot de 64 bits et calculée en
+ * quelques opérations (algorithme de Myers, forme de Hyyrö): O(n) au lieu de
+ * O(n m).
+ *//****************************************************************************/
+
+unsigned int distanceEdition(const std::string& p_premiere, const std::string& p_seconde)
+{
+	const std::string& motif = p_premiere.size() <= p_seconde.size() ? p_premiere : p_seconde;
+	const std::string& texte = p_premiere.size() <= p_seconde.size() ? p_seconde : p_premiere;
+
+	if (motif.empty())
+		return static_cast<unsigned int>(texte.size());
+	if (motif.size() > 64)
+		return distanceParLignes(motif, texte);
+
+	std::uint64_t egalites[256] = {};
+	for (std::size_t i = 0; i < motif.size(); ++i)
+		egalites[static_cast<unsigned char>(motif[i])] |= std::uint64_t(1) << i;
+
+	const std::uint64_t dernier = std::uint64_t(1) << (motif.size() - 1);
+	std::uint64_t positifsV = ~std::uint64_t(0);
+	std::uint64_t negatifsV = 0;
+	unsigned int distance = static_cast<unsigned int>(motif.size());
+
+	for (unsigned char c: texte)
+	{
+		std::uint64_t egal = egalites[c];
+		std::uint64_t xV = egal | negatifsV;
+		std::uint64_t xH = (((egal & positifsV) + positifsV) ^ positifsV) | egal;
+		std::uint64_t positifsH = negatifsV | ~(xH | positifsV);
+		std::uint64_t negatifsH = positifsV & xH;
+
+		if (positifsH & dernier) ++distance;
+		else if (negatifsH & dernier) --distance;
+
+		positifsH = (positifsH << 1) | 1;
+		negatifsH <<= 1;
+		positifsV = negatifsH | ~(xV | positifsH);
+		negatifsV = positifsH & xV;
+	}
+	return distance;
+}
+
+/****************************************************************************//**
+ * Clé de blocage: le code postal, réduit à ses lettres et chiffres en base 37,
+ * et la date de naissance
+ *//****************************************************************************/
+
+struct CleBlocage
+{
+	std::uint64_t  codePostal;
+	util::Date     dateNaissance;
+	std::size_t    rang;
+};
+
+static std::uint64_t compacterCodePostal(const std::string& p_codePostal)
+{
+	std::uint64_t cle = 0;
+	unsigned int nbCaracteres = 0;
+
+	for (std::string::size_type i = 0; i < p_codePostal.size() and nbCaracteres < 12; ++i)
+	{
+		char c = p_codePostal[i];
+		if (c >= '0' and c <= '9') cle = cle * 37 + 1 + (c - '0');
+		else if (c >= 'A' and c <= 'Z') cle = cle * 37 + 11 + (c - 'A');
+		else if (c >= 'a' and c <= 'z') cle = cle * 37 + 11 + (c - 'a');
+		else continue;
+		++nbCaracteres;
+	}
+	return cle;
+}
+
+/****************************************************************************//**
+ * Cherche les inscrits qui sont peut-être une même personne inscrite sous deux
+ * NAS: même code postal, même date de naissance, et des noms proches.  Le nom
+ * et le prénom sont aussi comparés inversés.
+ *
+ * Seuls les inscrits d'un même bloc sont comparés entre eux: le coût est
+ * celui d'un tri des clés, O(n log n), plus la somme des carrés des tailles
+ * des blocs, petites en pratique.
+ *
+ * \param[in] p_circonscription la liste à examiner
+ * \param[in] p_distanceMax distance d'édition maximale entre les noms
+ * normalisés de deux doublons
+ *
+ * \return les paires trouvées, ordonnées selon la position du premier puis du
+ * second inscrit dans la liste
+ *//****************************************************************************/
+
+std::vector<PaireDoublons> detecterDoublons(const Circonscription& p_circonscription, unsigned int p_distanceMax)
+{
+	std::vector<CleBlocage> cles;
+	std::vector<const Personne*> inscrits(p_circonscription.reqDebutInscrits(), p_circonscription.reqFinInscrits());
+
+	cles.reserve(inscrits.size());
+	for (std::size_t i = 0; i < inscrits.size(); ++i)
+	{
+		cles.push_back(CleBlocage{compacterCodePostal(inscrits[i]->reqAdresse().reqCodePostal()),
+		                          inscrits[i]->reqDateNaissance(), i});
+	}
+	std::sort(cles.begin(), cles.end(), [](const CleBlocage& a, const CleBlocage& b)
+	{
+		if (a.codePostal != b.codePostal) return a.codePostal < b.codePostal;
+		if (!(a.dateNaissance == b.dateNaissance)) return a.dateNaissance < b.dateNaissance;
+		return a.rang < b.rang;
+	});
+
+	std::vector<std::pair<std::size_t, std::size_t>> rangs;
+	std::vector<PaireDoublons> doublons;
+	std::vector<std::string> nomPrenom;
+	std::vector<std::string> prenomNom;
+
+	std::size_t debut = 0;
+	while (debut < cles.size())
+	{
+		std::size_t fin = debut + 1;
+		while (fin < cles.size() and cles[fin].codePostal == cles[debut].codePostal
+		       and cles[fin].dateNaissance == cles[debut].dateNaissance) ++fin;
+
+		if (fin - debut > 1)
+		{
+			nomPrenom.clear();
+			prenomNom.clear();
+			for (std::size_t k = debut; k < fin; ++k)
+			{
+				const Personne* p = inscrits[cles[k].rang];
+				std::string nom = normaliserNom(p->reqNom());
+				std::string prenom = normaliserNom(p->reqPrenom());
+				nomPrenom.push_back(nom + prenom);
+				prenomNom.push_back(prenom + nom);
+			}
+			for (std::size_t a = 0; a + debut < fin; ++a)
+			{
+				for (std::size_t b = a + 1; b + debut < fin; ++b)
+				{
+					unsigned int distance = std::min(distanceEdition(nomPrenom[a], nomPrenom[b]),
+					                                 distanceEdition(prenomNom[a], nomPrenom[b]));
+					if (distance <= p_distanceMax)
+					{
+						rangs.emplace_back(cles[debut + a].rang, cles[debut + b].rang);
+						doublons.push_back(PaireDoublons{inscrits[cles[debut + a].rang], inscrits[cles[debut + b].rang], distance});
+					}
+				}
+			}
+		}
+		debut = fin;
+	}
+
+	std::vector<std::size_t> ordre(doublons.size());
+	for (std::size_t i = 0; i < ordre.size(); ++i) ordre[i] = i;
+	std::sort(ordre.begin(), ordre.end(), [&rangs](std::size_t a, std::size_t b) { return rangs[a] < rangs[b]; });
+
+	std::vector<PaireDoublons> ordonnes;
+	ordonnes.reserve(doublons.size());
+	for (std::size_t i: ordre) ordonnes.push_back(doublons[i]);
+	return ordonnes;
+}
+
+} // namespace elections
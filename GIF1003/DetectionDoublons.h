@@ -0,0 +1,51 @@
+/**
+ * \file DetectionDoublons.h
+ *
+ * \brief Déclaration des fonctions de détection des inscrits en double sous
+ * des NAS différents.
+ *
+ * Deux inscrits sont comparés seulement s'ils partagent le même code postal
+ * et la même date de naissance (« blocage »).  Les noms d'un même bloc sont
+ * ensuite comparés par distance d'édition, après normalisation: majuscules,
+ * sans accents, sans espaces ni traits d'union.
+ *
+ *  Created on: 2020-12-22
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef DETECTIONDOUBLONS_H_
+#define DETECTIONDOUBLONS_H_
+
+#include "Circonscription.h"
+#include "Personne.h"
+
+#include <string>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \struct PaireDoublons
+ *
+ * Deux inscrits qui sont peut-être la même personne, dans l'ordre de la liste,
+ * et la distance d'édition entre leurs noms normalisés
+ *
+ *//*****************************************************************************/
+
+struct PaireDoublons
+{
+	const Personne* premiere;
+	const Personne* seconde;
+	unsigned int    distance;
+};
+
+std::string normaliserNom(const std::string& p_nom);
+unsigned int distanceEdition(const std::string& p_premiere, const std::string& p_seconde);
+
+std::vector<PaireDoublons> detecterDoublons(const Circonscription& p_circonscription, unsigned int p_distanceMax = 2);
+
+} // namespace elections
+
+#endif /* DETECTIONDOUBLONS_H_ */
@@ -35,11 +35,39 @@ namespace elections {
  *//*****************************************************************************/
 
 Electeur::Electeur(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom, const util::Date& p_date, const util::Adresse& p_adresse) :
-		Personne(p_nas, p_nom, p_prenom, p_date, p_adresse)
+		Personne(p_nas, p_nom, p_prenom, p_date, p_adresse, TypePersonne::ELECTEUR)
 {
 
 }
 
+/****************************************************************************//**
+ * Constructeur de confiance, pour des champs déjà validés
+ *
+ * \pre les champs sont valides
+ *
+ *//*****************************************************************************/
+
+Electeur::Electeur(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom, const util::Date& p_date, const util::Adresse& p_adresse, util::DejaValide) :
+		Personne(p_nas, p_nom, p_prenom, p_date, p_adresse, TypePersonne::ELECTEUR, util::DEJA_VALIDE)
+{
+
+}
+
+/****************************************************************************//**
+ * Construit un électeur sans lancer d'exception si un paramètre est invalide.
+ *
+ * \return l'électeur, ou le code d'erreur du premier champ invalide
+ *
+ *//*****************************************************************************/
+
+util::Resultat<Electeur> Electeur::creer(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom, const util::Date& p_date, const util::Adresse& p_adresse)
+{
+	util::CodeErreur code = Personne::diagnostiquerIdentite(p_nas, p_nom, p_prenom);
+	if (code != util::AUCUNE_ERREUR)
+		return code;
+	return Electeur(p_nas, p_nom, p_prenom, p_date, p_adresse, util::DEJA_VALIDE);
+}
+
 /****************************************************************************//**
  * Retourne une chaîne de caractères contenant les attributs d'un Electeur sous
  * une forme affichable
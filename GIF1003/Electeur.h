@@ -23,13 +23,18 @@ namespace elections {
  *
  *//*****************************************************************************/
 
-class Electeur: public Personne {
+class Electeur final: public Personne {
 
 public:
 
 	/* Constructeurs */
 
 	Electeur(const std::string&, const std::string&, const std::string&, const util::Date&, const util::Adresse&);
+	Electeur(const std::string&, const std::string&, const std::string&, const util::Date&, const util::Adresse&, util::DejaValide);
+
+	/* Construction sans exception */
+
+	static util::Resultat<Electeur> creer(const std::string&, const std::string&, const std::string&, const util::Date&, const util::Adresse&);
 
 	/* Affichage */
 
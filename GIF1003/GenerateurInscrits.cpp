@@ -0,0 +1,421 @@
+/****************************************************************************//**
+ * \file GenerateurInscrits.cpp
+ *
+ * \brief Implantation de la classe GenerateurInscrits
+ *
+ *  Created on: 2020-12-15
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "GenerateurInscrits.h"
+#include "Circonscription.h"
+#include "validationFormat.h"
+
+#include <cstring>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Tables de valeurs plausibles
+ *//****************************************************************************/
+
+static const char* NOMS[] =
+{
+	"Tremblay", "Gagnon", "Roy", "Côté", "Bouchard", "Gauthier", "Morin", "Lavoie",
+	"Fortin", "Gagné", "Ouellet", "Pelletier", "Bélanger", "Lévesque", "Bergeron", "Leblanc",
+	"Paquette", "Girard", "Simard", "Boucher", "Caron", "Beaulieu", "Cloutier", "Dubé",
+	"Poirier", "Fournier", "Lapointe", "Leclerc", "Lefebvre", "Poulin", "Thibault", "St-Pierre"
+};
+
+static const char* PRENOMS[] =
+{
+	"Marie", "Jean", "Sophie", "Luc", "Julie", "Pierre", "Isabelle", "Michel",
+	"Nathalie", "Sylvain", "Chantal", "Stéphane", "Catherine", "François", "Geneviève", "Martin",
+	"Émilie", "Mathieu", "Annie", "Éric", "Mélanie", "Patrick", "Valérie", "Daniel",
+	"Caroline", "Alexandre", "Josée", "Sébastien", "Karine", "Guillaume", "Louise", "Jacques"
+};
+
+static const char* RUES[] =
+{
+	"des Érables", "Principale", "du Finfin", "Saint-Jean", "de l'Église", "du Lac",
+	"des Pins", "Notre-Dame", "Sacré-Coeur", "des Bouleaux", "Racine", "du Pont",
+	"Champlain", "de la Gare", "Laval", "des Cèdres"
+};
+
+/**
+ * Une ville, sa province et la première lettre de ses codes postaux
+ */
+
+struct Lieu
+{
+	const char* ville;
+	const char* province;
+	char        lettre;
+};
+
+static const Lieu LIEUX[] =
+{
+	{"Alma", "Québec", 'G'}, {"Québec", "Québec", 'G'}, {"Rimouski", "Québec", 'G'},
+	{"Montréal", "Québec", 'H'}, {"Laval", "Québec", 'H'}, {"Sherbrooke", "Québec", 'J'},
+	{"Gatineau", "Québec", 'J'}, {"Ottawa", "Ontario", 'K'}, {"Hamilton", "Ontario", 'L'},
+	{"Toronto", "Ontario", 'M'}, {"London", "Ontario", 'N'}, {"Sudbury", "Ontario", 'P'},
+	{"Moncton", "Nouveau-Brunswick", 'E'}, {"Halifax", "Nouvelle-Écosse", 'B'},
+	{"Charlottetown", "Ile du Prince Édouard", 'C'}, {"St. John's", "Terre-Neuve", 'A'},
+	{"Winnipeg", "Manitoba", 'R'}, {"Regina", "Saskatchewan", 'S'}, {"Calgary", "Alberta", 'T'},
+	{"Vancouver", "Colombie-Britannique", 'V'}, {"Yellowknife", "Territoires du Nord-Ouest", 'X'},
+	{"Iqaluit", "Nunavut", 'X'}, {"Whitehorse", "Yukon", 'Y'}
+};
+
+/**
+ * Lettres permises aux positions 3 et 5 d'un code postal: D, F, I, O, Q et U
+ * sont exclues
+ */
+
+static const char LETTRES_CODE_POSTAL[] = "ABCEGHJKLMNPRSTVWXYZ";
+
+static const std::size_t NB_NOMS = sizeof(NOMS) / sizeof(NOMS[0]);
+static const std::size_t NB_PRENOMS = sizeof(PRENOMS) / sizeof(PRENOMS[0]);
+static const std::size_t NB_RUES = sizeof(RUES) / sizeof(RUES[0]);
+static const std::size_t NB_LIEUX = sizeof(LIEUX) / sizeof(LIEUX[0]);
+static const std::size_t NB_LETTRES_CODE_POSTAL = sizeof(LETTRES_CODE_POSTAL) - 1;
+
+static const std::uint32_t MODULE_NAS = 100000000;
+static const std::uint32_t MULTIPLICATEUR_NAS = 48271;
+static const long ANNEE_MIN = 1971;
+static const long NB_ANNEES = 32;
+static const std::size_t TAILLE_TAMPON_FICHIER = 1 << 20;
+
+enum Defaut {AUCUN_DEFAUT, DEFAUT_NAS, DEFAUT_DATE, DEFAUT_ADRESSE, NB_DEFAUTS};
+
+/****************************************************************************//**
+ * Générateur pseudo-aléatoire splitmix64: rapide, sans état partagé, et dont
+ * la suite ne dépend pas de l'implantation de la bibliothèque standard.
+ *//****************************************************************************/
+
+static std::uint64_t melanger(std::uint64_t& p_etat)
+{
+	std::uint64_t z = (p_etat += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static std::uint64_t seuil(double p_proportion)
+{
+	if (p_proportion <= 0.0) return 0;
+	if (p_proportion >= 1.0) return UINT64_MAX;
+	return static_cast<std::uint64_t>(p_proportion * 18446744073709551616.0);
+}
+
+/****************************************************************************//**
+ * Valeurs tirées pour un indice donné
+ *//****************************************************************************/
+
+struct GenerateurInscrits::Tirage
+{
+	bool          candidat;
+	Defaut        defaut;
+	unsigned int  parti;
+	unsigned int  nom;
+	unsigned int  prenom;
+	unsigned int  rue;
+	unsigned int  lieu;
+	unsigned int  numero;
+	long          jour;
+	long          mois;
+	long          annee;
+	char          codePostal[8];
+};
+
+/****************************************************************************//**
+ * Constructeur
+ *
+ * \param[in] p_germe germe de la génération
+ * \param[in] p_proportionCandidats proportion des inscrits qui sont candidats
+ * \param[in] p_proportionInvalides proportion des blocs écrits invalides
+ *
+ * \pre les proportions sont entre 0 et 1
+ *//****************************************************************************/
+
+GenerateurInscrits::GenerateurInscrits(std::uint64_t p_germe, double p_proportionCandidats, double p_proportionInvalides)
+: m_germe(p_germe), m_seuilCandidats(seuil(p_proportionCandidats)), m_seuilInvalides(seuil(p_proportionInvalides))
+{
+	PRECONDITION(p_proportionCandidats >= 0.0 and p_proportionCandidats <= 1.0);
+	PRECONDITION(p_proportionInvalides >= 0.0 and p_proportionInvalides <= 1.0);
+}
+
+/****************************************************************************//**
+ * Tire les valeurs de l'inscrit d'indice donné.  Le député (indice 0) est
+ * toujours un candidat valide.
+ *//****************************************************************************/
+
+GenerateurInscrits::Tirage GenerateurInscrits::tirer(std::size_t p_indice) const
+{
+	std::uint64_t etat = m_germe ^ (p_indice * 0xD1B54A32D192ED03ULL);
+	std::uint64_t a = melanger(etat);
+	std::uint64_t b = melanger(etat);
+	std::uint64_t c = melanger(etat);
+	std::uint64_t d = melanger(etat);
+	Tirage tirage;
+
+	tirage.candidat = (p_indice == 0) or (melanger(etat) < m_seuilCandidats);
+	tirage.defaut = (p_indice != 0 and melanger(etat) < m_seuilInvalides) ?
+			static_cast<Defaut>(1 + d % (NB_DEFAUTS - 1)) : AUCUN_DEFAUT;
+	tirage.parti = static_cast<unsigned int>((a >> 40) % util::NB_PARTIS);
+	tirage.nom = static_cast<unsigned int>(a % NB_NOMS);
+	tirage.prenom = static_cast<unsigned int>((a >> 8) % NB_PRENOMS);
+	tirage.rue = static_cast<unsigned int>((a >> 16) % NB_RUES);
+	tirage.lieu = static_cast<unsigned int>((a >> 24) % NB_LIEUX);
+	tirage.numero = static_cast<unsigned int>(1 + b % 9999);
+	tirage.jour = static_cast<long>(1 + (b >> 16) % 28);
+	tirage.mois = static_cast<long>(1 + (b >> 24) % 12);
+	tirage.annee = ANNEE_MIN + static_cast<long>((b >> 32) % NB_ANNEES);
+
+	tirage.codePostal[0] = LIEUX[tirage.lieu].lettre;
+	tirage.codePostal[1] = static_cast<char>('0' + c % 10);
+	tirage.codePostal[2] = LETTRES_CODE_POSTAL[(c >> 8) % NB_LETTRES_CODE_POSTAL];
+	tirage.codePostal[3] = ' ';
+	tirage.codePostal[4] = static_cast<char>('0' + (c >> 16) % 10);
+	tirage.codePostal[5] = LETTRES_CODE_POSTAL[(c >> 24) % NB_LETTRES_CODE_POSTAL];
+	tirage.codePostal[6] = static_cast<char>('0' + (c >> 32) % 10);
+	tirage.codePostal[7] = '\0';
+
+	return tirage;
+}
+
+/****************************************************************************//**
+ * Les huit premiers chiffres du NAS: une bijection affine de l'indice sur
+ * [0, 10^8), décalée selon le germe, qui garantit des NAS distincts.
+ *//****************************************************************************/
+
+std::uint32_t GenerateurInscrits::corpsNas(std::size_t p_indice) const
+{
+	PRECONDITION(p_indice <= NB_MAX_INSCRITS);
+
+	std::uint64_t decalage = m_germe % MODULE_NAS;
+	return static_cast<std::uint32_t>((MULTIPLICATEUR_NAS * static_cast<std::uint64_t>(p_indice) + decalage) % MODULE_NAS);
+}
+
+/****************************************************************************//**
+ * Écrit les 11 caractères d'un NAS "XXX XXX XXX" à partir de ses huit premiers
+ * chiffres, en calculant la clé de contrôle.
+ *
+ * \param[in] p_corps les huit premiers chiffres
+ * \param[in] p_cleFausse true pour écrire une clé de contrôle erronée
+ * \param[out] p_tampon reçoit les 11 caractères, sans zéro terminal
+ *//****************************************************************************/
+
+static void ecrireNas(std::uint32_t p_corps, bool p_cleFausse, char* p_tampon)
+{
+	unsigned int chiffres[9];
+	unsigned int somme = 0;
+
+	for (int i = 7; i >= 0; --i)
+	{
+		chiffres[i] = p_corps % 10;
+		p_corps /= 10;
+	}
+	for (int i = 0; i < 8; ++i)
+	{
+		somme += (i % 2) ? (2 * chiffres[i] - 9 * (chiffres[i] / 5)) : chiffres[i];
+	}
+	chiffres[8] = (10 - somme % 10) % 10;
+	if (p_cleFausse) chiffres[8] = (chiffres[8] + 1) % 10;
+
+	for (int i = 0, j = 0; i < 9; ++i)
+	{
+		if (i == 3 or i == 6) p_tampon[j++] = ' ';
+		p_tampon[j++] = static_cast<char>('0' + chiffres[i]);
+	}
+}
+
+/****************************************************************************//**
+ * Primitives d'écriture dans un tampon: chacune avance le curseur
+ *//****************************************************************************/
+
+static void ecrireTexte(char*& p_curseur, const char* p_texte)
+{
+	std::size_t longueur = std::strlen(p_texte);
+	std::memcpy(p_curseur, p_texte, longueur);
+	p_curseur += longueur;
+}
+
+static void ecrireEntier(char*& p_curseur, unsigned long p_valeur, unsigned int p_largeurMin = 1)
+{
+	char chiffres[20];
+	unsigned int n = 0;
+	do
+	{
+		chiffres[n++] = static_cast<char>('0' + p_valeur % 10);
+		p_valeur /= 10;
+	} while (p_valeur != 0);
+	while (n < p_largeurMin) chiffres[n++] = '0';
+	while (n > 0) *p_curseur++ = chiffres[--n];
+}
+
+/****************************************************************************//**
+ * \return le NAS valide de l'inscrit d'indice donné
+ *//****************************************************************************/
+
+std::string GenerateurInscrits::reqNas(std::size_t p_indice) const
+{
+	char nas[11];
+	ecrireNas(corpsNas(p_indice), false, nas);
+	return std::string(nas, sizeof(nas));
+}
+
+/****************************************************************************//**
+ * Construit l'électeur d'indice donné.  Contrairement à ecrireBloc(), le
+ * résultat est toujours valide.
+ *
+ * \pre p_indice est entre 1 et NB_MAX_INSCRITS
+ *//****************************************************************************/
+
+Electeur GenerateurInscrits::reqElecteur(std::size_t p_indice) const
+{
+	PRECONDITION(p_indice >= 1);
+
+	Tirage tirage = tirer(p_indice);
+	const Lieu& lieu = LIEUX[tirage.lieu];
+
+	return Electeur(reqNas(p_indice), NOMS[tirage.nom], PRENOMS[tirage.prenom],
+			util::Date(tirage.jour, tirage.mois, tirage.annee),
+			util::Adresse(tirage.numero, RUES[tirage.rue], lieu.ville, tirage.codePostal, lieu.province));
+}
+
+/****************************************************************************//**
+ * Construit un candidat qui a l'identité et l'adresse de l'électeur d'indice
+ * donné
+ *
+ * \pre p_indice est entre 1 et NB_MAX_INSCRITS
+ *//****************************************************************************/
+
+Candidat GenerateurInscrits::reqCandidat(std::size_t p_indice, PartisPolitiques p_parti) const
+{
+	Electeur electeur = reqElecteur(p_indice);
+
+	return Candidat(electeur.reqNas(), electeur.reqNom(), electeur.reqPrenom(), electeur.reqDateNaissance(),
+			electeur.reqAdresse(), p_parti);
+}
+
+/****************************************************************************//**
+ * Inscrit dans une circonscription les électeurs d'indices p_premier à
+ * p_dernier inclusivement
+ *
+ * \pre p_premier >= 1
+ *//****************************************************************************/
+
+void GenerateurInscrits::inscrireElecteurs(Circonscription& p_circonscription, std::size_t p_premier,
+                                           std::size_t p_dernier) const
+{
+	PRECONDITION(p_premier >= 1);
+
+	for (std::size_t i = p_premier; i <= p_dernier; ++i)
+		p_circonscription.inscrire(reqElecteur(i));
+}
+
+/****************************************************************************//**
+ * \return le député sortant, qui porte l'indice 0
+ *//****************************************************************************/
+
+Candidat GenerateurInscrits::reqDepute() const
+{
+	Tirage tirage = tirer(0);
+	const Lieu& lieu = LIEUX[tirage.lieu];
+
+	return Candidat(reqNas(0), NOMS[tirage.nom], PRENOMS[tirage.prenom],
+			util::Date(tirage.jour, tirage.mois, tirage.annee),
+			util::Adresse(tirage.numero, RUES[tirage.rue], lieu.ville, tirage.codePostal, lieu.province),
+			static_cast<PartisPolitiques>(tirage.parti));
+}
+
+/****************************************************************************//**
+ * Écrit le bloc de l'inscrit d'indice donné au format de fichier, précédé de
+ * la ligne du parti s'il s'agit d'un candidat.
+ *
+ * \param[in] p_indice indice de l'inscrit; 0 pour le député
+ * \param[out] p_tampon reçoit au plus TAILLE_MAX_BLOC caractères
+ *
+ * \return le nombre de caractères écrits
+ *//****************************************************************************/
+
+std::size_t GenerateurInscrits::ecrireBloc(std::size_t p_indice, char* p_tampon) const
+{
+	Tirage tirage = tirer(p_indice);
+	const Lieu& lieu = LIEUX[tirage.lieu];
+	char* curseur = p_tampon;
+
+	if (tirage.candidat)
+	{
+		const std::string& parti = util::PARTIS_POLITIQUES_FEDERAUX[tirage.parti];
+		std::memcpy(curseur, parti.data(), parti.size());
+		curseur += parti.size();
+		*curseur++ = '\n';
+	}
+
+	ecrireNas(corpsNas(p_indice), tirage.defaut == DEFAUT_NAS, curseur);
+	curseur += 11;
+	*curseur++ = '\n';
+	ecrireTexte(curseur, NOMS[tirage.nom]);
+	*curseur++ = '\n';
+	ecrireTexte(curseur, PRENOMS[tirage.prenom]);
+	*curseur++ = '\n';
+
+	ecrireEntier(curseur, tirage.defaut == DEFAUT_DATE ? 30 : tirage.jour, 2);
+	*curseur++ = ' ';
+	ecrireEntier(curseur, tirage.defaut == DEFAUT_DATE ? 2 : tirage.mois, 2);
+	*curseur++ = ' ';
+	ecrireEntier(curseur, tirage.annee, 4);
+	*curseur++ = '\n';
+
+	ecrireEntier(curseur, tirage.defaut == DEFAUT_ADRESSE ? 0 : tirage.numero);
+	ecrireTexte(curseur, ", ");
+	ecrireTexte(curseur, RUES[tirage.rue]);
+	ecrireTexte(curseur, ", ");
+	ecrireTexte(curseur, lieu.ville);
+	ecrireTexte(curseur, ", ");
+	ecrireTexte(curseur, tirage.codePostal);
+	ecrireTexte(curseur, ", ");
+	ecrireTexte(curseur, lieu.province);
+	*curseur++ = '\n';
+
+	return static_cast<std::size_t>(curseur - p_tampon);
+}
+
+/****************************************************************************//**
+ * Écrit une liste électorale complète: le nom de la circonscription, le bloc
+ * du député puis p_nbInscrits blocs.  Le texte est accumulé dans un tampon
+ * d'un mégaoctet avant d'être écrit dans le flux.
+ *
+ * \param[in] p_os flux de sortie
+ * \param[in] p_nomCirconscription nom de la circonscription
+ * \param[in] p_nbInscrits nombre d'inscrits, sans compter le député
+ *
+ * \pre p_nomCirconscription est un nom valide
+ * \pre p_nbInscrits ne dépasse pas NB_MAX_INSCRITS
+ *//****************************************************************************/
+
+void GenerateurInscrits::ecrireFichier(std::ostream& p_os, const std::string& p_nomCirconscription, std::size_t p_nbInscrits) const
+{
+	PRECONDITION(util::estUnNom(p_nomCirconscription));
+	PRECONDITION(p_nbInscrits <= NB_MAX_INSCRITS);
+
+	std::vector<char> tampon(TAILLE_TAMPON_FICHIER + TAILLE_MAX_BLOC);
+	std::size_t taille = 0;
+
+	p_os << p_nomCirconscription << '\n';
+	for (std::size_t i = 0; i <= p_nbInscrits and p_os; ++i)
+	{
+		taille += ecrireBloc(i, tampon.data() + taille);
+		if (taille >= TAILLE_TAMPON_FICHIER)
+		{
+			p_os.write(tampon.data(), static_cast<std::streamsize>(taille));
+			taille = 0;
+		}
+	}
+	p_os.write(tampon.data(), static_cast<std::streamsize>(taille));
+}
+
+} // namespace elections
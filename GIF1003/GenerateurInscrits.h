@@ -0,0 +1,84 @@
+/**
+ * \file GenerateurInscrits.h
+ *
+ * \brief Déclaration de la classe GenerateurInscrits, qui produit des listes
+ * électorales synthétiques pour les essais de charge.
+ *
+ *  Created on: 2020-12-15
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef GENERATEURINSCRITS_H_
+#define GENERATEURINSCRITS_H_
+
+#include "Candidat.h"
+#include "Electeur.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace elections
+{
+
+class Circonscription;
+
+/****************************************************************************//**
+ * \class GenerateurInscrits
+ *
+ * Produit, de façon déterministe à partir d'un germe, les inscrits d'une liste
+ * électorale au format de util::validerFormatFichier().  Chaque inscrit est
+ * déterminé par son indice seul: on peut produire l'inscrit n sans produire
+ * les précédents, et deux générateurs de même germe produisent les mêmes
+ * données.
+ *
+ * L'indice 0 est celui du député sortant.  Les NAS des indices 0 à 99 999 999
+ * sont distincts et respectent la clé de contrôle.  Les codes postaux
+ * respectent la première lettre de la province et n'utilisent pas les lettres
+ * exclues par Postes Canada.
+ *
+ * Une fraction des blocs peut être rendue invalide: NAS dont la clé de contrôle
+ * est fausse, date impossible ou numéro civique nul.  Ces blocs gardent le
+ * même nombre de lignes qu'un bloc valide.
+ *
+ *//*****************************************************************************/
+
+class GenerateurInscrits
+{
+public:
+
+	static const std::size_t TAILLE_MAX_BLOC = 512;
+	static const std::size_t NB_MAX_INSCRITS = 99999999;
+
+	GenerateurInscrits(std::uint64_t p_germe, double p_proportionCandidats = 0.0, double p_proportionInvalides = 0.0);
+
+	/* Objets du modèle, toujours valides */
+
+	std::string reqNas(std::size_t p_indice) const;
+	Electeur reqElecteur(std::size_t p_indice) const;
+	Candidat reqCandidat(std::size_t p_indice, PartisPolitiques p_parti) const;
+	Candidat reqDepute() const;
+	void inscrireElecteurs(Circonscription& p_circonscription, std::size_t p_premier, std::size_t p_dernier) const;
+
+	/* Texte au format de fichier */
+
+	std::size_t ecrireBloc(std::size_t p_indice, char* p_tampon) const;
+	void ecrireFichier(std::ostream& p_os, const std::string& p_nomCirconscription, std::size_t p_nbInscrits) const;
+
+private:
+
+	struct Tirage;
+
+	Tirage tirer(std::size_t p_indice) const;
+	std::uint32_t corpsNas(std::size_t p_indice) const;
+
+	std::uint64_t m_germe;
+	std::uint64_t m_seuilCandidats;
+	std::uint64_t m_seuilInvalides;
+};
+
+} // namespace elections
+
+#endif /* GENERATEURINSCRITS_H_ */
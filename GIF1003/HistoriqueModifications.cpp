@@ -0,0 +1,282 @@
+/****************************************************************************//**
+ * \file HistoriqueModifications.cpp
+ *
+ * \brief Implantation de la classe HistoriqueModifications
+ *
+ *  Created on: 2020-12-28
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "HistoriqueModifications.h"
+#include "ContratException.h"
+#include "JournalCirconscription.h"
+#include "validationFormat.h"
+#include "VisiteurPersonne.h"
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Constructeur: historique vide, sans journal
+ *
+ * \param[in] p_profondeurMax nombre de modifications retenues
+ *
+ * \pre p_profondeurMax > 0
+ *//****************************************************************************/
+
+HistoriqueModifications::HistoriqueModifications(std::size_t p_profondeurMax)
+: m_profondeurMax(p_profondeurMax), m_modifications(), m_nbAppliquees(0), m_journal(nullptr)
+{
+	PRECONDITION(p_profondeurMax > 0);
+
+	INVARIANTS();
+}
+
+/****************************************************************************//**
+ * Associe un journal, où seront écrites les modifications suivantes
+ *
+ * \param[in] p_journal le journal, qui doit survivre à son association;
+ * nullptr pour ne plus journaliser
+ *//****************************************************************************/
+
+void HistoriqueModifications::asgJournal(JournalCirconscription* p_journal)
+{
+	m_journal = p_journal;
+}
+
+/****************************************************************************//**
+ * Inscrit une personne et retient l'inscription
+ *
+ * \return PERSONNE_INVALIDE ou PERSONNE_DEJA_PRESENTE si l'inscription est
+ * refusée; l'historique est alors inchangé
+ *
+ * \exception JournalException si le journal ne peut être écrit
+ *//****************************************************************************/
+
+util::Resultat<void> HistoriqueModifications::inscrire(Circonscription& p_circonscription, const Personne& p_personne)
+{
+	if (!validerPersonne(p_personne))
+		return util::PERSONNE_INVALIDE;
+
+	return ajouter(p_circonscription, Modification{nullptr, std::shared_ptr<const Personne>(p_personne.clone())});
+}
+
+/****************************************************************************//**
+ * Désinscrit une personne et retient la désinscription
+ *
+ * \return NAS_INVALIDE ou PERSONNE_ABSENTE si la désinscription est refusée
+ *
+ * \exception JournalException si le journal ne peut être écrit
+ *//****************************************************************************/
+
+util::Resultat<void> HistoriqueModifications::desinscrire(Circonscription& p_circonscription, const std::string& p_nas)
+{
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE;
+
+	const Personne* inscrit = p_circonscription.reqInscrit(p_nas);
+	if (!inscrit)
+		return util::PERSONNE_ABSENTE;
+
+	return ajouter(p_circonscription, Modification{std::shared_ptr<const Personne>(inscrit->clone()), nullptr});
+}
+
+/****************************************************************************//**
+ * Change l'adresse d'un inscrit et retient le changement
+ *
+ * \param[in] p_nas le NAS de l'inscrit
+ * \param[in] p_adresse sa nouvelle adresse
+ *
+ * \return NAS_INVALIDE, ADRESSE_INVALIDE ou PERSONNE_ABSENTE si le changement
+ * est refusé
+ *
+ * \exception JournalException si le journal ne peut être écrit
+ *//****************************************************************************/
+
+util::Resultat<void> HistoriqueModifications::changerAdresse(Circonscription& p_circonscription, const std::string& p_nas,
+                                                             const util::Adresse& p_adresse)
+{
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE;
+	if (!p_adresse.validerAdresse())
+		return util::ADRESSE_INVALIDE;
+
+	const Personne* inscrit = p_circonscription.reqInscrit(p_nas);
+	if (!inscrit)
+		return util::PERSONNE_ABSENTE;
+
+	std::shared_ptr<Personne> demenage(inscrit->clone());
+	demenage->asgAdresse(p_adresse);
+	return ajouter(p_circonscription, Modification{std::shared_ptr<const Personne>(inscrit->clone()), demenage});
+}
+
+bool HistoriqueModifications::peutAnnuler() const
+{
+	return m_nbAppliquees > 0;
+}
+
+bool HistoriqueModifications::peutRetablir() const
+{
+	return m_nbAppliquees < m_modifications.size();
+}
+
+/****************************************************************************//**
+ * \return le type de la modification que annuler() défera
+ *
+ * \pre peutAnnuler()
+ *//****************************************************************************/
+
+HistoriqueModifications::TypeModification HistoriqueModifications::reqTypeAnnulation() const
+{
+	PRECONDITION(peutAnnuler());
+
+	return reqType(m_modifications[m_nbAppliquees - 1]);
+}
+
+/****************************************************************************//**
+ * \return le type de la modification que retablir() refera
+ *
+ * \pre peutRetablir()
+ *//****************************************************************************/
+
+HistoriqueModifications::TypeModification HistoriqueModifications::reqTypeRetablissement() const
+{
+	PRECONDITION(peutRetablir());
+
+	return reqType(m_modifications[m_nbAppliquees]);
+}
+
+/****************************************************************************//**
+ * \return le nombre de modifications retenues, annulées ou non
+ *//****************************************************************************/
+
+std::size_t HistoriqueModifications::reqNbModifications() const
+{
+	return m_modifications.size();
+}
+
+/****************************************************************************//**
+ * Défait la dernière modification appliquée
+ *
+ * \pre peutAnnuler()
+ *
+ * \return le code d'erreur de la liste si la circonscription a été modifiée
+ * hors de l'historique; la modification reste alors à annuler
+ *
+ * \exception JournalException si le journal ne peut être écrit
+ *//****************************************************************************/
+
+util::Resultat<void> HistoriqueModifications::annuler(Circonscription& p_circonscription)
+{
+	PRECONDITION(peutAnnuler());
+
+	const Modification& modification = m_modifications[m_nbAppliquees - 1];
+	util::Resultat<void> resultat = appliquer(p_circonscription, modification.apres.get(), modification.avant.get());
+	if (resultat)
+		--m_nbAppliquees;
+
+	INVARIANTS();
+	return resultat;
+}
+
+/****************************************************************************//**
+ * Refait la dernière modification annulée
+ *
+ * \pre peutRetablir()
+ *
+ * \return le code d'erreur de la liste si la circonscription a été modifiée
+ * hors de l'historique; la modification reste alors à rétablir
+ *
+ * \exception JournalException si le journal ne peut être écrit
+ *//****************************************************************************/
+
+util::Resultat<void> HistoriqueModifications::retablir(Circonscription& p_circonscription)
+{
+	PRECONDITION(peutRetablir());
+
+	const Modification& modification = m_modifications[m_nbAppliquees];
+	util::Resultat<void> resultat = appliquer(p_circonscription, modification.avant.get(), modification.apres.get());
+	if (resultat)
+		++m_nbAppliquees;
+
+	INVARIANTS();
+	return resultat;
+}
+
+/****************************************************************************//**
+ * Oublie toutes les modifications, par exemple quand une autre
+ * circonscription est chargée
+ *//****************************************************************************/
+
+void HistoriqueModifications::vider()
+{
+	m_modifications.clear();
+	m_nbAppliquees = 0;
+
+	INVARIANTS();
+}
+
+HistoriqueModifications::TypeModification HistoriqueModifications::reqType(const Modification& p_modification)
+{
+	if (!p_modification.avant) return INSCRIPTION;
+	if (!p_modification.apres) return DESINSCRIPTION;
+	return CHANGEMENT_ADRESSE;
+}
+
+/****************************************************************************//**
+ * Fait passer un inscrit de sa version p_avant à sa version p_apres, par le
+ * journal s'il y en a un
+ *
+ * \param[in] p_avant la version dans la liste, nullptr si l'inscrit est absent
+ * \param[in] p_apres la version voulue, nullptr pour le désinscrire
+ *//****************************************************************************/
+
+util::Resultat<void> HistoriqueModifications::appliquer(Circonscription& p_circonscription, const Personne* p_avant,
+                                                        const Personne* p_apres)
+{
+	if (p_avant and p_apres)
+	{
+		if (m_journal) return m_journal->remplacer(p_circonscription, *p_apres);
+		return p_circonscription.remplacer(*p_apres);
+	}
+	if (p_apres)
+	{
+		if (m_journal) return m_journal->inscrire(p_circonscription, *p_apres);
+		return p_circonscription.tenterInscrire(*p_apres, util::DEJA_VALIDE);
+	}
+	if (m_journal) return m_journal->desinscrire(p_circonscription, p_avant->reqNas());
+	return p_circonscription.tenterDesinscrire(p_avant->reqNas());
+}
+
+/****************************************************************************//**
+ * Applique une nouvelle modification et l'empile, à la place des
+ * modifications annulées
+ *//****************************************************************************/
+
+util::Resultat<void> HistoriqueModifications::ajouter(Circonscription& p_circonscription, const Modification& p_modification)
+{
+	util::Resultat<void> resultat = appliquer(p_circonscription, p_modification.avant.get(), p_modification.apres.get());
+	if (!resultat)
+		return resultat;
+
+	m_modifications.resize(m_nbAppliquees);
+	m_modifications.push_back(p_modification);
+	if (m_modifications.size() > m_profondeurMax)
+		m_modifications.pop_front();
+	m_nbAppliquees = m_modifications.size();
+
+	INVARIANTS();
+	return resultat;
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS()
+ *//****************************************************************************/
+
+void HistoriqueModifications::verifieInvariant() const
+{
+	INVARIANT(m_profondeurMax > 0 and m_modifications.size() <= m_profondeurMax);
+	INVARIANT(m_nbAppliquees <= m_modifications.size());
+}
+
+} // namespace elections
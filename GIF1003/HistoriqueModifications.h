@@ -0,0 +1,110 @@
+/**
+ * \file HistoriqueModifications.h
+ *
+ * \brief Déclaration de la classe HistoriqueModifications, qui permet
+ * d'annuler et de rétablir les modifications d'une liste électorale.
+ *
+ *  Created on: 2020-12-28
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef HISTORIQUEMODIFICATIONS_H_
+#define HISTORIQUEMODIFICATIONS_H_
+
+#include "Adresse.h"
+#include "Circonscription.h"
+#include "Personne.h"
+#include "Resultat.h"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace elections
+{
+
+class JournalCirconscription;
+
+/****************************************************************************//**
+ * \class HistoriqueModifications
+ *
+ * Pile d'annulation des inscriptions, désinscriptions et changements
+ * d'adresse d'une circonscription.  Chaque modification est retenue par
+ * l'inscrit avant et après elle: une inscription n'a pas d'« avant », une
+ * désinscription pas d'« après ».  Annuler applique la modification à
+ * rebours, rétablir l'applique de nouveau.  L'historique ne coûte donc qu'un
+ * inscrit par modification, quelle que soit la taille de la liste, et un pas
+ * d'annulation est une seule opération sur la liste, en temps constant.
+ *
+ * Une nouvelle modification efface les modifications annulées.  Au-delà de la
+ * profondeur maximale, les plus anciennes sont oubliées.
+ *
+ * Si un journal est associé, chaque modification, annulation ou
+ * rétablissement y est écrit avant d'être appliqué.  La circonscription ne
+ * doit être modifiée que par l'historique tant qu'il n'est pas vidé.
+ *
+ *//*****************************************************************************/
+
+class HistoriqueModifications
+{
+public:
+
+	enum TypeModification
+	{
+		INSCRIPTION, DESINSCRIPTION, CHANGEMENT_ADRESSE
+	};
+
+	static const std::size_t PROFONDEUR_MAX_DEFAUT = 1000;
+
+	explicit HistoriqueModifications(std::size_t p_profondeurMax = PROFONDEUR_MAX_DEFAUT);
+
+	void asgJournal(JournalCirconscription* p_journal);
+
+	/* Modifications */
+
+	util::Resultat<void> inscrire(Circonscription& p_circonscription, const Personne& p_personne);
+	util::Resultat<void> desinscrire(Circonscription& p_circonscription, const std::string& p_nas);
+	util::Resultat<void> changerAdresse(Circonscription& p_circonscription, const std::string& p_nas,
+	                                    const util::Adresse& p_adresse);
+
+	/* Annulation */
+
+	bool peutAnnuler() const;
+	bool peutRetablir() const;
+	TypeModification reqTypeAnnulation() const;
+	TypeModification reqTypeRetablissement() const;
+	std::size_t reqNbModifications() const;
+
+	util::Resultat<void> annuler(Circonscription& p_circonscription);
+	util::Resultat<void> retablir(Circonscription& p_circonscription);
+	void vider();
+
+private:
+
+	/**
+	 * Un inscrit avant et après une modification; nullptr s'il était absent
+	 */
+
+	struct Modification
+	{
+		std::shared_ptr<const Personne> avant;
+		std::shared_ptr<const Personne> apres;
+	};
+
+	static TypeModification reqType(const Modification& p_modification);
+
+	util::Resultat<void> appliquer(Circonscription& p_circonscription, const Personne* p_avant, const Personne* p_apres);
+	util::Resultat<void> ajouter(Circonscription& p_circonscription, const Modification& p_modification);
+	void verifieInvariant() const;
+
+	std::size_t                m_profondeurMax;
+	std::deque<Modification>   m_modifications;
+	std::size_t                m_nbAppliquees;
+	JournalCirconscription*    m_journal;
+};
+
+} // namespace elections
+
+#endif /* HISTORIQUEMODIFICATIONS_H_ */
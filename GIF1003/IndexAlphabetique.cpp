@@ -0,0 +1,383 @@
+/****************************************************************************//**
+ * \file IndexAlphabetique.cpp
+ *
+ * \brief Implantation de la classe IndexAlphabetique et des clés de collation
+ *
+ *  Created on: 2020-12-24
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "IndexAlphabetique.h"
+#include "BassinDeTaches.h"
+#include "ContratException.h"
+#include "validationFormat.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <future>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Poids de collation.  Chaque niveau n'utilise que des octets supérieurs à 1:
+ * 0 sépare le nom du prénom, 1 sépare deux niveaux.
+ *//****************************************************************************/
+
+static const unsigned char SANS_ACCENT = 2;
+static const unsigned char AIGU        = 3;
+static const unsigned char GRAVE       = 4;
+static const unsigned char CIRCONFLEXE = 5;
+static const unsigned char ROND        = 6;
+static const unsigned char TREMA       = 7;
+static const unsigned char TILDE       = 8;
+static const unsigned char CEDILLE     = 9;
+static const unsigned char BARRE       = 10;
+
+static const unsigned char MINUSCULE   = 2;
+static const unsigned char MAJUSCULE   = 3;
+static const unsigned char LIGATURE    = 2;
+static const unsigned char ESPACE      = 6;
+static const unsigned char APOSTROPHE  = 7;
+static const unsigned char TRAIT_UNION = 8;
+static const unsigned char AUTRE_SIGNE = 9;
+
+static const unsigned char PREMIER_CHIFFRE = 0x10;
+static const unsigned char PREMIERE_LETTRE = 0x20;
+
+/****************************************************************************//**
+ * Lettres U+00C0 à U+00FF, encodées en UTF-8 par 0xC3 suivi de 0x80 à 0xBF:
+ * la ou les deux lettres de base, et l'accent.  Une base nulle désigne un
+ * signe qui n'est pas une lettre.
+ *//****************************************************************************/
+
+struct LettreAccentuee
+{
+	char          base;
+	char          seconde;
+	unsigned char accent;
+};
+
+static const LettreAccentuee LETTRES_ACCENTUEES[64] =
+{
+	{'A', 0, GRAVE}, {'A', 0, AIGU}, {'A', 0, CIRCONFLEXE}, {'A', 0, TILDE},
+	{'A', 0, TREMA}, {'A', 0, ROND}, {'A', 'E', SANS_ACCENT}, {'C', 0, CEDILLE},
+	{'E', 0, GRAVE}, {'E', 0, AIGU}, {'E', 0, CIRCONFLEXE}, {'E', 0, TREMA},
+	{'I', 0, GRAVE}, {'I', 0, AIGU}, {'I', 0, CIRCONFLEXE}, {'I', 0, TREMA},
+	{'D', 0, BARRE}, {'N', 0, TILDE}, {'O', 0, GRAVE}, {'O', 0, AIGU},
+	{'O', 0, CIRCONFLEXE}, {'O', 0, TILDE}, {'O', 0, TREMA}, {0, 0, 0},
+	{'O', 0, BARRE}, {'U', 0, GRAVE}, {'U', 0, AIGU}, {'U', 0, CIRCONFLEXE},
+	{'U', 0, TREMA}, {'Y', 0, AIGU}, {'T', 'H', SANS_ACCENT}, {'S', 'S', SANS_ACCENT},
+	{'A', 0, GRAVE}, {'A', 0, AIGU}, {'A', 0, CIRCONFLEXE}, {'A', 0, TILDE},
+	{'A', 0, TREMA}, {'A', 0, ROND}, {'A', 'E', SANS_ACCENT}, {'C', 0, CEDILLE},
+	{'E', 0, GRAVE}, {'E', 0, AIGU}, {'E', 0, CIRCONFLEXE}, {'E', 0, TREMA},
+	{'I', 0, GRAVE}, {'I', 0, AIGU}, {'I', 0, CIRCONFLEXE}, {'I', 0, TREMA},
+	{'D', 0, BARRE}, {'N', 0, TILDE}, {'O', 0, GRAVE}, {'O', 0, AIGU},
+	{'O', 0, CIRCONFLEXE}, {'O', 0, TILDE}, {'O', 0, TREMA}, {0, 0, 0},
+	{'O', 0, BARRE}, {'U', 0, GRAVE}, {'U', 0, AIGU}, {'U', 0, CIRCONFLEXE},
+	{'U', 0, TREMA}, {'Y', 0, AIGU}, {'T', 'H', SANS_ACCENT}, {'Y', 0, TREMA}
+};
+
+/****************************************************************************//**
+ * Les trois niveaux de poids d'un texte.  Le niveau secondaire a exactement un
+ * poids par poids primaire: à lettres de base égales, les accents se comparent
+ * position par position, dans un sens ou dans l'autre.
+ *//****************************************************************************/
+
+struct PoidsCollation
+{
+	std::string primaire;
+	std::string secondaire;
+	std::string tertiaire;
+
+	void ajouter(unsigned char p_primaire, unsigned char p_secondaire, unsigned char p_tertiaire)
+	{
+		primaire += static_cast<char>(p_primaire);
+		secondaire += static_cast<char>(p_secondaire);
+		tertiaire += static_cast<char>(p_tertiaire);
+	}
+
+	void ajouterLettre(char p_base, unsigned char p_accent, unsigned char p_casse)
+	{
+		ajouter(static_cast<unsigned char>(PREMIERE_LETTRE + (p_base - 'A')), p_accent, p_casse);
+	}
+};
+
+/****************************************************************************//**
+ * Calcule les poids d'un texte en UTF-8.  Les espaces, apostrophes et traits
+ * d'union n'ont qu'un poids tertiaire; les caractères hors du latin-1 sont
+ * rangés après les lettres, dans l'ordre de leurs octets.
+ *//****************************************************************************/
+
+static PoidsCollation calculerPoids(const std::string& p_texte)
+{
+	PoidsCollation poids;
+	poids.primaire.reserve(p_texte.size());
+	poids.secondaire.reserve(p_texte.size());
+	poids.tertiaire.reserve(p_texte.size());
+
+	for (std::string::size_type i = 0; i < p_texte.size(); ++i)
+	{
+		unsigned char c = static_cast<unsigned char>(p_texte[i]);
+		unsigned char suite = i + 1 < p_texte.size() ? static_cast<unsigned char>(p_texte[i + 1]) : 0;
+
+		if (c >= 'a' and c <= 'z')
+			poids.ajouterLettre(static_cast<char>(c - 'a' + 'A'), SANS_ACCENT, MINUSCULE);
+		else if (c >= 'A' and c <= 'Z')
+			poids.ajouterLettre(static_cast<char>(c), SANS_ACCENT, MAJUSCULE);
+		else if (c >= '0' and c <= '9')
+			poids.ajouter(static_cast<unsigned char>(PREMIER_CHIFFRE + (c - '0')), SANS_ACCENT, MINUSCULE);
+		else if (c == 0xC3 and suite >= 0x80 and suite <= 0xBF)
+		{
+			const LettreAccentuee& lettre = LETTRES_ACCENTUEES[suite - 0x80];
+			unsigned char casse = suite < 0xA0 and suite != 0x9F ? MAJUSCULE : MINUSCULE;
+			++i;
+			if (!lettre.base)
+				poids.tertiaire += static_cast<char>(AUTRE_SIGNE);
+			else if (!lettre.seconde)
+				poids.ajouterLettre(lettre.base, lettre.accent, casse);
+			else
+			{
+				poids.ajouterLettre(lettre.base, lettre.accent, casse + LIGATURE);
+				poids.ajouterLettre(lettre.seconde, lettre.accent, casse + LIGATURE);
+			}
+		}
+		else if (c == 0xC5 and (suite == 0x92 or suite == 0x93))
+		{
+			unsigned char casse = suite == 0x92 ? MAJUSCULE : MINUSCULE;
+			++i;
+			poids.ajouterLettre('O', SANS_ACCENT, casse + LIGATURE);
+			poids.ajouterLettre('E', SANS_ACCENT, casse + LIGATURE);
+		}
+		else if (c == 0xE2 and p_texte.compare(i, 3, "\xE2\x80\x99") == 0)
+		{
+			i += 2;
+			poids.tertiaire += static_cast<char>(APOSTROPHE);
+		}
+		else if (c == ' ')
+			poids.tertiaire += static_cast<char>(ESPACE);
+		else if (c == '\'')
+			poids.tertiaire += static_cast<char>(APOSTROPHE);
+		else if (c == '-')
+			poids.tertiaire += static_cast<char>(TRAIT_UNION);
+		else if (c < 0x80)
+			poids.tertiaire += static_cast<char>(AUTRE_SIGNE);
+		else
+			poids.ajouter(c, SANS_ACCENT, MINUSCULE);
+	}
+	std::reverse(poids.secondaire.begin(), poids.secondaire.end());
+	return poids;
+}
+
+/****************************************************************************//**
+ * Clé de collation française d'un texte: deux clés se comparent par memcmp
+ * (ou std::string::compare) dans l'ordre alphabétique français
+ *
+ * \param[in] p_texte un texte en UTF-8
+ *
+ * \return les poids primaires, secondaires puis tertiaires, séparés par 1
+ *//****************************************************************************/
+
+std::string cleCollation(const std::string& p_texte)
+{
+	PoidsCollation poids = calculerPoids(p_texte);
+
+	return poids.primaire + '\x01' + poids.secondaire + '\x01' + poids.tertiaire;
+}
+
+/****************************************************************************//**
+ * Clé d'un inscrit dans l'index alphabétique.  Chaque niveau compare le nom,
+ * puis le prénom: « Émond, Alain » précède « Emond, Zoé ».  Le NAS termine la
+ * clé, qui est unique dans une circonscription.
+ *//****************************************************************************/
+
+std::string cleAlphabetique(const Personne& p_personne)
+{
+	PoidsCollation nom = calculerPoids(p_personne.reqNom());
+	PoidsCollation prenom = calculerPoids(p_personne.reqPrenom());
+	std::uint32_t nas = util::compacterNas(p_personne.reqNas());
+	std::string cle;
+
+	cle.reserve(2 * (nom.primaire.size() + prenom.primaire.size()) + nom.tertiaire.size() + prenom.tertiaire.size() + 10);
+	cle.append(nom.primaire).append(1, '\0').append(prenom.primaire).append(1, '\x01');
+	cle.append(nom.secondaire).append(1, '\0').append(prenom.secondaire).append(1, '\x01');
+	cle.append(nom.tertiaire).append(1, '\0').append(prenom.tertiaire).append(1, '\x01');
+	for (int decalage = 24; decalage >= 0; decalage -= 8)
+		cle += static_cast<char>((nas >> decalage) & 0xFF);
+	return cle;
+}
+
+/****************************************************************************//**
+ * Constructeur par défaut: un index vide
+ *//****************************************************************************/
+
+IndexAlphabetique::IndexAlphabetique() : m_entrees()
+{
+}
+
+/****************************************************************************//**
+ * Remplace le contenu de l'index par les inscrits d'un intervalle.
+ *
+ * Les clés sont calculées et triées par tranches, une par fil du bassin, puis
+ * les tranches sont fusionnées deux à deux.  L'arbre est enfin rempli dans
+ * l'ordre, en temps constant par inscrit.
+ *
+ * \param[in] p_debut, p_fin les inscrits, de NAS distincts
+ * \param[in] p_bassin le bassin qui calcule les tranches; nullptr pour tout
+ * faire dans le fil appelant
+ *//****************************************************************************/
+
+void IndexAlphabetique::construire(std::vector<Personne*>::const_iterator p_debut, std::vector<Personne*>::const_iterator p_fin,
+                                   util::BassinDeTaches* p_bassin)
+{
+	typedef std::pair<std::string, const Personne*> Entree_t;
+
+	const std::size_t nbInscrits = static_cast<std::size_t>(p_fin - p_debut);
+	const std::size_t nbTranches = p_bassin ? std::max<std::size_t>(1, p_bassin->reqNbFils()) : 1;
+	const std::size_t taille = std::max<std::size_t>(1, (nbInscrits + nbTranches - 1) / nbTranches);
+	std::vector<Entree_t> entrees(nbInscrits);
+	std::vector<std::size_t> bornes;
+
+	auto parCle = [](const Entree_t& a, const Entree_t& b) { return a.first < b.first; };
+	auto executer = [p_bassin](std::vector<std::function<void()>>& p_taches)
+	{
+		std::vector<std::future<void>> futurs;
+		for (std::function<void()>& tache: p_taches)
+		{
+			if (p_bassin) futurs.push_back(p_bassin->soumettre(tache));
+			else tache();
+		}
+		util::attendreToutes(futurs);
+		for (std::future<void>& futur: futurs) futur.get();
+		p_taches.clear();
+	};
+
+	for (std::size_t debut = 0; debut < nbInscrits; debut += taille) bornes.push_back(debut);
+	bornes.push_back(nbInscrits);
+
+	std::vector<std::function<void()>> taches;
+	for (std::size_t t = 0; t + 1 < bornes.size(); ++t)
+	{
+		taches.push_back([&entrees, &parCle, p_debut, debut = bornes[t], fin = bornes[t + 1]]()
+		{
+			for (std::size_t i = debut; i < fin; ++i)
+				entrees[i] = Entree_t(cleAlphabetique(*p_debut[i]), p_debut[i]);
+			std::sort(entrees.begin() + debut, entrees.begin() + fin, parCle);
+		});
+	}
+	executer(taches);
+
+	while (bornes.size() > 2)
+	{
+		std::vector<std::size_t> fusionnees;
+		for (std::size_t t = 0; t < bornes.size() - 1; t += 2)
+		{
+			fusionnees.push_back(bornes[t]);
+			if (t + 2 >= bornes.size()) continue;
+			taches.push_back([&entrees, &parCle, debut = bornes[t], milieu = bornes[t + 1], fin = bornes[t + 2]]()
+			{
+				std::inplace_merge(entrees.begin() + debut, entrees.begin() + milieu, entrees.begin() + fin, parCle);
+			});
+		}
+		fusionnees.push_back(nbInscrits);
+		executer(taches);
+		bornes.swap(fusionnees);
+	}
+
+	m_entrees.clear();
+	for (Entree_t& entree: entrees)
+		m_entrees.emplace_hint(m_entrees.end(), std::move(entree.first), entree.second);
+
+	POSTCONDITION(m_entrees.size() == nbInscrits);
+}
+
+/****************************************************************************//**
+ * Ajoute un inscrit à l'index
+ *
+ * \pre aucun inscrit de l'index n'a le même NAS
+ *//****************************************************************************/
+
+void IndexAlphabetique::inserer(const Personne& p_personne)
+{
+	bool insere = m_entrees.emplace(cleAlphabetique(p_personne), &p_personne).second;
+
+	PRECONDITION(insere);
+}
+
+/****************************************************************************//**
+ * Retire un inscrit de l'index.  Sa clé est recalculée: le nom, le prénom et
+ * le NAS ne doivent pas avoir changé depuis son insertion.
+ *
+ * \return false si l'inscrit n'était pas dans l'index
+ *//****************************************************************************/
+
+bool IndexAlphabetique::retirer(const Personne& p_personne)
+{
+	return m_entrees.erase(cleAlphabetique(p_personne)) == 1;
+}
+
+/****************************************************************************//**
+ * Remplace un inscrit par sa nouvelle version.  Si l'ajout de la nouvelle
+ * clé échoue, l'index est inchangé; à clé égale, rien n'est alloué.
+ *
+ * \pre p_ancien est dans l'index, avec la clé de son insertion
+ * \pre aucun autre inscrit de l'index n'a le NAS de p_nouveau
+ *//****************************************************************************/
+
+void IndexAlphabetique::remplacer(const Personne& p_ancien, const Personne& p_nouveau)
+{
+	std::map<std::string, const Personne*>::iterator ancienne = m_entrees.find(cleAlphabetique(p_ancien));
+	std::string cle = cleAlphabetique(p_nouveau);
+
+	PRECONDITION(ancienne != m_entrees.end());
+
+	if (cle == ancienne->first)
+	{
+		ancienne->second = &p_nouveau;
+		return;
+	}
+	bool insere = m_entrees.emplace(std::move(cle), &p_nouveau).second;
+
+	PRECONDITION(insere);
+
+	m_entrees.erase(ancienne);
+}
+
+std::size_t IndexAlphabetique::reqNbInscrits() const
+{
+	return m_entrees.size();
+}
+
+/****************************************************************************//**
+ * \return le premier inscrit dans l'ordre alphabétique; l'inscrit est
+ * Iterateur_t::second
+ *//****************************************************************************/
+
+IndexAlphabetique::Iterateur_t IndexAlphabetique::reqDebut() const
+{
+	return m_entrees.begin();
+}
+
+IndexAlphabetique::Iterateur_t IndexAlphabetique::reqFin() const
+{
+	return m_entrees.end();
+}
+
+/****************************************************************************//**
+ * Les inscrits d'un nom, sans égard aux accents, à la casse ni aux traits
+ * d'union: « EMOND » trouve « Émond » et « Emond », rangés par prénom.
+ *
+ * \param[in] p_nom le nom cherché
+ *
+ * \return l'intervalle des inscrits de ce nom, vide s'il n'y en a pas
+ *//****************************************************************************/
+
+IndexAlphabetique::Intervalle_t IndexAlphabetique::reqInscritsNom(const std::string& p_nom) const
+{
+	std::string primaire = calculerPoids(p_nom).primaire;
+
+	return Intervalle_t(m_entrees.lower_bound(primaire + '\0'), m_entrees.lower_bound(primaire + '\x01'));
+}
+
+} // namespace elections
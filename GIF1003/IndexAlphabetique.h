@@ -0,0 +1,77 @@
+/**
+ * \file IndexAlphabetique.h
+ *
+ * \brief Déclaration de la classe IndexAlphabetique, qui range les inscrits
+ * d'une circonscription par nom et prénom, dans l'ordre alphabétique français.
+ *
+ *  Created on: 2020-12-24
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef INDEXALPHABETIQUE_H_
+#define INDEXALPHABETIQUE_H_
+
+#include "Personne.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+class BassinDeTaches;
+}
+
+namespace elections
+{
+
+std::string cleCollation(const std::string& p_texte);
+std::string cleAlphabetique(const Personne& p_personne);
+
+/****************************************************************************//**
+ * \class IndexAlphabetique
+ *
+ * Les inscrits rangés par nom, puis par prénom, puis par NAS.
+ *
+ * La clé de chaque inscrit est calculée une fois, à l'insertion, et comparée
+ * par memcmp: les lettres de base d'abord, sans égard aux accents, à la casse
+ * ni aux traits d'union; puis les accents, lus de la fin du mot comme en
+ * français canadien; puis la casse et la ponctuation.  « Émond » suit donc
+ * « Emond » et précède « Emonet ».
+ *
+ * L'index ne possède pas les inscrits: il désigne ceux d'une Circonscription,
+ * qui le tient à jour.
+ *
+ *//*****************************************************************************/
+
+class IndexAlphabetique
+{
+public:
+
+	typedef std::map<std::string, const Personne*>::const_iterator Iterateur_t;
+	typedef std::pair<Iterateur_t, Iterateur_t>                    Intervalle_t;
+
+	IndexAlphabetique();
+
+	void construire(std::vector<Personne*>::const_iterator p_debut, std::vector<Personne*>::const_iterator p_fin,
+	                util::BassinDeTaches* p_bassin = nullptr);
+	void inserer(const Personne& p_personne);
+	bool retirer(const Personne& p_personne);
+	void remplacer(const Personne& p_ancien, const Personne& p_nouveau);
+
+	std::size_t reqNbInscrits() const;
+	Iterateur_t reqDebut() const;
+	Iterateur_t reqFin() const;
+	Intervalle_t reqInscritsNom(const std::string& p_nom) const;
+
+private:
+
+	std::map<std::string, const Personne*> m_entrees;
+};
+
+} // namespace elections
+
+#endif /* INDEXALPHABETIQUE_H_ */
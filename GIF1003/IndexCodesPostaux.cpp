@@ -0,0 +1,169 @@
+/****************************************************************************//**
+ * \file IndexCodesPostaux.cpp
+ *
+ * \brief Implantation de la classe IndexCodesPostaux
+ *
+ *  Created on: 2020-12-22
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "IndexCodesPostaux.h"
+#include "ContratException.h"
+
+#include <algorithm>
+
+using util::CodePostal;
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Range les inscrits par région, puis par code
+ *
+ * \param[in] p_circonscription la circonscription indexée
+ *//****************************************************************************/
+
+IndexCodesPostaux::IndexCodesPostaux(const Circonscription& p_circonscription)
+: m_debuts(CodePostal::NB_REGIONS_TRI + 1, 0), m_codes(), m_inscrits(), m_horsCanada()
+{
+	std::vector<std::uint32_t> codes;
+	codes.reserve(p_circonscription.reqNbInscrits());
+
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		CodePostal code = (*it)->reqAdresse().reqCodePostalCompact();
+		codes.push_back(code.reqValeur());
+		if (code.estValide()) ++m_debuts[code.reqRegionTri() + 1];
+		else m_horsCanada.push_back(*it);
+	}
+	for (std::uint32_t r = 0; r < CodePostal::NB_REGIONS_TRI; ++r) m_debuts[r + 1] += m_debuts[r];
+
+	std::vector<std::pair<std::uint32_t, const Personne*>> places(m_debuts.back());
+	std::vector<std::uint32_t> prochaines(m_debuts.begin(), m_debuts.end() - 1);
+	std::size_t i = 0;
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it, ++i)
+	{
+		if (codes[i] == 0) continue;
+		places[prochaines[(codes[i] - 1) / CodePostal::NB_UNITES]++] = std::make_pair(codes[i], *it);
+	}
+
+	auto parCode = [](const std::pair<std::uint32_t, const Personne*>& a,
+	                  const std::pair<std::uint32_t, const Personne*>& b) { return a.first < b.first; };
+	for (std::uint32_t r = 0; r < CodePostal::NB_REGIONS_TRI; ++r)
+	{
+		if (m_debuts[r + 1] - m_debuts[r] > 1)
+			std::stable_sort(places.begin() + m_debuts[r], places.begin() + m_debuts[r + 1], parCode);
+	}
+
+	m_codes.reserve(places.size());
+	m_inscrits.reserve(places.size());
+	for (const auto& place: places)
+	{
+		m_codes.push_back(place.first);
+		m_inscrits.push_back(place.second);
+	}
+
+	POSTCONDITION(m_inscrits.size() + m_horsCanada.size() == p_circonscription.reqNbInscrits());
+	INVARIANTS();
+}
+
+/****************************************************************************//**
+ * \return le nombre d'inscrits qui ont un code postal canadien
+ *//****************************************************************************/
+
+std::size_t IndexCodesPostaux::reqNbInscrits() const
+{
+	return m_inscrits.size();
+}
+
+/****************************************************************************//**
+ * \param[in] p_region numéro de région, voir CodePostal::reqRegionTri()
+ *
+ * \return les inscrits de la région, ordonnés par code
+ *
+ * \pre p_region < CodePostal::NB_REGIONS_TRI
+ *//****************************************************************************/
+
+IndexCodesPostaux::Intervalle_t IndexCodesPostaux::reqInscritsRegion(std::uint32_t p_region) const
+{
+	PRECONDITION(p_region < CodePostal::NB_REGIONS_TRI);
+
+	return Intervalle_t(m_inscrits.begin() + m_debuts[p_region], m_inscrits.begin() + m_debuts[p_region + 1]);
+}
+
+/****************************************************************************//**
+ * \param[in] p_region les trois premiers caractères d'un code postal, « G8T »
+ *
+ * \return les inscrits de la région, ou ADRESSE_INVALIDE si p_region est mal
+ * formée
+ *//****************************************************************************/
+
+util::Resultat<IndexCodesPostaux::Intervalle_t> IndexCodesPostaux::reqInscritsRegion(const std::string& p_region) const
+{
+	util::Resultat<std::uint32_t> region = CodePostal::analyserRegionTri(p_region);
+	if (!region)
+		return region.reqErreur();
+	return reqInscritsRegion(region.reqValeur());
+}
+
+std::size_t IndexCodesPostaux::reqNbInscritsRegion(std::uint32_t p_region) const
+{
+	PRECONDITION(p_region < CodePostal::NB_REGIONS_TRI);
+
+	return m_debuts[p_region + 1] - m_debuts[p_region];
+}
+
+/****************************************************************************//**
+ * \return les inscrits qui ont ce code postal; un intervalle vide si le code
+ * n'est pas valide
+ *//****************************************************************************/
+
+IndexCodesPostaux::Intervalle_t IndexCodesPostaux::reqInscritsCode(const CodePostal& p_code) const
+{
+	return reqInscritsEntre(p_code, p_code);
+}
+
+/****************************************************************************//**
+ * Les inscrits dont le code est compris entre deux codes, inclusivement: une
+ * section de vote, par exemple, décrite par un intervalle de codes.
+ *
+ * \return un intervalle vide si l'un des codes n'est pas valide ou si
+ * p_dernier précède p_premier
+ *//****************************************************************************/
+
+IndexCodesPostaux::Intervalle_t IndexCodesPostaux::reqInscritsEntre(const CodePostal& p_premier,
+                                                                    const CodePostal& p_dernier) const
+{
+	if (!p_premier.estValide() or !p_dernier.estValide() or p_dernier < p_premier)
+		return Intervalle_t(m_inscrits.end(), m_inscrits.end());
+
+	auto debutRecherche = m_codes.begin() + m_debuts[p_premier.reqRegionTri()];
+	auto finRecherche = m_codes.begin() + m_debuts[p_dernier.reqRegionTri() + 1];
+	auto debut = std::lower_bound(debutRecherche, finRecherche, p_premier.reqValeur());
+	auto fin = std::upper_bound(debut, finRecherche, p_dernier.reqValeur());
+
+	return Intervalle_t(m_inscrits.begin() + (debut - m_codes.begin()), m_inscrits.begin() + (fin - m_codes.begin()));
+}
+
+/****************************************************************************//**
+ * \return les inscrits dont le code postal n'est pas canadien, dans l'ordre de
+ * la liste
+ *//****************************************************************************/
+
+IndexCodesPostaux::Intervalle_t IndexCodesPostaux::reqInscritsHorsCanada() const
+{
+	return Intervalle_t(m_horsCanada.begin(), m_horsCanada.end());
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS()
+ *//****************************************************************************/
+
+void IndexCodesPostaux::verifieInvariant() const
+{
+	INVARIANT(m_debuts.size() == CodePostal::NB_REGIONS_TRI + 1);
+	INVARIANT(m_debuts.back() == m_inscrits.size());
+	INVARIANT(m_codes.size() == m_inscrits.size());
+}
+
+} // namespace elections
@@ -0,0 +1,80 @@
+/**
+ * \file IndexCodesPostaux.h
+ *
+ * \brief Déclaration de la classe IndexCodesPostaux, qui regroupe les inscrits
+ * d'une circonscription par région de tri d'acheminement.
+ *
+ *  Created on: 2020-12-22
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef INDEXCODESPOSTAUX_H_
+#define INDEXCODESPOSTAUX_H_
+
+#include "Circonscription.h"
+#include "CodePostal.h"
+#include "Personne.h"
+#include "Resultat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class IndexCodesPostaux
+ *
+ * Les inscrits d'une circonscription rangés par code postal.
+ *
+ * Les inscrits sont placés par un tri par dénombrement sur la région de tri
+ * (les trois premiers caractères du code), puis triés par code à l'intérieur de
+ * chaque région.  Un tableau de NB_REGIONS_TRI + 1 positions donne le début de
+ * chaque région: « tous les inscrits de G8T » est un intervalle obtenu en temps
+ * constant, parcouru en O(k).  À code égal, l'ordre de la liste est conservé.
+ *
+ * Les inscrits dont le code postal n'est pas canadien sont tenus à part.
+ *
+ * L'index reflète la circonscription au moment de la construction: les
+ * inscriptions ultérieures n'y sont pas, et l'index ne doit pas survivre aux
+ * inscrits qu'il désigne.
+ *
+ *//*****************************************************************************/
+
+class IndexCodesPostaux
+{
+public:
+
+	typedef std::vector<const Personne*>::const_iterator Iterateur_t;
+	typedef std::pair<Iterateur_t, Iterateur_t>         Intervalle_t;
+
+	explicit IndexCodesPostaux(const Circonscription& p_circonscription);
+
+	std::size_t reqNbInscrits() const;
+
+	Intervalle_t reqInscritsRegion(std::uint32_t p_region) const;
+	util::Resultat<Intervalle_t> reqInscritsRegion(const std::string& p_region) const;
+	std::size_t reqNbInscritsRegion(std::uint32_t p_region) const;
+
+	Intervalle_t reqInscritsCode(const util::CodePostal& p_code) const;
+	Intervalle_t reqInscritsEntre(const util::CodePostal& p_premier, const util::CodePostal& p_dernier) const;
+
+	Intervalle_t reqInscritsHorsCanada() const;
+
+private:
+
+	void verifieInvariant() const;
+
+	std::vector<std::uint32_t>     m_debuts;
+	std::vector<std::uint32_t>     m_codes;
+	std::vector<const Personne*>   m_inscrits;
+	std::vector<const Personne*>   m_horsCanada;
+};
+
+} // namespace elections
+
+#endif /* INDEXCODESPOSTAUX_H_ */
@@ -0,0 +1,222 @@
+/**
+ * \file IndexNas.h
+ *
+ * \brief Déclaration du gabarit IndexNas: table de hachage associant un NAS à
+ * une valeur, en temps constant.
+ *
+ * Le NAS est réduit à ses 9 chiffres par util::compacterNas(), ce qui donne une
+ * clé de 32 bits.  Les entrées sont rangées à plat dans un seul vecteur, avec
+ * sondage linéaire: une recherche touche en général une seule ligne de cache,
+ * sans allocation ni comparaison de chaînes.
+ *
+ *  Created on: 2020-12-16
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef INDEXNAS_H_
+#define INDEXNAS_H_
+
+#include "ContratException.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+
+/**
+ * \class IndexNas
+ *
+ * Table à adressage ouvert dont la clé est un NAS compacté.  Deux valeurs de
+ * clé, impossibles pour un NAS de 9 chiffres, marquent les cases vides et les
+ * cases libérées par un retrait.  La table double de taille lorsque les cases
+ * occupées ou libérées dépassent 70 % de sa capacité.
+ */
+
+template <typename T>
+class IndexNas
+{
+public:
+
+	IndexNas() : m_cases(CAPACITE_MIN), m_nbElements(0), m_nbLiberees(0) {}
+
+	/**
+	 * Ajoute une association
+	 *
+	 * \return false, sans rien modifier, si la clé est déjà présente
+	 */
+
+	bool inserer(std::uint32_t p_cle, const T& p_valeur)
+	{
+		PRECONDITION(p_cle < CLE_LIBEREE);
+
+		if (10 * (m_nbElements + m_nbLiberees + 1) > 7 * m_cases.size())
+			redimensionner(2 * m_nbElements + 1 > m_cases.size() / 2 ? 2 * m_cases.size() : m_cases.size());
+
+		std::size_t i = localiser(p_cle);
+		if (m_cases[i].cle == p_cle) return false;
+
+		std::size_t libre = i;
+		for (std::size_t j = depart(p_cle); j != i; j = suivant(j))
+		{
+			if (m_cases[j].cle == CLE_LIBEREE)
+			{
+				libre = j;
+				--m_nbLiberees;
+				break;
+			}
+		}
+		m_cases[libre].cle = p_cle;
+		m_cases[libre].valeur = p_valeur;
+		++m_nbElements;
+		return true;
+	}
+
+	/**
+	 * \return un pointeur à la valeur associée à la clé, nullptr si absente.
+	 * Les clés réservées aux cases vides et libérées, dont
+	 * util::CLE_NAS_INVALIDE, ne sont jamais trouvées.
+	 */
+
+	const T* trouver(std::uint32_t p_cle) const
+	{
+		if (p_cle >= CLE_LIBEREE) return nullptr;
+
+		std::size_t i = localiser(p_cle);
+		return m_cases[i].cle == p_cle ? &m_cases[i].valeur : nullptr;
+	}
+
+	T* trouver(std::uint32_t p_cle)
+	{
+		if (p_cle >= CLE_LIBEREE) return nullptr;
+
+		std::size_t i = localiser(p_cle);
+		return m_cases[i].cle == p_cle ? &m_cases[i].valeur : nullptr;
+	}
+
+	/**
+	 * Retire une association
+	 *
+	 * \return false si la clé était absente
+	 */
+
+	bool retirer(std::uint32_t p_cle)
+	{
+		if (p_cle >= CLE_LIBEREE) return false;
+
+		std::size_t i = localiser(p_cle);
+		if (m_cases[i].cle != p_cle) return false;
+
+		m_cases[i].cle = CLE_LIBEREE;
+		m_cases[i].valeur = T();
+		--m_nbElements;
+		++m_nbLiberees;
+		return true;
+	}
+
+	/**
+	 * Prépare la table à recevoir p_nbElements associations sans redimensionnement
+	 */
+
+	void reserver(std::size_t p_nbElements)
+	{
+		std::size_t capacite = m_cases.size();
+		while (10 * (p_nbElements + 1) > 7 * capacite) capacite *= 2;
+		if (capacite != m_cases.size()) redimensionner(capacite);
+	}
+
+	void vider()
+	{
+		std::vector<Case>(CAPACITE_MIN).swap(m_cases);
+		m_nbElements = 0;
+		m_nbLiberees = 0;
+	}
+
+	std::size_t reqNbElements() const { return m_nbElements; }
+
+	/**
+	 * Applique p_fonction(cle, valeur) à chaque association, dans un ordre
+	 * quelconque
+	 */
+
+	template <typename Fonction>
+	void parcourir(Fonction p_fonction) const
+	{
+		for (const Case& c: m_cases)
+		{
+			if (c.cle < CLE_LIBEREE) p_fonction(c.cle, c.valeur);
+		}
+	}
+
+	friend void swap(IndexNas& lhs, IndexNas& rhs)
+	{
+		using std::swap;
+		swap(lhs.m_cases, rhs.m_cases);
+		swap(lhs.m_nbElements, rhs.m_nbElements);
+		swap(lhs.m_nbLiberees, rhs.m_nbLiberees);
+	}
+
+private:
+
+	static const std::uint32_t CLE_VIDE = 0xFFFFFFFF;
+	static const std::uint32_t CLE_LIBEREE = 0xFFFFFFFE;
+	static const std::size_t CAPACITE_MIN = 16;
+
+	struct Case
+	{
+		Case() : cle(CLE_VIDE), valeur() {}
+
+		std::uint32_t cle;
+		T             valeur;
+	};
+
+	std::size_t depart(std::uint32_t p_cle) const
+	{
+		return static_cast<std::size_t>((p_cle * 0x9E3779B97F4A7C15ULL) >> 32) & (m_cases.size() - 1);
+	}
+
+	std::size_t suivant(std::size_t p_i) const
+	{
+		return (p_i + 1) & (m_cases.size() - 1);
+	}
+
+	/**
+	 * \return la case contenant la clé, ou la première case vide rencontrée
+	 * si la clé est absente
+	 */
+
+	std::size_t localiser(std::uint32_t p_cle) const
+	{
+		std::size_t i = depart(p_cle);
+		while (m_cases[i].cle != p_cle and m_cases[i].cle != CLE_VIDE) i = suivant(i);
+		return i;
+	}
+
+	void redimensionner(std::size_t p_capacite)
+	{
+		std::vector<Case> anciennes(p_capacite);
+		anciennes.swap(m_cases);
+		m_nbLiberees = 0;
+
+		for (Case& c: anciennes)
+		{
+			if (c.cle < CLE_LIBEREE)
+			{
+				std::size_t i = localiser(c.cle);
+				m_cases[i].cle = c.cle;
+				m_cases[i].valeur = std::move(c.valeur);
+			}
+		}
+	}
+
+	std::vector<Case> m_cases;
+	std::size_t       m_nbElements;
+	std::size_t       m_nbLiberees;
+};
+
+} // namespace util
+
+#endif /* INDEXNAS_H_ */
@@ -0,0 +1,241 @@
+/**
+ * \file IndexNasPersistant.h
+ *
+ * \brief Déclaration du gabarit IndexNasPersistant: association persistante
+ * d'un NAS à une valeur, dont les versions partagent leur structure.
+ *
+ * Le NAS compacté par util::compacterNas() tient sur 30 bits.  Il est lu par
+ * tranches de 5 bits, des poids forts aux poids faibles, dans un arbre à 6
+ * niveaux de 32 branches.  Chaque noeud ne garde que ses branches occupées,
+ * repérées par une carte de 32 bits (« hash array mapped trie », dont la clé
+ * est le NAS lui-même, sans hachage ni collision).
+ *
+ *  Created on: 2020-12-27
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef INDEXNASPERSISTANT_H_
+#define INDEXNASPERSISTANT_H_
+
+#include "ContratException.h"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+
+/**
+ * \class IndexNasPersistant
+ *
+ * Les noeuds sont immuables et partagés par std::shared_ptr.  Une copie de
+ * l'index est donc en temps constant, et une modification ne recopie que les
+ * 6 noeuds du chemin de la clé: les copies antérieures restent inchangées et
+ * partagent tout le reste.  Une version peut être lue par plusieurs fils
+ * pendant qu'un autre en dérive de nouvelles.
+ */
+
+template <typename T>
+class IndexNasPersistant
+{
+public:
+
+	static const unsigned int NB_BITS_CLE = 30;
+
+	IndexNasPersistant() : m_racine(), m_nbElements(0) {}
+
+	/**
+	 * \return la valeur associée à la clé, ou nullptr si la clé est absente
+	 */
+
+	const T* trouver(std::uint32_t p_cle) const
+	{
+		PRECONDITION(p_cle < (1u << NB_BITS_CLE));
+
+		const Noeud* noeud = m_racine.get();
+		for (unsigned int niveau = 0; noeud; ++niveau)
+		{
+			unsigned int branche = reqBranche(p_cle, niveau);
+			if (!(noeud->carte & (1u << branche))) return nullptr;
+			std::size_t position = reqPosition(noeud->carte, branche);
+			if (niveau + 1 == NB_NIVEAUX) return &noeud->valeurs[position];
+			noeud = noeud->enfants[position].get();
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Ajoute une association
+	 *
+	 * \return false, sans rien modifier, si la clé est déjà présente
+	 */
+
+	bool inserer(std::uint32_t p_cle, const T& p_valeur)
+	{
+		if (trouver(p_cle)) return false;
+
+		m_racine = avecValeur(m_racine.get(), p_cle, 0, p_valeur);
+		++m_nbElements;
+		return true;
+	}
+
+	/**
+	 * Change la valeur associée à une clé
+	 *
+	 * \return false, sans rien modifier, si la clé est absente
+	 */
+
+	bool remplacer(std::uint32_t p_cle, const T& p_valeur)
+	{
+		if (!trouver(p_cle)) return false;
+
+		m_racine = avecValeur(m_racine.get(), p_cle, 0, p_valeur);
+		return true;
+	}
+
+	/**
+	 * Retire une association
+	 *
+	 * \return false si la clé est absente
+	 */
+
+	bool retirer(std::uint32_t p_cle)
+	{
+		if (!trouver(p_cle)) return false;
+
+		m_racine = sansCle(*m_racine, p_cle, 0);
+		--m_nbElements;
+		return true;
+	}
+
+	std::size_t reqNbElements() const { return m_nbElements; }
+
+	/**
+	 * Applique p_fonction(cle, valeur) à chaque association, par clé croissante
+	 */
+
+	template <typename Fonction>
+	void parcourir(Fonction p_fonction) const
+	{
+		if (m_racine) parcourir(*m_racine, 0, 0, p_fonction);
+	}
+
+	friend void swap(IndexNasPersistant& lhs, IndexNasPersistant& rhs)
+	{
+		using std::swap;
+		swap(lhs.m_racine, rhs.m_racine);
+		swap(lhs.m_nbElements, rhs.m_nbElements);
+	}
+
+private:
+
+	static const unsigned int BITS_PAR_NIVEAU = 5;
+	static const unsigned int NB_NIVEAUX = NB_BITS_CLE / BITS_PAR_NIVEAU;
+
+	/**
+	 * Noeud de l'arbre: les enfants occupés d'un noeud interne, ou les valeurs
+	 * d'une feuille, dans l'ordre des bits de la carte
+	 */
+
+	struct Noeud
+	{
+		std::uint32_t                              carte = 0;
+		std::vector<std::shared_ptr<const Noeud>>  enfants;
+		std::vector<T>                             valeurs;
+	};
+
+	static unsigned int reqBranche(std::uint32_t p_cle, unsigned int p_niveau)
+	{
+		return (p_cle >> (NB_BITS_CLE - BITS_PAR_NIVEAU * (p_niveau + 1))) & ((1u << BITS_PAR_NIVEAU) - 1);
+	}
+
+	/**
+	 * \return le rang d'une branche parmi les branches occupées qui la précèdent
+	 */
+
+	static std::size_t reqPosition(std::uint32_t p_carte, unsigned int p_branche)
+	{
+		return std::bitset<32>(p_carte & ((1u << p_branche) - 1)).count();
+	}
+
+	/**
+	 * \return une copie du noeud où la clé est associée à la valeur; le noeud
+	 * original, éventuellement nul, n'est pas modifié
+	 */
+
+	static std::shared_ptr<const Noeud> avecValeur(const Noeud* p_noeud, std::uint32_t p_cle, unsigned int p_niveau,
+	                                               const T& p_valeur)
+	{
+		std::shared_ptr<Noeud> copie = p_noeud ? std::make_shared<Noeud>(*p_noeud) : std::make_shared<Noeud>();
+		unsigned int branche = reqBranche(p_cle, p_niveau);
+		std::size_t position = reqPosition(copie->carte, branche);
+		bool present = copie->carte & (1u << branche);
+
+		if (p_niveau + 1 == NB_NIVEAUX)
+		{
+			if (present) copie->valeurs[position] = p_valeur;
+			else copie->valeurs.insert(copie->valeurs.begin() + position, p_valeur);
+		}
+		else
+		{
+			std::shared_ptr<const Noeud> enfant =
+				avecValeur(present ? copie->enfants[position].get() : nullptr, p_cle, p_niveau + 1, p_valeur);
+			if (present) copie->enfants[position] = std::move(enfant);
+			else copie->enfants.insert(copie->enfants.begin() + position, std::move(enfant));
+		}
+		copie->carte |= 1u << branche;
+		return copie;
+	}
+
+	/**
+	 * \return une copie du noeud sans la clé, qui y est présente; nullptr si
+	 * la copie serait vide
+	 */
+
+	static std::shared_ptr<const Noeud> sansCle(const Noeud& p_noeud, std::uint32_t p_cle, unsigned int p_niveau)
+	{
+		std::shared_ptr<Noeud> copie = std::make_shared<Noeud>(p_noeud);
+		unsigned int branche = reqBranche(p_cle, p_niveau);
+		std::size_t position = reqPosition(copie->carte, branche);
+		std::shared_ptr<const Noeud> enfant;
+
+		if (p_niveau + 1 < NB_NIVEAUX)
+			enfant = sansCle(*copie->enfants[position], p_cle, p_niveau + 1);
+		if (enfant)
+		{
+			copie->enfants[position] = std::move(enfant);
+			return copie;
+		}
+
+		if (p_niveau + 1 == NB_NIVEAUX) copie->valeurs.erase(copie->valeurs.begin() + position);
+		else copie->enfants.erase(copie->enfants.begin() + position);
+		copie->carte &= ~(1u << branche);
+		return copie->carte ? copie : nullptr;
+	}
+
+	template <typename Fonction>
+	static void parcourir(const Noeud& p_noeud, std::uint32_t p_prefixe, unsigned int p_niveau, Fonction& p_fonction)
+	{
+		std::size_t position = 0;
+		for (unsigned int branche = 0; branche < (1u << BITS_PAR_NIVEAU); ++branche)
+		{
+			if (!(p_noeud.carte & (1u << branche))) continue;
+			std::uint32_t cle = (p_prefixe << BITS_PAR_NIVEAU) | branche;
+			if (p_niveau + 1 == NB_NIVEAUX) p_fonction(cle, p_noeud.valeurs[position]);
+			else parcourir(*p_noeud.enfants[position], cle, p_niveau + 1, p_fonction);
+			++position;
+		}
+	}
+
+	std::shared_ptr<const Noeud>  m_racine;
+	std::size_t                   m_nbElements;
+};
+
+} // namespace util
+
+#endif /* INDEXNASPERSISTANT_H_ */
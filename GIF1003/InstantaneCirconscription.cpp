@@ -0,0 +1,120 @@
+/****************************************************************************//**
+ * \file InstantaneCirconscription.cpp
+ *
+ * \brief Implantation de la classe InstantaneCirconscription
+ *
+ *  Created on: 2020-12-27
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "InstantaneCirconscription.h"
+#include "ContratException.h"
+#include "validationFormat.h"
+#include "VisiteurPersonne.h"
+
+#include <sstream>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Constructeur, appelé par Circonscription::reqInstantane()
+ *
+ * \param[in] p_nom nom de la circonscription
+ * \param[in] p_depute député sortant
+ * \param[in] p_inscrits les versions des inscrits, partagées et non recopiées
+ *
+ * \pre p_nom est un nom valide, p_depute est valide
+ *//****************************************************************************/
+
+InstantaneCirconscription::InstantaneCirconscription(const std::string& p_nom, const Candidat& p_depute,
+                                                     const Inscrits_t& p_inscrits)
+: m_nomCirconscription(p_nom), m_deputeElu(p_depute), m_inscrits(p_inscrits)
+{
+	PRECONDITION(util::estUnNom(p_nom));
+
+	INVARIANTS();
+}
+
+const std::string& InstantaneCirconscription::reqNomCirconscription() const
+{
+	return m_nomCirconscription;
+}
+
+const Candidat& InstantaneCirconscription::reqDeputeElu() const
+{
+	return m_deputeElu;
+}
+
+std::size_t InstantaneCirconscription::reqNbInscrits() const
+{
+	return m_inscrits.reqNbElements();
+}
+
+/****************************************************************************//**
+ * Recherche un inscrit par son NAS, en temps constant
+ *
+ * \return l'inscrit, valide aussi longtemps que l'instantané; nullptr si
+ * aucun inscrit n'avait ce NAS ou si p_nas n'a pas le format d'un NAS
+ *//****************************************************************************/
+
+const Personne* InstantaneCirconscription::reqInscrit(const std::string& p_nas) const
+{
+	std::uint32_t cle = util::compacterNas(p_nas);
+	if (cle == util::CLE_NAS_INVALIDE)
+		return nullptr;
+
+	const std::shared_ptr<const Personne>* inscrit = m_inscrits.trouver(cle);
+	return inscrit ? inscrit->get() : nullptr;
+}
+
+/****************************************************************************//**
+ * Copie modifiable de l'instantané, où les inscrits sont rangés par NAS
+ *//****************************************************************************/
+
+Circonscription InstantaneCirconscription::reqCirconscription() const
+{
+	Circonscription copie(m_nomCirconscription, m_deputeElu);
+
+	parcourir([&copie](const Personne& p_inscrit)
+	{
+		util::Resultat<void> resultat = copie.tenterInscrire(p_inscrit, util::DEJA_VALIDE);
+		ASSERTION(resultat.estValide());
+	});
+	return copie;
+}
+
+/****************************************************************************//**
+ * Version imprimable de l'instantané, dans le format de
+ * Circonscription::reqCirconscriptionFormate(), les inscrits par NAS croissant
+ *//****************************************************************************/
+
+std::string InstantaneCirconscription::reqCirconscriptionFormate() const
+{
+	static const char ret = '\n';
+	std::ostringstream os;
+
+	os << "Circonscription: " << m_nomCirconscription << ret;
+	os << "Député sortant: " << ret << m_deputeElu.reqPersonneFormate() << ret << ret;
+	os << "Liste des inscrits: " << ret;
+	if (reqNbInscrits() == 0)
+	{
+		os << "Liste vide";
+	}
+	parcourir([&os](const Personne& p_inscrit)
+	{
+		os << formaterPersonne(p_inscrit) << ret << ret;
+	});
+	return os.str();
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS()
+ *//****************************************************************************/
+
+void InstantaneCirconscription::verifieInvariant() const
+{
+	INVARIANT(util::estUnNom(m_nomCirconscription));
+}
+
+} // namespace elections
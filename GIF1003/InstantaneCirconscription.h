@@ -0,0 +1,85 @@
+/**
+ * \file InstantaneCirconscription.h
+ *
+ * \brief Déclaration de la classe InstantaneCirconscription, vue figée d'une
+ * liste électorale à un moment donné.
+ *
+ *  Created on: 2020-12-27
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef INSTANTANECIRCONSCRIPTION_H_
+#define INSTANTANECIRCONSCRIPTION_H_
+
+#include "Candidat.h"
+#include "Circonscription.h"
+#include "IndexNasPersistant.h"
+#include "Personne.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class InstantaneCirconscription
+ *
+ * La liste électorale d'une circonscription telle qu'elle était quand
+ * Circonscription::reqInstantane() a été appelée.  Les inscrits sont des
+ * versions immuables partagées avec la circonscription et avec les autres
+ * instantanés: prendre un instantané est en temps constant, et chacun ne
+ * coûte que les inscrits modifiés depuis.
+ *
+ * Un instantané ne change plus.  Il peut être lu par plusieurs fils, sans
+ * verrou, pendant que la circonscription continue d'être modifiée, et lui
+ * survivre.  Les inscrits y sont parcourus par NAS croissant.
+ *
+ *//*****************************************************************************/
+
+class InstantaneCirconscription
+{
+public:
+
+	typedef util::IndexNasPersistant<std::shared_ptr<const Personne>> Inscrits_t;
+
+	InstantaneCirconscription(const std::string& p_nom, const Candidat& p_depute, const Inscrits_t& p_inscrits);
+
+	const std::string& reqNomCirconscription() const;
+	const Candidat& reqDeputeElu() const;
+	std::size_t reqNbInscrits() const;
+	const Personne* reqInscrit(const std::string& p_nas) const;
+
+	template <typename Fonction>
+	void parcourir(Fonction p_fonction) const;
+
+	Circonscription reqCirconscription() const;
+	std::string reqCirconscriptionFormate() const;
+
+private:
+
+	void verifieInvariant() const;
+
+	std::string  m_nomCirconscription;
+	Candidat     m_deputeElu;
+	Inscrits_t   m_inscrits;
+};
+
+/**
+ * Applique p_fonction(const Personne&) à chaque inscrit, par NAS croissant
+ */
+
+template <typename Fonction>
+void InstantaneCirconscription::parcourir(Fonction p_fonction) const
+{
+	m_inscrits.parcourir([&p_fonction](std::uint32_t, const std::shared_ptr<const Personne>& p_inscrit)
+	{
+		p_fonction(*p_inscrit);
+	});
+}
+
+} // namespace elections
+
+#endif /* INSTANTANECIRCONSCRIPTION_H_ */
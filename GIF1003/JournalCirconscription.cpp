@@ -0,0 +1,623 @@
+/****************************************************************************//**
+ * \file JournalCirconscription.cpp
+ *
+ * \brief Implantation de la classe JournalCirconscription
+ *
+ *  Created on: 2020-12-20
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "JournalCirconscription.h"
+#include "ContratException.h"
+#include "persistance.h"
+#include "validationFormat.h"
+#include "VisiteurPersonne.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace elections
+{
+
+const std::string JournalCirconscription::EXTENSION_JOURNAL = ".journal";
+
+/****************************************************************************//**
+ * Accès au fichier du journal.  Les flux de la bibliothèque standard ne
+ * permettent pas de forcer l'écriture sur disque: on passe par le descripteur.
+ *//****************************************************************************/
+
+static std::string messageSysteme(const std::string& p_operation, const std::string& p_fichier)
+{
+	return p_operation + " " + p_fichier + ": " + std::strerror(errno);
+}
+
+static int ouvrirEnAjout(const std::string& p_fichier)
+{
+#ifdef _WIN32
+	return _open(p_fichier.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+	return ::open(p_fichier.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+}
+
+static bool ecrireTout(int p_descripteur, const char* p_donnees, std::size_t p_taille)
+{
+	while (p_taille > 0)
+	{
+#ifdef _WIN32
+		int n = _write(p_descripteur, p_donnees, static_cast<unsigned int>(p_taille));
+#else
+		ssize_t n = ::write(p_descripteur, p_donnees, p_taille);
+		if (n < 0 and errno == EINTR) continue;
+#endif
+		if (n <= 0) return false;
+		p_donnees += n;
+		p_taille -= static_cast<std::size_t>(n);
+	}
+	return true;
+}
+
+static bool forcer(int p_descripteur)
+{
+#ifdef _WIN32
+	return _commit(p_descripteur) == 0;
+#elif defined(__linux__)
+	return ::fdatasync(p_descripteur) == 0;
+#else
+	return ::fsync(p_descripteur) == 0;
+#endif
+}
+
+static bool tronquer(int p_descripteur, std::size_t p_taille)
+{
+#ifdef _WIN32
+	return _chsize_s(p_descripteur, static_cast<long long>(p_taille)) == 0;
+#else
+	return ::ftruncate(p_descripteur, static_cast<off_t>(p_taille)) == 0;
+#endif
+}
+
+static void fermer(int p_descripteur)
+{
+#ifdef _WIN32
+	_close(p_descripteur);
+#else
+	::close(p_descripteur);
+#endif
+}
+
+/****************************************************************************//**
+ * Force sur disque un fichier écrit par un flux, ou le répertoire qui le
+ * contient pour rendre durable un renommage.  Sans effet sous Windows pour un
+ * répertoire.
+ *//****************************************************************************/
+
+static bool forcerFichier(const std::string& p_fichier)
+{
+#ifdef _WIN32
+	int descripteur = _open(p_fichier.c_str(), _O_RDWR | _O_BINARY);
+#else
+	int descripteur = ::open(p_fichier.c_str(), O_RDONLY);
+#endif
+	if (descripteur < 0) return false;
+	bool reussi = forcer(descripteur);
+	fermer(descripteur);
+	return reussi;
+}
+
+static bool forcerRepertoire(const std::string& p_fichier)
+{
+#ifdef _WIN32
+	(void) p_fichier;
+	return true;
+#else
+	std::string::size_type separateur = p_fichier.find_last_of('/');
+	std::string repertoire = separateur == std::string::npos ? "." : p_fichier.substr(0, separateur + 1);
+	int descripteur = ::open(repertoire.c_str(), O_RDONLY);
+	if (descripteur < 0) return false;
+	bool reussi = ::fsync(descripteur) == 0;
+	fermer(descripteur);
+	return reussi;
+#endif
+}
+
+/****************************************************************************//**
+ * Remplace un fichier par un autre en une seule opération: la destination est
+ * toujours soit l'ancienne, soit la nouvelle version, jamais absente.  Sous
+ * Windows, rename() refuse une destination existante; MoveFileExW la remplace
+ * et ne rend la main qu'une fois le déplacement écrit sur disque.
+ *
+ * \param[in] p_source le fichier à renommer, dans l'encodage local
+ * \param[in] p_destination le fichier à remplacer, dans l'encodage local
+ *
+ * \return vrai si la destination a été remplacée
+ *//****************************************************************************/
+
+bool remplacerFichier(const std::string& p_source, const std::string& p_destination)
+{
+#ifdef _WIN32
+	std::wstring chemins[2];
+	const std::string* originaux[2] = { &p_source, &p_destination };
+	for (int i = 0; i < 2; ++i)
+	{
+		int taille = MultiByteToWideChar(CP_ACP, 0, originaux[i]->c_str(), -1, nullptr, 0);
+		if (taille <= 0) return false;
+		chemins[i].resize(static_cast<std::size_t>(taille));
+		MultiByteToWideChar(CP_ACP, 0, originaux[i]->c_str(), -1, &chemins[i][0], taille);
+	}
+	return MoveFileExW(chemins[0].c_str(), chemins[1].c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	return std::rename(p_source.c_str(), p_destination.c_str()) == 0;
+#endif
+}
+
+/****************************************************************************//**
+ * Somme de contrôle FNV-1a d'une charge
+ *//****************************************************************************/
+
+static std::uint32_t calculerSomme(const std::string& p_charge)
+{
+	std::uint32_t somme = 2166136261u;
+	for (unsigned char c: p_charge)
+	{
+		somme = (somme ^ c) * 16777619u;
+	}
+	return somme;
+}
+
+/****************************************************************************//**
+ * Découpe le contenu d'un journal en enregistrements.  L'analyse s'arrête au
+ * premier en-tête illisible, à une charge incomplète ou à une somme fausse:
+ * tout ce qui suit provient d'une écriture interrompue.
+ *
+ * \param[in] p_contenu le contenu du fichier
+ * \param[out] p_enregistrements reçoit les paires (type, charge) valides
+ *
+ * \return la longueur de la partie valide du contenu
+ *//****************************************************************************/
+
+static std::size_t analyserJournal(const std::string& p_contenu, std::vector<std::pair<char, std::string>>& p_enregistrements)
+{
+	std::size_t position = 0;
+
+	while (position < p_contenu.size())
+	{
+		std::string::size_type finEnTete = p_contenu.find('\n', position);
+		if (finEnTete == std::string::npos) break;
+
+		std::istringstream entete(p_contenu.substr(position, finEnTete - position));
+		char type = 0;
+		std::size_t longueur = 0;
+		std::uint32_t somme = 0;
+		if (!(entete >> type >> longueur >> std::hex >> somme) or (type != '+' and type != '-' and type != '=')) break;
+		if (longueur > p_contenu.size() - finEnTete - 1) break;
+
+		std::string charge = p_contenu.substr(finEnTete + 1, longueur);
+		if (calculerSomme(charge) != somme) break;
+
+		p_enregistrements.emplace_back(type, std::move(charge));
+		position = finEnTete + 1 + longueur;
+	}
+	return position;
+}
+
+static std::string lireFichier(const std::string& p_fichier)
+{
+	std::ifstream fichier(p_fichier.c_str(), std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(fichier), std::istreambuf_iterator<char>());
+}
+
+/****************************************************************************//**
+ * Constructeur: ouvre le journal d'une sauvegarde, ou le crée, et démarre le
+ * fil d'écriture.  Un enregistrement incomplet laissé en fin de journal par
+ * un arrêt brutal est retiré.
+ *
+ * \param[in] p_fichierSauvegarde le fichier écrit par sauvegarderCirconscription()
+ * \param[in] p_durabilite SYNCHRONE ou DIFFERE
+ * \param[in] p_delai en mode DIFFERE, attente maximale avant le forçage sur disque
+ *
+ * \exception JournalException si le journal ne peut être ouvert ou réparé
+ *//****************************************************************************/
+
+JournalCirconscription::JournalCirconscription(const std::string& p_fichierSauvegarde, Durabilite p_durabilite,
+                                               std::chrono::microseconds p_delai)
+: m_fichierSauvegarde(p_fichierSauvegarde),
+  m_fichierJournal(p_fichierSauvegarde + EXTENSION_JOURNAL),
+  m_durabilite(p_durabilite),
+  m_delai(p_delai),
+  m_descripteur(-1),
+  m_tampon(),
+  m_sequence(0),
+  m_sequenceDurable(0),
+  m_nbEnregistrements(0),
+  m_nbEnAttente(0),
+  m_arret(false),
+  m_erreur()
+{
+	std::string contenu = lireFichier(m_fichierJournal);
+	std::vector<std::pair<char, std::string>> enregistrements;
+	std::size_t longueurValide = analyserJournal(contenu, enregistrements);
+
+	m_descripteur = ouvrirEnAjout(m_fichierJournal);
+	if (m_descripteur < 0)
+		throw JournalException(messageSysteme("impossible d'ouvrir", m_fichierJournal));
+	if (longueurValide < contenu.size() and !(tronquer(m_descripteur, longueurValide) and forcer(m_descripteur)))
+	{
+		std::string message = messageSysteme("impossible de réparer", m_fichierJournal);
+		fermer(m_descripteur);
+		throw JournalException(message);
+	}
+	m_nbEnregistrements = enregistrements.size();
+	m_fil = std::thread(&JournalCirconscription::ecrireEnArrierePlan, this);
+
+	INVARIANTS();
+}
+
+/****************************************************************************//**
+ * Destructeur: force les enregistrements en attente et arrête le fil d'écriture
+ *//****************************************************************************/
+
+JournalCirconscription::~JournalCirconscription()
+{
+	{
+		std::lock_guard<std::mutex> verrou(m_mutex);
+		m_arret = true;
+	}
+	m_travail.notify_one();
+	m_fil.join();
+	fermer(m_descripteur);
+}
+
+/****************************************************************************//**
+ * Inscrit une personne et journalise l'inscription.  Le journal est écrit
+ * avant la circonscription: une inscription refusée n'est pas journalisée.
+ *
+ * \return PERSONNE_INVALIDE ou PERSONNE_DEJA_PRESENTE si l'inscription est refusée
+ *
+ * \exception JournalException si le journal ne peut être écrit; la
+ * circonscription n'est alors pas modifiée
+ *//****************************************************************************/
+
+util::Resultat<void> JournalCirconscription::inscrire(Circonscription& p_circonscription, const Personne& p_personne)
+{
+	if (!validerPersonne(p_personne))
+		return util::PERSONNE_INVALIDE;
+	if (p_circonscription.reqInscrit(p_personne.reqNas()))
+		return util::PERSONNE_DEJA_PRESENTE;
+
+	journaliserInscription(p_personne);
+	return p_circonscription.tenterInscrire(p_personne, util::DEJA_VALIDE);
+}
+
+/****************************************************************************//**
+ * Désinscrit une personne et journalise la désinscription
+ *
+ * \return NAS_INVALIDE ou PERSONNE_ABSENTE si la désinscription est refusée
+ *
+ * \exception JournalException si le journal ne peut être écrit; la
+ * circonscription n'est alors pas modifiée
+ *//****************************************************************************/
+
+util::Resultat<void> JournalCirconscription::desinscrire(Circonscription& p_circonscription, const std::string& p_nas)
+{
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE;
+	if (!p_circonscription.reqInscrit(p_nas))
+		return util::PERSONNE_ABSENTE;
+
+	journaliserDesinscription(p_nas);
+	return p_circonscription.tenterDesinscrire(p_nas);
+}
+
+/****************************************************************************//**
+ * Remplace un inscrit par une nouvelle version de même NAS, par exemple après
+ * un changement d'adresse, et journalise le remplacement
+ *
+ * \return PERSONNE_INVALIDE ou PERSONNE_ABSENTE si le remplacement est refusé
+ *
+ * \exception JournalException si le journal ne peut être écrit; la
+ * circonscription n'est alors pas modifiée
+ *//****************************************************************************/
+
+util::Resultat<void> JournalCirconscription::remplacer(Circonscription& p_circonscription, const Personne& p_personne)
+{
+	if (!validerPersonne(p_personne))
+		return util::PERSONNE_INVALIDE;
+	if (!p_circonscription.reqInscrit(p_personne.reqNas()))
+		return util::PERSONNE_ABSENTE;
+
+	journaliserRemplacement(p_personne);
+	return p_circonscription.remplacer(p_personne);
+}
+
+/****************************************************************************//**
+ * Journalise une inscription faite par l'appelant, par exemple dans une
+ * CirconscriptionConcurrente.  Peut être appelée de plusieurs fils à la fois.
+ *
+ * \exception JournalException si le journal ne peut être écrit
+ *//****************************************************************************/
+
+void JournalCirconscription::journaliserInscription(const Personne& p_personne)
+{
+	std::ostringstream bloc;
+	ecrirePersonne(bloc, p_personne);
+	journaliser('+', bloc.str());
+}
+
+/****************************************************************************//**
+ * Journalise une désinscription faite par l'appelant
+ *
+ * \exception JournalException si le journal ne peut être écrit
+ *//****************************************************************************/
+
+void JournalCirconscription::journaliserDesinscription(const std::string& p_nas)
+{
+	journaliser('-', p_nas + '\n');
+}
+
+/****************************************************************************//**
+ * Journalise le remplacement d'un inscrit fait par l'appelant
+ *
+ * \exception JournalException si le journal ne peut être écrit
+ *//****************************************************************************/
+
+void JournalCirconscription::journaliserRemplacement(const Personne& p_personne)
+{
+	std::ostringstream bloc;
+	ecrirePersonne(bloc, p_personne);
+	journaliser('=', bloc.str());
+}
+
+/****************************************************************************//**
+ * Place un enregistrement dans le tampon du fil d'écriture.  En mode
+ * SYNCHRONE, attend qu'il soit forcé sur disque.
+ *//****************************************************************************/
+
+void JournalCirconscription::journaliser(char p_type, const std::string& p_charge)
+{
+	char entete[64];
+	std::snprintf(entete, sizeof(entete), "%c %zu %08x\n", p_type, p_charge.size(),
+	              static_cast<unsigned int>(calculerSomme(p_charge)));
+
+	std::unique_lock<std::mutex> verrou(m_mutex);
+	if (!m_erreur.empty())
+		throw JournalException(m_erreur);
+
+	m_tampon += entete;
+	m_tampon += p_charge;
+	std::uint64_t sequence = ++m_sequence;
+	++m_nbEnregistrements;
+
+	if (m_durabilite == DIFFERE)
+	{
+		m_travail.notify_one();
+		return;
+	}
+
+	++m_nbEnAttente;
+	m_travail.notify_one();
+	m_forcage.wait(verrou, [this, sequence]() { return m_sequenceDurable >= sequence or !m_erreur.empty(); });
+	--m_nbEnAttente;
+	if (m_sequenceDurable < sequence)
+		throw JournalException(m_erreur);
+}
+
+/****************************************************************************//**
+ * Attend que tous les enregistrements soumis jusqu'ici soient forcés sur disque
+ *
+ * \exception JournalException si le journal ne peut être écrit
+ *//****************************************************************************/
+
+void JournalCirconscription::synchroniser()
+{
+	std::unique_lock<std::mutex> verrou(m_mutex);
+	std::uint64_t sequence = m_sequence;
+
+	++m_nbEnAttente;
+	m_travail.notify_one();
+	m_forcage.wait(verrou, [this, sequence]() { return m_sequenceDurable >= sequence or !m_erreur.empty(); });
+	--m_nbEnAttente;
+	if (m_sequenceDurable < sequence)
+		throw JournalException(m_erreur);
+}
+
+/****************************************************************************//**
+ * Fil d'écriture.  Prend tout le tampon d'un coup, l'écrit et le force sur
+ * disque hors du verrou: pendant ce temps, les enregistrements suivants
+ * s'accumulent et seront forcés ensemble au tour suivant.
+ *//****************************************************************************/
+
+void JournalCirconscription::ecrireEnArrierePlan()
+{
+	std::string lot;
+	std::unique_lock<std::mutex> verrou(m_mutex);
+
+	while (true)
+	{
+		m_travail.wait(verrou, [this]() { return m_arret or !m_tampon.empty(); });
+		if (m_tampon.empty()) break;
+		if (m_durabilite == DIFFERE)
+			m_travail.wait_for(verrou, m_delai, [this]() { return m_arret or m_nbEnAttente > 0; });
+
+		lot.clear();
+		lot.swap(m_tampon);
+		std::uint64_t fin = m_sequence;
+		verrou.unlock();
+
+		bool reussi = ecrireTout(m_descripteur, lot.data(), lot.size()) and forcer(m_descripteur);
+		std::string message = reussi ? std::string() : messageSysteme("impossible d'écrire", m_fichierJournal);
+
+		verrou.lock();
+		if (reussi) m_sequenceDurable = fin;
+		else if (m_erreur.empty()) m_erreur = message;
+		m_forcage.notify_all();
+	}
+}
+
+/****************************************************************************//**
+ * Reconstruit la circonscription au démarrage: relit la sauvegarde, puis
+ * rejoue le journal
+ *
+ * \return une circonscription allouée dynamiquement, à désallouer par l'appelant
+ *
+ * \exception JournalException si la sauvegarde est introuvable
+ * \exception FormatFichierException si la sauvegarde ou un enregistrement est invalide
+ *//****************************************************************************/
+
+Circonscription* JournalCirconscription::restaurer() const
+{
+	std::ifstream fichier(m_fichierSauvegarde.c_str(), std::ios::binary);
+	if (!fichier)
+		throw JournalException(messageSysteme("impossible d'ouvrir", m_fichierSauvegarde));
+
+	Circonscription* circonscription = recupererCirconscription(fichier);
+	try
+	{
+		rejouer(*circonscription);
+	}
+	catch (...)
+	{
+		delete circonscription;
+		throw;
+	}
+	return circonscription;
+}
+
+/****************************************************************************//**
+ * Applique à une circonscription les enregistrements écrits dans le journal.
+ * Une inscription déjà présente ou une désinscription déjà faite est ignorée,
+ * et un remplacement déjà fait ne change rien: rejouer un journal sur une
+ * sauvegarde qui en tient déjà compte, après un arrêt entre les deux étapes
+ * de compacter(), donne le même état.
+ *
+ * \return le nombre d'enregistrements lus
+ *
+ * \exception FormatFichierException si un bloc d'inscription est invalide
+ *//****************************************************************************/
+
+std::size_t JournalCirconscription::rejouer(Circonscription& p_circonscription) const
+{
+	std::vector<std::pair<char, std::string>> enregistrements;
+	analyserJournal(lireFichier(m_fichierJournal), enregistrements);
+
+	for (const std::pair<char, std::string>& enregistrement: enregistrements)
+	{
+		if (enregistrement.first == '+' or enregistrement.first == '=')
+		{
+			std::istringstream bloc(enregistrement.second);
+			Personne* personne = lirePersonne(bloc);
+			if (enregistrement.first == '+') p_circonscription.tenterInscrire(*personne, util::DEJA_VALIDE);
+			else p_circonscription.remplacer(*personne);
+			delete personne;
+		}
+		else
+		{
+			p_circonscription.tenterDesinscrire(enregistrement.second.substr(0, enregistrement.second.size() - 1));
+		}
+	}
+	return enregistrements.size();
+}
+
+/****************************************************************************//**
+ * Réécrit la sauvegarde à partir de la circonscription, puis vide le journal.
+ * La nouvelle sauvegarde est écrite à côté et renommée une fois forcée sur
+ * disque: un arrêt brutal laisse l'ancienne ou la nouvelle, jamais un mélange.
+ *
+ * \pre aucune modification n'est journalisée pendant le compactage
+ *
+ * \exception JournalException si la sauvegarde ne peut être écrite
+ *//****************************************************************************/
+
+void JournalCirconscription::compacter(const Circonscription& p_circonscription)
+{
+	const std::string temporaire = m_fichierSauvegarde + ".tmp";
+
+	synchroniser();
+	{
+		std::ofstream fichier(temporaire.c_str(), std::ios::binary);
+		if (!fichier or !sauvegarderCirconscription(fichier, p_circonscription))
+			throw JournalException("impossible d'écrire " + temporaire);
+	}
+	if (!remplacerFichier(temporaire, m_fichierSauvegarde))
+		throw JournalException(messageSysteme("impossible de remplacer", m_fichierSauvegarde));
+
+	reinitialiser();
+}
+
+/****************************************************************************//**
+ * Vide le journal.  À appeler après avoir écrit soi-même une sauvegarde
+ * complète, par exemple en arrière-plan avec un SuiviTraitement: elle est
+ * forcée sur disque avant que le journal soit tronqué.
+ *
+ * \pre aucune modification n'est journalisée pendant l'appel
+ *
+ * \exception JournalException si la sauvegarde ne peut être forcée ou le
+ * journal tronqué
+ *//****************************************************************************/
+
+void JournalCirconscription::reinitialiser()
+{
+	if (!forcerFichier(m_fichierSauvegarde) or !forcerRepertoire(m_fichierSauvegarde))
+		throw JournalException(messageSysteme("impossible de forcer", m_fichierSauvegarde));
+
+	std::unique_lock<std::mutex> verrou(m_mutex);
+
+	m_forcage.wait(verrou, [this]() { return m_sequenceDurable == m_sequence or !m_erreur.empty(); });
+	if (!m_erreur.empty())
+		throw JournalException(m_erreur);
+	if (!tronquer(m_descripteur, 0) or !forcer(m_descripteur))
+		throw JournalException(messageSysteme("impossible de vider", m_fichierJournal));
+	m_nbEnregistrements = 0;
+
+	INVARIANTS();
+}
+
+const std::string& JournalCirconscription::reqFichierSauvegarde() const
+{
+	return m_fichierSauvegarde;
+}
+
+const std::string& JournalCirconscription::reqFichierJournal() const
+{
+	return m_fichierJournal;
+}
+
+/****************************************************************************//**
+ * \return le nombre d'enregistrements du journal depuis le dernier
+ * compactage, forcés ou non; sert à décider quand compacter
+ *//****************************************************************************/
+
+std::uint64_t JournalCirconscription::reqNbEnregistrements() const
+{
+	std::lock_guard<std::mutex> verrou(m_mutex);
+	return m_nbEnregistrements;
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS(), le verrou tenu ou avant le démarrage du fil
+ *//****************************************************************************/
+
+void JournalCirconscription::verifieInvariant() const
+{
+	INVARIANT(m_descripteur >= 0);
+	INVARIANT(m_sequenceDurable <= m_sequence);
+}
+
+} // namespace elections
@@ -0,0 +1,141 @@
+/**
+ * \file JournalCirconscription.h
+ *
+ * \brief Déclaration de la classe JournalCirconscription, journal des
+ * inscriptions et désinscriptions survenues depuis la dernière sauvegarde
+ * d'une circonscription.
+ *
+ * Le journal est un fichier voisin de la sauvegarde, de même nom suivi de
+ * EXTENSION_JOURNAL.  Chaque enregistrement y est ajouté à la fin, précédé
+ * d'un en-tête « type longueur somme »: le type est '+' pour une inscription
+ * (la charge est le bloc de ecrirePersonne()), '=' pour le remplacement d'un
+ * inscrit par une nouvelle version de même NAS (même charge) ou '-' pour une
+ * désinscription (la charge est le NAS).  La somme de contrôle permet d'écarter un dernier
+ * enregistrement écrit à moitié lors d'un arrêt brutal.
+ *
+ *  Created on: 2020-12-20
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef JOURNALCIRCONSCRIPTION_H_
+#define JOURNALCIRCONSCRIPTION_H_
+
+#include "Circonscription.h"
+#include "Personne.h"
+#include "Resultat.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class JournalException
+ *
+ * Lancée lorsque le journal ne peut être ouvert, écrit ou forcé sur disque.
+ * Une fois lancée pour une écriture, elle l'est pour toutes les suivantes.
+ *
+ *//*****************************************************************************/
+
+class JournalException : public std::runtime_error
+{
+public:
+	JournalException(const std::string& p_raison) : std::runtime_error(p_raison) {}
+};
+
+/****************************************************************************//**
+ * \class JournalCirconscription
+ *
+ * Rend durables les modifications d'une circonscription sans la réécrire au
+ * complet.  Un fil d'écriture regroupe les enregistrements soumis pendant le
+ * forçage sur disque précédent, et les force ensemble: un seul fsync sert
+ * tous les fils qui attendaient (« group commit »).
+ *
+ * En mode SYNCHRONE, une modification n'est rendue à l'appelant qu'une fois
+ * forcée sur disque.  En mode DIFFERE, elle l'est dès qu'elle est placée dans
+ * le tampon, et le fil d'écriture la force au plus tard après le délai
+ * donné: un arrêt brutal peut alors perdre ce délai de modifications.
+ *
+ * Au démarrage, restaurer() relit la sauvegarde puis rejoue le journal.
+ * compacter() réécrit la sauvegarde et vide le journal.
+ *
+ *//*****************************************************************************/
+
+class JournalCirconscription
+{
+public:
+
+	enum Durabilite
+	{
+		SYNCHRONE, DIFFERE
+	};
+
+	static const std::string EXTENSION_JOURNAL;
+
+	JournalCirconscription(const std::string& p_fichierSauvegarde, Durabilite p_durabilite = SYNCHRONE,
+	                       std::chrono::microseconds p_delai = std::chrono::microseconds(2000));
+	~JournalCirconscription();
+
+	JournalCirconscription(const JournalCirconscription&) = delete;
+	JournalCirconscription& operator=(const JournalCirconscription&) = delete;
+
+	/* Modifications journalisées */
+
+	util::Resultat<void> inscrire(Circonscription& p_circonscription, const Personne& p_personne);
+	util::Resultat<void> desinscrire(Circonscription& p_circonscription, const std::string& p_nas);
+	util::Resultat<void> remplacer(Circonscription& p_circonscription, const Personne& p_personne);
+
+	void journaliserInscription(const Personne& p_personne);
+	void journaliserDesinscription(const std::string& p_nas);
+	void journaliserRemplacement(const Personne& p_personne);
+	void synchroniser();
+
+	/* Démarrage et compactage */
+
+	Circonscription* restaurer() const;
+	std::size_t rejouer(Circonscription& p_circonscription) const;
+	void compacter(const Circonscription& p_circonscription);
+	void reinitialiser();
+
+	const std::string& reqFichierSauvegarde() const;
+	const std::string& reqFichierJournal() const;
+	std::uint64_t reqNbEnregistrements() const;
+
+private:
+
+	void journaliser(char p_type, const std::string& p_charge);
+	void ecrireEnArrierePlan();
+	void verifieInvariant() const;
+
+	std::string                 m_fichierSauvegarde;
+	std::string                 m_fichierJournal;
+	Durabilite                  m_durabilite;
+	std::chrono::microseconds   m_delai;
+	int                         m_descripteur;
+
+	mutable std::mutex          m_mutex;
+	std::condition_variable     m_travail;
+	std::condition_variable     m_forcage;
+	std::string                 m_tampon;
+	std::uint64_t               m_sequence;
+	std::uint64_t               m_sequenceDurable;
+	std::uint64_t               m_nbEnregistrements;
+	std::size_t                 m_nbEnAttente;
+	bool                        m_arret;
+	std::string                 m_erreur;
+	std::thread                 m_fil;
+};
+
+bool remplacerFichier(const std::string& p_source, const std::string& p_destination);
+
+} // namespace elections
+
+#endif /* JOURNALCIRCONSCRIPTION_H_ */
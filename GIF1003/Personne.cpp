@@ -44,6 +44,31 @@ bool Personne::validerIdentitePersonne(const std::string& p_nas, const std::stri
 }
 
 
+/****************************************************************************//**
+ * Identifie le premier champ invalide parmi le NAS, le nom et le prénom.
+ *
+ * \param[in] p_nas Le numéro d'assurance sociale (format XXX XXX XXX)
+ * \param[in] p_nom Le champs nom (non-vide)
+ * \param[in] p_prenom Le champs prénom. (non-vide)
+ *
+ * \return AUCUNE_ERREUR si les trois champs sont valides, sinon NAS_INVALIDE,
+ * NOM_INVALIDE ou PRENOM_INVALIDE.
+ *//****************************************************************************/
+
+util::CodeErreur Personne::diagnostiquerIdentite(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom)
+{
+	util::CodeErreur code = util::AUCUNE_ERREUR;
+
+	if (!util::validerNas(p_nas))
+		code = util::NAS_INVALIDE;
+	else if (!util::estUnNom(p_nom))
+		code = util::NOM_INVALIDE;
+	else if (!util::estUnNom(p_prenom))
+		code = util::PRENOM_INVALIDE;
+
+	return code;
+}
+
 /************************************************************************//**
  * Constructeur de base de la classe, par affectation membre à membre
  *
@@ -66,7 +91,20 @@ bool Personne::validerIdentitePersonne(const std::string& p_nas, const std::stri
 
 Personne::Personne(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom,
 		const util::Date& p_date, const util::Adresse& p_adresse) :
-				m_nas(p_nas), m_nom(p_nom), m_prenom(p_prenom), m_dateNaissance(p_date), m_adresse(p_adresse)
+				Personne(p_nas, p_nom, p_prenom, p_date, p_adresse, TypePersonne::AUTRE)
+{
+}
+
+/****************************************************************************//**
+ * Constructeur des classes dérivées du modèle, qui déclarent leur type
+ *
+ * \param[in] p_type le type concret de l'objet construit
+ *
+ *//****************************************************************************/
+
+Personne::Personne(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom,
+		const util::Date& p_date, const util::Adresse& p_adresse, TypePersonne p_type) :
+				m_nas(p_nas), m_nom(p_nom), m_prenom(p_prenom), m_dateNaissance(p_date), m_adresse(p_adresse), m_type(p_type)
 {
     PRECONDITION(validerIdentitePersonne(p_nas, p_nom,p_prenom));
 
@@ -77,6 +115,53 @@ Personne::Personne(const std::string& p_nas, const std::string& p_nom, const std
 
 }
 
+/****************************************************************************//**
+ * Constructeur de confiance: les champs ont déjà été validés par l'appelant.
+ * validerIdentitePersonne() relit le NAS trois fois et chaque nom analyse
+ * aussi le NAS et la date; ce constructeur ne le fait qu'en échantillon.
+ *
+ * \pre les champs sont valides, voir le constructeur vérifié
+ *
+ *//****************************************************************************/
+
+Personne::Personne(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom,
+		const util::Date& p_date, const util::Adresse& p_adresse, TypePersonne p_type, util::DejaValide) :
+				m_nas(p_nas), m_nom(p_nom), m_prenom(p_prenom), m_dateNaissance(p_date), m_adresse(p_adresse), m_type(p_type)
+{
+	PRECONDITION_COUTEUSE(validerIdentitePersonne(p_nas, p_nom, p_prenom));
+}
+
+/****************************************************************************//**
+ * Constructeur copie.  La représentation mémorisée est partagée: elle ne
+ * change pas tant que la copie n'est pas modifiée.
+ *
+ *//****************************************************************************/
+
+Personne::Personne(const Personne& p_personne) :
+		m_nas(p_personne.m_nas), m_nom(p_personne.m_nom), m_prenom(p_personne.m_prenom),
+		m_dateNaissance(p_personne.m_dateNaissance), m_adresse(p_personne.m_adresse), m_type(p_personne.m_type),
+		m_texteFormate(std::atomic_load(&p_personne.m_texteFormate))
+{
+}
+
+/****************************************************************************//**
+ * Affectation, réservée aux classes dérivées: une Personne ne peut recevoir
+ * que les attributs d'une personne de même classe.  Le type concret n'est pas
+ * copié, il reste celui de l'objet affecté.
+ *
+ *//****************************************************************************/
+
+Personne& Personne::operator=(const Personne& p_personne)
+{
+	m_nas = p_personne.m_nas;
+	m_nom = p_personne.m_nom;
+	m_prenom = p_personne.m_prenom;
+	m_dateNaissance = p_personne.m_dateNaissance;
+	m_adresse = p_personne.m_adresse;
+	std::atomic_store(&m_texteFormate, std::atomic_load(&p_personne.m_texteFormate));
+	return *this;
+}
+
 /****************************************************************************//**
  * Vérifie si les attributs d'un objet Personne sont valides.
  *
@@ -90,6 +175,18 @@ bool Personne::valider() const
 	return validerIdentitePersonne(m_nas, m_nom, m_prenom);
 }
 
+/****************************************************************************//**
+ * Accesseur du type concret
+ *
+ * \return ELECTEUR ou CANDIDAT pour les classes du modèle, AUTRE sinon
+ *
+ *//****************************************************************************/
+
+TypePersonne Personne::reqType() const
+{
+	return m_type;
+}
+
 /****************************************************************************//**
  * Fonction invoquant une macro qui valide les invariants de la classe Personne.
  *
@@ -198,6 +295,7 @@ void Personne::asgAdresse(const util::Adresse& p_nouvelleAdresse)
 	PRECONDITION(p_nouvelleAdresse.validerAdresse());
 
 	m_adresse = p_nouvelleAdresse;
+	oublierTexteFormate();
 
 	INVARIANTS();
 	POSTCONDITION(m_adresse == p_nouvelleAdresse);
@@ -258,6 +356,40 @@ std::string Personne::reqPersonneFormate() const
     return os.str();
 }
 
+/****************************************************************************//**
+ * Représentation affichable mémorisée: construite par reqPersonneFormate() au
+ * premier appel, puis partagée jusqu'à la prochaine modification.  C'est un
+ * choix de l'appelant; reqPersonneFormate() ne lit ni n'écrit la mémoire.
+ *
+ * Plusieurs fils peuvent la demander en même temps: le premier texte publié
+ * est conservé, les autres sont abandonnés.
+ *
+ * \return le texte de reqPersonneFormate(), jamais nul
+ *//****************************************************************************/
+
+std::shared_ptr<const std::string> Personne::reqTexteFormate() const
+{
+	std::shared_ptr<const std::string> texte = std::atomic_load(&m_texteFormate);
+
+	if (!texte)
+	{
+		std::shared_ptr<const std::string> nouveau = std::make_shared<const std::string>(reqPersonneFormate());
+		if (std::atomic_compare_exchange_strong(&m_texteFormate, &texte, nouveau))
+			texte = nouveau;
+	}
+	return texte;
+}
+
+/****************************************************************************//**
+ * Invalide la représentation mémorisée.  Tout mutateur d'un attribut affiché,
+ * ici ou dans une classe dérivée, doit l'appeler.
+ *//****************************************************************************/
+
+void Personne::oublierTexteFormate()
+{
+	std::atomic_store(&m_texteFormate, std::shared_ptr<const std::string>());
+}
+
 /****************************************************************************//**
  * Destructeur
  *
@@ -12,6 +12,8 @@
 #ifndef PERSONNE_H_
 #define PERSONNE_H_
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include "Date.h"
 #include "Adresse.h"
@@ -24,12 +26,30 @@
 namespace elections
 {
 
+/****************************************************************************//**
+ * \enum TypePersonne
+ *
+ * Type concret d'une Personne, connu sans appel virtuel ni dynamic_cast.
+ * AUTRE désigne une classe dérivée hors du modèle, comme celles des tests.
+ *//****************************************************************************/
+
+enum class TypePersonne : std::uint8_t
+{
+	AUTRE, ELECTEUR, CANDIDAT
+};
+
 /****************************************************************************//**
  * Classe abstraite permettant de manipuler les renseignements relatifs à une personne
  *
  * Contient les informations démographiques de base d'une personne ainsi que les
  * méthodes permettant de les modifier, les valider et les afficher.
  *
+ * Limite: les membres sont des std::string, sans allocateur.  Une
+ * Circonscription dotée d'une std::pmr::memory_resource y place l'objet
+ * Personne lui-même, mais un nom ou un prénom plus long que la capacité locale
+ * de std::string (15 caractères avec libstdc++) et la représentation mémorisée
+ * restent alloués par new, hors de la ressource.
+ *
  *//****************************************************************************/
 
 class Personne
@@ -40,6 +60,11 @@ private:
 	std::string   m_prenom;
 	util::Date    m_dateNaissance;
 	util::Adresse m_adresse;
+	TypePersonne  m_type;
+
+	/* Représentation mémorisée, lue et écrite par std::atomic_load/store */
+
+	mutable std::shared_ptr<const std::string> m_texteFormate;
 
 	/* Méthode d'application du contrat */
 
@@ -53,15 +78,21 @@ public:
 	static bool validerPrenom(const std::string& p_prenom);
 	static bool validerNom(const std::string& p_nom);
 	static bool validerIdentitePersonne(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom);
+	static util::CodeErreur diagnostiquerIdentite(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom);
 
 	/* Constructeur */
 
 	Personne(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom, const util::Date& p_dateNaissance, const util::Adresse& p_adresse);
+	Personne(const Personne& p_personne);
 
 	/* Validateur interne */
 
 	virtual bool valider() const;
 
+	/* Type concret */
+
+	TypePersonne reqType() const;
+
 	/* Accesseurs */
 
     const std::string& reqNas() const;
@@ -86,11 +117,21 @@ public:
 	/* Représentations */
 
 	virtual std::string reqPersonneFormate() const = 0;
+	std::shared_ptr<const std::string> reqTexteFormate() const;
 
 	/* Destructeur */
 
 	virtual ~Personne() ;
 
+protected:
+
+	Personne& operator=(const Personne& p_personne);
+
+	Personne(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom, const util::Date& p_dateNaissance, const util::Adresse& p_adresse, TypePersonne p_type);
+	Personne(const std::string& p_nas, const std::string& p_nom, const std::string& p_prenom, const util::Date& p_dateNaissance, const util::Adresse& p_adresse, TypePersonne p_type, util::DejaValide);
+
+	void oublierTexteFormate();
+
 };
 
 } // namespace elections
@@ -0,0 +1,135 @@
+/**
+ * \file Province.cpp
+ * \brief Implantation des fonctions d'analyse des provinces et territoires
+ *
+ *  Created on: 2020-12-23
+ *  \version 0.1
+ *  \author Pascal Charpentier
+ */
+
+#include "Province.h"
+#include "ContratException.h"
+
+#include <array>
+#include <cstring>
+
+namespace util
+{
+
+/****************************************************************************//**
+ * Noms des provinces et territoires, dans l'ordre de l'énumération.  Les noms
+ * français sont ceux des fichiers de la liste électorale.  Des chaînes C, pour
+ * que la table soit utilisable pendant l'initialisation d'autres variables
+ * statiques.
+ *//****************************************************************************/
+
+static const char* const NOMS_FR[NB_PROVINCES + 1] = { "Colombie-Britannique", "Alberta", "Saskatchewan", "Manitoba",
+		"Ontario", "Québec", "Nouveau-Brunswick", "Nouvelle-Écosse", "Ile du Prince Édouard", "Terre-Neuve", "Nunavut", "Yukon",
+		"Territoires du Nord-Ouest", "" };
+
+static const char* const NOMS_EN[NB_PROVINCES + 1] = { "British Columbia", "Alberta", "Saskatchewan", "Manitoba",
+		"Ontario", "Quebec", "New Brunswick", "Nova Scotia", "Prince Edward Island", "Newfoundland and Labrador", "Nunavut",
+		"Yukon", "Northwest Territories", "" };
+
+static const char* const ABREVIATIONS[NB_PROVINCES + 1] = { "BC", "AB", "SK", "MB", "ON", "QC", "NB", "NS", "PE", "NL",
+		"NU", "YT", "NT", "" };
+
+/****************************************************************************//**
+ * Graphies officielles qui diffèrent de celles des fichiers
+ *//****************************************************************************/
+
+static const struct { const char* texte; Province province; } AUTRES_GRAPHIES[] =
+{
+	{ "Île-du-Prince-Édouard", Province::ILE_DU_PRINCE_EDOUARD },
+	{ "Terre-Neuve-et-Labrador", Province::TERRE_NEUVE }
+};
+
+/****************************************************************************//**
+ * Hachage parfait des 35 graphies reconnues: le premier, le deuxième et le
+ * dernier octet et la longueur suffisent à les distinguer toutes dans une
+ * table de 64 cases.  Les constantes ont été trouvées par recherche
+ * exhaustive; la construction de la table vérifie l'absence de collision.
+ *//****************************************************************************/
+
+static const std::size_t TAILLE_TABLE = 64;
+
+static std::size_t hacher(const char* p_texte, std::size_t p_longueur)
+{
+	const unsigned char* c = reinterpret_cast<const unsigned char*>(p_texte);
+	return (c[0] + 38u * c[1] + 7u * c[p_longueur - 1] + 7u * p_longueur) & (TAILLE_TABLE - 1);
+}
+
+struct Case
+{
+	const char*  texte = nullptr;
+	std::size_t  longueur = 0;
+	Province     province = Province::AUTRE;
+};
+
+static std::array<Case, TAILLE_TABLE> construireTable()
+{
+	std::array<Case, TAILLE_TABLE> table;
+
+	auto placer = [&table](const char* p_texte, Province p_province)
+	{
+		std::size_t longueur = std::strlen(p_texte);
+		Case& place = table[hacher(p_texte, longueur)];
+		INVARIANT(place.texte == nullptr);
+		place.texte = p_texte;
+		place.longueur = longueur;
+		place.province = p_province;
+	};
+	for (std::size_t i = 0; i < NB_PROVINCES; ++i)
+	{
+		placer(NOMS_FR[i], static_cast<Province>(i));
+		if (std::strcmp(NOMS_EN[i], NOMS_FR[i]) != 0) placer(NOMS_EN[i], static_cast<Province>(i));
+		placer(ABREVIATIONS[i], static_cast<Province>(i));
+	}
+	for (const auto& graphie: AUTRES_GRAPHIES) placer(graphie.texte, graphie.province);
+	return table;
+}
+
+/****************************************************************************//**
+ * Reconnaît une province ou un territoire par son nom français, son nom
+ * anglais ou son abréviation postale, en respectant la casse.  Un seul
+ * hachage et une seule comparaison de chaînes.
+ *
+ * \param[in] p_texte le texte à analyser
+ *
+ * \return la province, ou ADRESSE_INVALIDE si le texte n'est pas reconnu
+ *//****************************************************************************/
+
+Resultat<Province> analyserProvince(const std::string& p_texte)
+{
+	static const std::array<Case, TAILLE_TABLE> TABLE = construireTable();
+
+	if (p_texte.size() < 2)
+		return ADRESSE_INVALIDE;
+
+	const Case& place = TABLE[hacher(p_texte.data(), p_texte.size())];
+	if (place.longueur != p_texte.size() or std::memcmp(place.texte, p_texte.data(), place.longueur) != 0)
+		return ADRESSE_INVALIDE;
+	return place.province;
+}
+
+/****************************************************************************//**
+ * \return le nom français, tel qu'écrit dans les fichiers; une chaîne vide pour
+ * Province::AUTRE
+ *//****************************************************************************/
+
+std::string reqNomProvince(Province p_province)
+{
+	return NOMS_FR[static_cast<std::size_t>(p_province)];
+}
+
+std::string reqNomAnglaisProvince(Province p_province)
+{
+	return NOMS_EN[static_cast<std::size_t>(p_province)];
+}
+
+std::string reqAbreviationProvince(Province p_province)
+{
+	return ABREVIATIONS[static_cast<std::size_t>(p_province)];
+}
+
+} // namespace util
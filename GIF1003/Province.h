@@ -0,0 +1,47 @@
+/**
+ * \file Province.h
+ * \brief Déclaration de l'énumération Province et de ses fonctions d'analyse
+ *
+ *  Created on: 2020-12-23
+ *  \version 0.1
+ *  \author Pascal Charpentier
+ */
+
+#ifndef PROVINCE_H_
+#define PROVINCE_H_
+
+#include "Resultat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace util
+{
+
+/**
+ * \enum Province
+ * \brief Province ou territoire canadien, tenu dans un octet
+ *
+ * Les valeurs vont de 0 à NB_PROVINCES - 1 et peuvent servir d'indice de
+ * tableau.  AUTRE désigne une province ou un état étranger.
+ */
+
+enum class Province : std::uint8_t
+{
+	COLOMBIE_BRITANNIQUE, ALBERTA, SASKATCHEWAN, MANITOBA, ONTARIO, QUEBEC,
+	NOUVEAU_BRUNSWICK, NOUVELLE_ECOSSE, ILE_DU_PRINCE_EDOUARD, TERRE_NEUVE,
+	NUNAVUT, YUKON, TERRITOIRES_DU_NORD_OUEST, AUTRE
+};
+
+static const std::size_t NB_PROVINCES = static_cast<std::size_t>(Province::AUTRE);
+
+Resultat<Province> analyserProvince(const std::string& p_texte);
+
+std::string reqNomProvince(Province p_province);
+std::string reqNomAnglaisProvince(Province p_province);
+std::string reqAbreviationProvince(Province p_province);
+
+} // namespace util
+
+#endif /* PROVINCE_H_ */
@@ -0,0 +1,361 @@
+/****************************************************************************//**
+ * \file RegistreProvincial.cpp
+ *
+ * \brief Implantation de la classe RegistreProvincial
+ *
+ *  Created on: 2020-12-16
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "RegistreProvincial.h"
+#include "ContratException.h"
+#include "validationFormat.h"
+#include "VisiteurPersonne.h"
+
+#include <future>
+#include <utility>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Constructeur: registre vide
+ *
+ * \param[in] p_nbFils nombre de fils du bassin; 0 pour un fil par cœur
+ *//****************************************************************************/
+
+RegistreProvincial::RegistreProvincial(std::size_t p_nbFils) : m_circonscriptions(), m_index(), m_bassin(p_nbFils)
+{
+	INVARIANTS();
+}
+
+/****************************************************************************//**
+ * Destructeur: désalloue les circonscriptions
+ *//****************************************************************************/
+
+RegistreProvincial::~RegistreProvincial()
+{
+	for (Circonscription* circonscription: m_circonscriptions)
+		delete circonscription;
+}
+
+/****************************************************************************//**
+ * Ajoute une copie d'une circonscription au registre
+ *
+ * \param[in] p_circonscription la circonscription à ajouter, avec ses inscrits
+ *
+ * \return le numéro attribué à la circonscription, ou PERSONNE_DEJA_PRESENTE si
+ * un de ses inscrits l'est déjà ailleurs.  Le registre est alors inchangé.
+ *//****************************************************************************/
+
+util::Resultat<std::size_t> RegistreProvincial::ajouterCirconscription(const Circonscription& p_circonscription)
+{
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		if (m_index.trouver(util::compacterNas((*it)->reqNas())))
+			return util::PERSONNE_DEJA_PRESENTE;
+	}
+
+	std::size_t numero = m_circonscriptions.size();
+	m_circonscriptions.push_back(new Circonscription(p_circonscription));
+	m_index.reserver(m_index.reqNbElements() + p_circonscription.reqNbInscrits());
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		m_index.inserer(util::compacterNas((*it)->reqNas()), static_cast<std::uint32_t>(numero));
+	}
+
+	INVARIANTS();
+	return numero;
+}
+
+/****************************************************************************//**
+ * \return le nombre de circonscriptions du registre
+ *//****************************************************************************/
+
+std::size_t RegistreProvincial::reqNbCirconscriptions() const
+{
+	return m_circonscriptions.size();
+}
+
+/****************************************************************************//**
+ * \param[in] p_numero numéro retourné par ajouterCirconscription()
+ * \return la circonscription portant ce numéro
+ *//****************************************************************************/
+
+const Circonscription& RegistreProvincial::reqCirconscription(std::size_t p_numero) const
+{
+	PRECONDITION(p_numero < m_circonscriptions.size());
+
+	return *m_circonscriptions[p_numero];
+}
+
+/****************************************************************************//**
+ * \return le nombre total d'inscrits, toutes circonscriptions confondues
+ *//****************************************************************************/
+
+std::size_t RegistreProvincial::reqNbInscrits() const
+{
+	return m_index.reqNbElements();
+}
+
+/****************************************************************************//**
+ * Trouve la circonscription où un NAS est inscrit, en temps constant
+ *
+ * \param[in] p_nas le NAS cherché
+ * \return la circonscription, ou nullptr si le NAS n'est inscrit nulle part ou
+ * n'a pas le format d'un NAS
+ *//****************************************************************************/
+
+const Circonscription* RegistreProvincial::localiser(const std::string& p_nas) const
+{
+	const std::uint32_t* numero = m_index.trouver(util::compacterNas(p_nas));
+	return numero ? m_circonscriptions[*numero] : nullptr;
+}
+
+/****************************************************************************//**
+ * Inscrit une personne dans une circonscription
+ *
+ * \param[in] p_numero numéro de la circonscription
+ * \param[in] p_personne la personne à inscrire
+ *
+ * \return PERSONNE_INVALIDE, ou PERSONNE_DEJA_PRESENTE si le NAS est inscrit
+ * dans n'importe quelle circonscription du registre
+ *//****************************************************************************/
+
+util::Resultat<void> RegistreProvincial::inscrire(std::size_t p_numero, const Personne& p_personne)
+{
+	PRECONDITION(p_numero < m_circonscriptions.size());
+
+	if (!validerPersonne(p_personne))
+		return util::PERSONNE_INVALIDE;
+
+	std::uint32_t cle = util::compacterNas(p_personne.reqNas());
+	if (m_index.trouver(cle))
+		return util::PERSONNE_DEJA_PRESENTE;
+
+	util::Resultat<void> resultat = m_circonscriptions[p_numero]->tenterInscrire(p_personne, util::DEJA_VALIDE);
+	if (resultat)
+		m_index.inserer(cle, static_cast<std::uint32_t>(p_numero));
+
+	INVARIANTS();
+	return resultat;
+}
+
+/****************************************************************************//**
+ * Retire une personne de la circonscription où elle est inscrite
+ *
+ * \param[in] p_nas le NAS de la personne
+ * \return NAS_INVALIDE ou PERSONNE_ABSENTE si le retrait est impossible
+ *//****************************************************************************/
+
+util::Resultat<void> RegistreProvincial::desinscrire(const std::string& p_nas)
+{
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE;
+
+	std::uint32_t cle = util::compacterNas(p_nas);
+	const std::uint32_t* numero = m_index.trouver(cle);
+	if (!numero)
+		return util::PERSONNE_ABSENTE;
+
+	util::Resultat<void> resultat = m_circonscriptions[*numero]->tenterDesinscrire(p_nas);
+	if (resultat)
+		m_index.retirer(cle);
+
+	INVARIANTS();
+	return resultat;
+}
+
+/****************************************************************************//**
+ * Inscrit plusieurs lots de personnes, en parallèle d'une circonscription à
+ * l'autre.
+ *
+ * Le traitement se fait en trois étapes:
+ * 1. validation des personnes, en parallèle;
+ * 2. réservation des NAS dans l'index global, dans l'ordre des lots: la
+ *    première occurrence d'un NAS l'emporte, même entre deux circonscriptions;
+ * 3. copie des personnes retenues dans leur circonscription, en parallèle.
+ *
+ * \param[in] p_lots les lots; plusieurs lots peuvent viser la même circonscription
+ *
+ * \return pour chaque lot, le code de chaque personne: AUCUNE_ERREUR si elle
+ * est inscrite, PERSONNE_INVALIDE ou PERSONNE_DEJA_PRESENTE sinon
+ *//****************************************************************************/
+
+std::vector<std::vector<util::CodeErreur>> RegistreProvincial::inscrireEnLot(const std::vector<Lot>& p_lots)
+{
+	std::vector<std::vector<util::CodeErreur>> codes(p_lots.size());
+	std::vector<std::vector<std::size_t>> lotsParCirconscription(m_circonscriptions.size());
+	std::size_t nbPersonnes = 0;
+
+	for (std::size_t l = 0; l < p_lots.size(); ++l)
+	{
+		PRECONDITION(p_lots[l].circonscription < m_circonscriptions.size());
+
+		codes[l].assign(p_lots[l].personnes.size(), util::AUCUNE_ERREUR);
+		lotsParCirconscription[p_lots[l].circonscription].push_back(l);
+		nbPersonnes += p_lots[l].personnes.size();
+	}
+
+	std::vector<std::future<void>> taches;
+	for (const std::vector<std::size_t>& lots: lotsParCirconscription)
+	{
+		if (lots.empty()) continue;
+		taches.push_back(m_bassin.soumettre([&p_lots, &codes, &lots]()
+		{
+			for (std::size_t l: lots)
+				for (std::size_t p = 0; p < p_lots[l].personnes.size(); ++p)
+					if (!validerPersonne(*p_lots[l].personnes[p])) codes[l][p] = util::PERSONNE_INVALIDE;
+		}));
+	}
+	util::attendreToutes(taches);
+	for (std::future<void>& tache: taches) tache.get();
+	taches.clear();
+
+	m_index.reserver(m_index.reqNbElements() + nbPersonnes);
+	for (std::size_t l = 0; l < p_lots.size(); ++l)
+	{
+		for (std::size_t p = 0; p < p_lots[l].personnes.size(); ++p)
+		{
+			if (codes[l][p] == util::AUCUNE_ERREUR and
+				!m_index.inserer(util::compacterNas(p_lots[l].personnes[p]->reqNas()),
+				                 static_cast<std::uint32_t>(p_lots[l].circonscription)))
+				codes[l][p] = util::PERSONNE_DEJA_PRESENTE;
+		}
+	}
+
+	for (std::size_t c = 0; c < lotsParCirconscription.size(); ++c)
+	{
+		const std::vector<std::size_t>& lots = lotsParCirconscription[c];
+		Circonscription* circonscription = m_circonscriptions[c];
+		if (lots.empty()) continue;
+		taches.push_back(m_bassin.soumettre([&p_lots, &codes, &lots, circonscription]()
+		{
+			for (std::size_t l: lots)
+				for (std::size_t p = 0; p < p_lots[l].personnes.size(); ++p)
+					if (codes[l][p] == util::AUCUNE_ERREUR)
+						codes[l][p] = circonscription->tenterInscrire(*p_lots[l].personnes[p], util::DEJA_VALIDE).reqErreur();
+		}));
+	}
+	util::attendreToutes(taches);
+	for (std::future<void>& tache: taches) tache.get();
+
+	INVARIANTS();
+	return codes;
+}
+
+/****************************************************************************//**
+ * Transfère un inscrit dans une autre circonscription du registre, sans le
+ * recopier si les deux circonscriptions partagent la même ressource mémoire
+ *
+ * \param[in] p_nas le NAS de l'inscrit
+ * \param[in] p_destination numéro de la circonscription d'accueil
+ *
+ * \return NAS_INVALIDE ou PERSONNE_ABSENTE si le NAS n'est inscrit nulle part;
+ * un inscrit déjà dans la destination y reste, sans erreur
+ *//****************************************************************************/
+
+util::Resultat<void> RegistreProvincial::transferer(const std::string& p_nas, std::size_t p_destination)
+{
+	PRECONDITION(p_destination < m_circonscriptions.size());
+
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE;
+
+	std::uint32_t* numero = m_index.trouver(util::compacterNas(p_nas));
+	if (!numero)
+		return util::PERSONNE_ABSENTE;
+	if (*numero == p_destination)
+		return util::AUCUNE_ERREUR;
+
+	util::Resultat<void> resultat = m_circonscriptions[*numero]->transferer(p_nas, *m_circonscriptions[p_destination]);
+	if (resultat)
+		*numero = static_cast<std::uint32_t>(p_destination);
+
+	INVARIANTS();
+	return resultat;
+}
+
+/****************************************************************************//**
+ * Transfère en bloc les inscrits d'une circonscription choisis par un
+ * prédicat, par exemple les codes postaux cédés lors d'un redécoupage.  L'index
+ * global garantit qu'aucun NAS transféré n'est déjà dans la destination.
+ *
+ * \param[in] p_source numéro de la circonscription cédante
+ * \param[in] p_selection vrai pour chaque inscrit à transférer
+ * \param[in] p_destination numéro de la circonscription d'accueil
+ *
+ * \return le nombre d'inscrits transférés
+ *//****************************************************************************/
+
+util::Resultat<std::size_t> RegistreProvincial::transfererSi(std::size_t p_source,
+                                                             const Circonscription::Selection_t& p_selection,
+                                                             std::size_t p_destination)
+{
+	PRECONDITION(p_source < m_circonscriptions.size() and p_destination < m_circonscriptions.size());
+	PRECONDITION(p_source != p_destination);
+
+	std::vector<std::uint32_t> cles;
+	auto selectionner = [&p_selection, &cles](const Personne& p_inscrit)
+	{
+		bool choisi = p_selection(p_inscrit);
+		if (choisi) cles.push_back(util::compacterNas(p_inscrit.reqNas()));
+		return choisi;
+	};
+
+	util::Resultat<std::size_t> resultat =
+		m_circonscriptions[p_source]->transfererSi(selectionner, *m_circonscriptions[p_destination]);
+	ASSERTION(resultat.estValide());
+	for (std::uint32_t cle: cles)
+		*m_index.trouver(cle) = static_cast<std::uint32_t>(p_destination);
+
+	INVARIANTS();
+	return resultat;
+}
+
+/****************************************************************************//**
+ * Valide chaque circonscription et chacun de ses inscrits, en parallèle, et
+ * vérifie que l'index global désigne bien la circonscription de chacun.
+ *
+ * \return true si tout le registre est valide
+ *//****************************************************************************/
+
+bool RegistreProvincial::validerRegistre() const
+{
+	std::vector<std::future<bool>> taches;
+	std::size_t nbInscrits = 0;
+	bool valide = true;
+
+	for (std::size_t c = 0; c < m_circonscriptions.size(); ++c)
+	{
+		const Circonscription* circonscription = m_circonscriptions[c];
+		nbInscrits += circonscription->reqNbInscrits();
+		taches.push_back(m_bassin.soumettre([this, circonscription, c]()
+		{
+			bool valide = circonscription->validerCirconscription();
+			for (auto it = circonscription->reqDebutInscrits(); valide and it != circonscription->reqFinInscrits(); ++it)
+			{
+				const std::uint32_t* numero = m_index.trouver(util::compacterNas((*it)->reqNas()));
+				valide = validerPersonne(**it) and numero and *numero == c;
+			}
+			return valide;
+		}));
+	}
+	util::attendreToutes(taches);
+	for (std::future<bool>& tache: taches)
+		valide = tache.get() and valide;
+
+	return valide and nbInscrits == m_index.reqNbElements();
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS()
+ *//****************************************************************************/
+
+void RegistreProvincial::verifieInvariant() const
+{
+	INVARIANT(m_bassin.reqNbFils() > 0);
+	INVARIANT_COUTEUX(validerRegistre());
+}
+
+} // namespace elections
@@ -0,0 +1,103 @@
+/**
+ * \file RegistreProvincial.h
+ *
+ * \brief Déclaration de la classe RegistreProvincial, qui regroupe toutes les
+ * circonscriptions d'une province.
+ *
+ *  Created on: 2020-12-16
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef REGISTREPROVINCIAL_H_
+#define REGISTREPROVINCIAL_H_
+
+#include "BassinDeTaches.h"
+#include "Circonscription.h"
+#include "IndexNas.h"
+#include "Resultat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class RegistreProvincial
+ *
+ * Possède les circonscriptions d'une province et un index global qui associe
+ * chaque NAS inscrit au numéro de sa circonscription.  L'index permet de
+ * refuser, en temps constant, une personne déjà inscrite dans une autre
+ * circonscription, et de répondre à « où cet électeur est-il inscrit? ».
+ *
+ * Les inscriptions en lot et la validation sont réparties sur un bassin de
+ * fils d'exécution, à raison d'une tâche par circonscription: chaque
+ * circonscription n'est jamais modifiée par deux fils à la fois.  Le registre
+ * lui-même n'est pas protégé contre des appels concurrents.
+ *
+ *//*****************************************************************************/
+
+class RegistreProvincial
+{
+public:
+
+	/**
+	 * \struct Lot
+	 *
+	 * Personnes à inscrire dans une même circonscription
+	 */
+
+	struct Lot
+	{
+		std::size_t                  circonscription;
+		std::vector<const Personne*> personnes;
+	};
+
+	explicit RegistreProvincial(std::size_t p_nbFils = 0);
+	~RegistreProvincial();
+
+	RegistreProvincial(const RegistreProvincial&) = delete;
+	RegistreProvincial& operator=(const RegistreProvincial&) = delete;
+
+	/* Circonscriptions */
+
+	util::Resultat<std::size_t> ajouterCirconscription(const Circonscription& p_circonscription);
+	std::size_t reqNbCirconscriptions() const;
+	const Circonscription& reqCirconscription(std::size_t p_numero) const;
+	std::size_t reqNbInscrits() const;
+
+	/* Recherche en temps constant */
+
+	const Circonscription* localiser(const std::string& p_nas) const;
+
+	/* Manipulations */
+
+	util::Resultat<void> inscrire(std::size_t p_numero, const Personne& p_personne);
+	util::Resultat<void> desinscrire(const std::string& p_nas);
+	std::vector<std::vector<util::CodeErreur>> inscrireEnLot(const std::vector<Lot>& p_lots);
+
+	/* Transferts entre circonscriptions */
+
+	util::Resultat<void> transferer(const std::string& p_nas, std::size_t p_destination);
+	util::Resultat<std::size_t> transfererSi(std::size_t p_source, const Circonscription::Selection_t& p_selection,
+	                                         std::size_t p_destination);
+
+	/* Validation */
+
+	bool validerRegistre() const;
+
+private:
+
+	void verifieInvariant() const;
+
+	std::vector<Circonscription*>  m_circonscriptions;
+	util::IndexNas<std::uint32_t>  m_index;
+	mutable util::BassinDeTaches   m_bassin;
+};
+
+} // namespace elections
+
+#endif /* REGISTREPROVINCIAL_H_ */
@@ -0,0 +1,38 @@
+/****************************************************************************//**
+ * \file Resultat.cpp
+ *
+ * \brief Messages associés aux codes d'erreur de validation
+ *
+ *  Created on: 2020-12-13
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "Resultat.h"
+
+namespace util
+{
+
+/****************************************************************************//**
+ * Convertit un code d'erreur en message affichable
+ *
+ * \param[in] p_code le code d'erreur
+ *
+ * \return une chaîne statique décrivant l'erreur
+ *//****************************************************************************/
+
+const char* formatterCodeErreur(CodeErreur p_code)
+{
+	static const char* MESSAGES[] =
+	{
+		"aucune erreur", "NAS invalide", "nom invalide", "prénom invalide", "date invalide",
+		"adresse invalide", "parti politique invalide", "personne invalide",
+		"personne déjà présente", "personne absente", "vote déjà enregistré"
+	};
+	static const int NB_MESSAGES = sizeof(MESSAGES) / sizeof(MESSAGES[0]);
+
+	PRECONDITION(p_code >= 0 and p_code < NB_MESSAGES);
+
+	return MESSAGES[p_code];
+}
+
+} // namespace util
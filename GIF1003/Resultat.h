@@ -0,0 +1,121 @@
+/**
+ * \file Resultat.h
+ *
+ * \brief Déclaration du gabarit Resultat et des codes d'erreur de validation.
+ *
+ * Un Resultat contient soit une valeur, soit un code d'erreur.  Il permet aux
+ * traitements en lot de recueillir les enregistrements invalides sans lancer
+ * d'exception.  Les méthodes qui lancent des exceptions sont bâties par-dessus.
+ *
+ *  Created on: 2020-12-13
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef RESULTAT_H_
+#define RESULTAT_H_
+
+#include "ContratException.h"
+
+#include <optional>
+#include <utility>
+
+namespace util
+{
+
+/**
+ * \enum CodeErreur
+ *
+ * Raison pour laquelle une opération n'a pu être effectuée
+ */
+
+enum CodeErreur {AUCUNE_ERREUR, NAS_INVALIDE, NOM_INVALIDE, PRENOM_INVALIDE, DATE_INVALIDE,
+	             ADRESSE_INVALIDE, PARTI_INVALIDE, PERSONNE_INVALIDE, PERSONNE_DEJA_PRESENTE,
+				 PERSONNE_ABSENTE, VOTE_DEJA_ENREGISTRE};
+
+const char* formatterCodeErreur(CodeErreur p_code);
+
+/**
+ * \struct DejaValide
+ *
+ * Étiquette des constructeurs et méthodes de confiance: l'appelant a déjà
+ * validé les données, par exemple au chargement d'un fichier ou dans une
+ * passe de validation en lot.  Ces chemins ne répètent pas la validation;
+ * seul un échantillon est vérifié par les contrats coûteux.
+ */
+
+struct DejaValide
+{
+	explicit DejaValide() = default;
+};
+
+constexpr DejaValide DEJA_VALIDE{};
+
+/**
+ * \class Resultat
+ *
+ * Valeur de type T, ou code d'erreur si la valeur n'a pu être produite.
+ */
+
+template <typename T>
+class Resultat
+{
+private:
+
+	std::optional<T> m_valeur;
+	CodeErreur       m_erreur;
+
+public:
+
+	Resultat(const T& p_valeur) : m_valeur(p_valeur), m_erreur(AUCUNE_ERREUR) {}
+	Resultat(T&& p_valeur) : m_valeur(std::move(p_valeur)), m_erreur(AUCUNE_ERREUR) {}
+	Resultat(CodeErreur p_erreur) : m_valeur(), m_erreur(p_erreur)
+	{
+		PRECONDITION(p_erreur != AUCUNE_ERREUR);
+	}
+
+	bool estValide() const { return m_erreur == AUCUNE_ERREUR; }
+	explicit operator bool() const { return estValide(); }
+
+	CodeErreur reqErreur() const { return m_erreur; }
+
+	const T& reqValeur() const
+	{
+		PRECONDITION(estValide());
+		return *m_valeur;
+	}
+
+	T& reqValeur()
+	{
+		PRECONDITION(estValide());
+		return *m_valeur;
+	}
+};
+
+/**
+ * \class Resultat<void>
+ *
+ * Spécialisation pour une opération qui ne produit pas de valeur: seul le code
+ * d'erreur est conservé.
+ */
+
+template <>
+class Resultat<void>
+{
+private:
+
+	CodeErreur m_erreur;
+
+public:
+
+	Resultat(CodeErreur p_erreur = AUCUNE_ERREUR) : m_erreur(p_erreur) {}
+
+	bool estValide() const { return m_erreur == AUCUNE_ERREUR; }
+	explicit operator bool() const { return estValide(); }
+
+	CodeErreur reqErreur() const { return m_erreur; }
+};
+
+} // namespace util
+
+#endif /* RESULTAT_H_ */
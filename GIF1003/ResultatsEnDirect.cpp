@@ -0,0 +1,140 @@
+/****************************************************************************//**
+ * \file ResultatsEnDirect.cpp
+ *
+ * \brief Implantation de la classe ResultatsEnDirect
+ *
+ *  Created on: 2020-12-19
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "ResultatsEnDirect.h"
+#include "ContratException.h"
+#include "VisiteurPersonne.h"
+
+#include <atomic>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Constructeur: aucun bureau n'a transmis
+ *
+ * \param[in] p_circonscription la circonscription; ses inscrits de type
+ * Candidat sont numérotés dans leur ordre d'inscription, comme pour
+ * DepouillementBulletins
+ * \param[in] p_nbBureaux nombre de bureaux de scrutin
+ *
+ * \pre p_nbBureaux > 0
+ *//****************************************************************************/
+
+ResultatsEnDirect::ResultatsEnDirect(const Circonscription& p_circonscription, std::size_t p_nbBureaux)
+: m_candidats(), m_rapports(p_nbBureaux), m_mutexTransmission(), m_instantane()
+{
+	PRECONDITION(p_nbBureaux > 0);
+
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		const Candidat* candidat = commeCandidat(**it);
+		if (candidat) m_candidats.push_back(*candidat);
+	}
+
+	std::shared_ptr<Instantane> initial = std::make_shared<Instantane>();
+	initial->voixParCandidat.assign(m_candidats.size(), 0);
+	initial->voixParParti.fill(0);
+	initial->nbBureauxRapportes = 0;
+	initial->version = 0;
+	m_instantane = initial;
+
+	INVARIANTS();
+}
+
+std::size_t ResultatsEnDirect::reqNbCandidats() const
+{
+	return m_candidats.size();
+}
+
+std::size_t ResultatsEnDirect::reqNbBureaux() const
+{
+	return m_rapports.size();
+}
+
+const Candidat& ResultatsEnDirect::reqCandidat(std::size_t p_indice) const
+{
+	PRECONDITION(p_indice < m_candidats.size());
+
+	return m_candidats[p_indice];
+}
+
+/****************************************************************************//**
+ * Enregistre le décompte d'un bureau.  Seul l'écart avec le décompte
+ * précédent du même bureau est appliqué aux totaux, puis un nouvel
+ * instantané est publié.
+ *
+ * \param[in] p_bureau le bureau qui transmet
+ * \param[in] p_voixParCandidat ses voix, dans l'ordre des candidats
+ *
+ * \return true si ce décompte remplace une transmission précédente du bureau
+ *
+ * \pre p_bureau existe, p_voixParCandidat a une entrée par candidat
+ *//****************************************************************************/
+
+bool ResultatsEnDirect::rapporter(std::size_t p_bureau, const std::vector<std::uint64_t>& p_voixParCandidat)
+{
+	PRECONDITION(p_bureau < m_rapports.size());
+	PRECONDITION(p_voixParCandidat.size() == m_candidats.size());
+
+	std::lock_guard<std::mutex> verrou(m_mutexTransmission);
+
+	std::vector<std::uint64_t>& precedent = m_rapports[p_bureau];
+	bool correction = !precedent.empty();
+	std::shared_ptr<Instantane> suivant = std::make_shared<Instantane>(*m_instantane);
+
+	if (!correction) precedent.assign(m_candidats.size(), 0);
+	for (std::size_t c = 0; c < m_candidats.size(); ++c)
+	{
+		std::uint64_t ecart = p_voixParCandidat[c] - precedent[c];
+		suivant->voixParCandidat[c] += ecart;
+		suivant->voixParParti[m_candidats[c].reqPartiPolitique()] += ecart;
+	}
+	precedent = p_voixParCandidat;
+	suivant->nbBureauxRapportes += correction ? 0 : 1;
+	++suivant->version;
+
+	std::atomic_store(&m_instantane, std::shared_ptr<const Instantane>(std::move(suivant)));
+
+	INVARIANTS();
+	return correction;
+}
+
+/****************************************************************************//**
+ * Enregistre le dépouillement d'un bureau fait par DepouillementBulletins sur
+ * la même circonscription
+ *//****************************************************************************/
+
+bool ResultatsEnDirect::rapporter(std::size_t p_bureau, const ResultatsDepouillement& p_depouillement)
+{
+	return rapporter(p_bureau, p_depouillement.voixParCandidat);
+}
+
+/****************************************************************************//**
+ * \return le dernier instantané publié.  Il reste valide et inchangé aussi
+ * longtemps que l'appelant le conserve.
+ *//****************************************************************************/
+
+std::shared_ptr<const ResultatsEnDirect::Instantane> ResultatsEnDirect::reqInstantane() const
+{
+	return std::atomic_load(&m_instantane);
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS(), pendant une transmission ou à la construction
+ *//****************************************************************************/
+
+void ResultatsEnDirect::verifieInvariant() const
+{
+	INVARIANT(!m_rapports.empty());
+	INVARIANT(m_instantane and m_instantane->voixParCandidat.size() == m_candidats.size());
+	INVARIANT(m_instantane->nbBureauxRapportes <= m_rapports.size());
+}
+
+} // namespace elections
@@ -0,0 +1,96 @@
+/**
+ * \file ResultatsEnDirect.h
+ *
+ * \brief Déclaration de la classe ResultatsEnDirect, qui cumule les résultats
+ * d'une circonscription à mesure que les bureaux de scrutin les transmettent.
+ *
+ *  Created on: 2020-12-19
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef RESULTATSENDIRECT_H_
+#define RESULTATSENDIRECT_H_
+
+#include "Candidat.h"
+#include "Circonscription.h"
+#include "DepouillementBulletins.h"
+#include "validationFormat.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class ResultatsEnDirect
+ *
+ * Chaque bureau de scrutin transmet le décompte partiel de ses voix, par
+ * candidat.  Un bureau peut transmettre de nouveau: son nouveau décompte
+ * remplace alors l'ancien, ce qui permet les corrections.  Les totaux ne sont
+ * jamais recalculés: seul l'écart entre l'ancien et le nouveau décompte du
+ * bureau leur est appliqué.
+ *
+ * Les lecteurs obtiennent un Instantane immuable, publié atomiquement après
+ * chaque transmission.  Un lecteur ne voit donc jamais un état à moitié mis à
+ * jour, et ne bloque pas les transmissions.  Les transmissions, elles, sont
+ * sérialisées entre elles.
+ *
+ *//*****************************************************************************/
+
+class ResultatsEnDirect
+{
+public:
+
+	/**
+	 * \struct Instantane
+	 *
+	 * État cohérent des résultats après un certain nombre de transmissions
+	 */
+
+	struct Instantane
+	{
+		std::vector<std::uint64_t>                 voixParCandidat;
+		std::array<std::uint64_t, util::NB_PARTIS> voixParParti;
+		std::size_t                                nbBureauxRapportes;
+		std::uint64_t                              version;
+	};
+
+	ResultatsEnDirect(const Circonscription& p_circonscription, std::size_t p_nbBureaux);
+
+	ResultatsEnDirect(const ResultatsEnDirect&) = delete;
+	ResultatsEnDirect& operator=(const ResultatsEnDirect&) = delete;
+
+	/* Candidats */
+
+	std::size_t reqNbCandidats() const;
+	std::size_t reqNbBureaux() const;
+	const Candidat& reqCandidat(std::size_t p_indice) const;
+
+	/* Transmissions */
+
+	bool rapporter(std::size_t p_bureau, const std::vector<std::uint64_t>& p_voixParCandidat);
+	bool rapporter(std::size_t p_bureau, const ResultatsDepouillement& p_depouillement);
+
+	/* Lecture */
+
+	std::shared_ptr<const Instantane> reqInstantane() const;
+
+private:
+
+	void verifieInvariant() const;
+
+	std::vector<Candidat>                    m_candidats;
+	std::vector<std::vector<std::uint64_t>>  m_rapports;
+	std::mutex                               m_mutexTransmission;
+	std::shared_ptr<const Instantane>        m_instantane;
+};
+
+} // namespace elections
+
+#endif /* RESULTATSENDIRECT_H_ */
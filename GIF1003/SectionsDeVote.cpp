@@ -0,0 +1,266 @@
+/****************************************************************************//**
+ * \file SectionsDeVote.cpp
+ *
+ * \brief Implantation de la classe SectionsDeVote
+ *
+ *  Created on: 2020-12-26
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "SectionsDeVote.h"
+#include "BassinDeTaches.h"
+#include "CodePostal.h"
+#include "ContratException.h"
+#include "IndexAlphabetique.h"
+#include "VisiteurPersonne.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <sstream>
+#include <utility>
+
+using util::CodePostal;
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Adresse d'un inscrit réduite à sa clé de tri: le code postal compact (0 hors
+ * du Canada), la rue et le numéro civique
+ *//****************************************************************************/
+
+struct PlaceAdresse
+{
+	std::uint32_t   code;
+	std::string     rue;
+	int             numero;
+	const Personne* inscrit;
+
+	bool precede(const PlaceAdresse& p_place) const
+	{
+		if (code != p_place.code) return code < p_place.code;
+		if (rue != p_place.rue) return rue < p_place.rue;
+		return numero < p_place.numero;
+	}
+
+	bool memeAdresse(const PlaceAdresse& p_place) const
+	{
+		return code == p_place.code and numero == p_place.numero and rue == p_place.rue;
+	}
+};
+
+/****************************************************************************//**
+ * Découpe une circonscription en sections de vote
+ *
+ * \param[in] p_circonscription la circonscription découpée
+ * \param[in] p_nbSections le nombre de sections; certaines sont vides s'il y a
+ * moins d'adresses que de sections, et ce sont alors les dernières
+ * \param[in] p_bassin le bassin qui trie les listes alphabétiques, une tâche
+ * par section; nullptr pour les trier dans le fil appelant
+ *
+ * \pre p_nbSections > 0
+ *//****************************************************************************/
+
+SectionsDeVote::SectionsDeVote(const Circonscription& p_circonscription, std::size_t p_nbSections,
+                               util::BassinDeTaches* p_bassin)
+: m_nomCirconscription(p_circonscription.reqNomCirconscription()), m_debuts(), m_parAdresse(), m_parNom()
+{
+	PRECONDITION(p_nbSections > 0);
+
+	const std::size_t nbInscrits = p_circonscription.reqNbInscrits();
+	std::vector<std::size_t> debutsRegions(CodePostal::NB_REGIONS_TRI + 2, 0);
+	std::vector<std::uint32_t> codes;
+	codes.reserve(nbInscrits);
+
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		CodePostal code = (*it)->reqAdresse().reqCodePostalCompact();
+		codes.push_back(code.reqValeur());
+		++debutsRegions[code.estValide() ? code.reqRegionTri() + 2 : 1];
+	}
+	for (std::size_t r = 1; r < debutsRegions.size(); ++r) debutsRegions[r] += debutsRegions[r - 1];
+
+	std::vector<PlaceAdresse> places(nbInscrits);
+	std::vector<std::size_t> prochaines(debutsRegions.begin(), debutsRegions.end() - 1);
+	std::size_t i = 0;
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it, ++i)
+	{
+		const util::Adresse& adresse = (*it)->reqAdresse();
+		std::size_t region = codes[i] ? (codes[i] - 1) / CodePostal::NB_UNITES + 1 : 0;
+		places[prochaines[region]++] = PlaceAdresse{codes[i], adresse.reqNomRue(), adresse.reqNumeroCivic(), *it};
+	}
+
+	auto parAdresse = [](const PlaceAdresse& a, const PlaceAdresse& b) { return a.precede(b); };
+	for (std::size_t r = 0; r + 1 < debutsRegions.size(); ++r)
+	{
+		if (debutsRegions[r + 1] - debutsRegions[r] > 1)
+			std::stable_sort(places.begin() + debutsRegions[r], places.begin() + debutsRegions[r + 1], parAdresse);
+	}
+
+	auto estFrontiere = [&places, nbInscrits](std::size_t p_position)
+	{
+		return p_position == 0 or p_position == nbInscrits or !places[p_position - 1].memeAdresse(places[p_position]);
+	};
+
+	m_debuts.push_back(0);
+	for (std::size_t s = 1; s < p_nbSections; ++s)
+	{
+		std::size_t precedente = m_debuts.back();
+		std::size_t cible = std::max(precedente, s * nbInscrits / p_nbSections);
+		std::size_t avant = cible;
+		std::size_t apres = std::min(std::max(cible, precedente + 1), nbInscrits);
+
+		while (avant > precedente and !estFrontiere(avant)) --avant;
+		while (apres < nbInscrits and !estFrontiere(apres)) ++apres;
+		m_debuts.push_back(avant > precedente and cible - avant <= apres - cible ? avant : apres);
+	}
+	m_debuts.push_back(nbInscrits);
+
+	m_parAdresse.reserve(nbInscrits);
+	for (const PlaceAdresse& place: places) m_parAdresse.push_back(place.inscrit);
+	m_parNom = m_parAdresse;
+
+	std::vector<std::future<void>> taches;
+	for (std::size_t s = 0; s < p_nbSections; ++s)
+	{
+		auto trier = [this, debut = m_debuts[s], fin = m_debuts[s + 1]]()
+		{
+			std::vector<std::pair<std::string, const Personne*>> cles;
+			cles.reserve(fin - debut);
+			for (std::size_t j = debut; j < fin; ++j) cles.emplace_back(cleAlphabetique(*m_parNom[j]), m_parNom[j]);
+			std::sort(cles.begin(), cles.end());
+			for (std::size_t j = debut; j < fin; ++j) m_parNom[j] = cles[j - debut].second;
+		};
+		if (p_bassin and m_debuts[s + 1] - m_debuts[s] > 1)
+		{
+			taches.push_back(p_bassin->soumettre(trier));
+			continue;
+		}
+		try
+		{
+			trier();
+		}
+		catch (...)
+		{
+			util::attendreToutes(taches);
+			throw;
+		}
+	}
+	util::attendreToutes(taches);
+	for (std::future<void>& tache: taches) tache.get();
+
+	POSTCONDITION(m_parAdresse.size() == nbInscrits);
+	INVARIANTS();
+}
+
+std::size_t SectionsDeVote::reqNbSections() const
+{
+	return m_debuts.size() - 1;
+}
+
+std::size_t SectionsDeVote::reqNbInscrits(std::size_t p_section) const
+{
+	PRECONDITION(p_section < reqNbSections());
+
+	return m_debuts[p_section + 1] - m_debuts[p_section];
+}
+
+/****************************************************************************//**
+ * \return la première adresse de la section, dans l'ordre (code postal, rue,
+ * numéro civique)
+ *
+ * \pre la section n'est pas vide
+ *//****************************************************************************/
+
+const util::Adresse& SectionsDeVote::reqPremiereAdresse(std::size_t p_section) const
+{
+	PRECONDITION(p_section < reqNbSections() and reqNbInscrits(p_section) > 0);
+
+	return m_parAdresse[m_debuts[p_section]]->reqAdresse();
+}
+
+const util::Adresse& SectionsDeVote::reqDerniereAdresse(std::size_t p_section) const
+{
+	PRECONDITION(p_section < reqNbSections() and reqNbInscrits(p_section) > 0);
+
+	return m_parAdresse[m_debuts[p_section + 1] - 1]->reqAdresse();
+}
+
+/****************************************************************************//**
+ * Les inscrits d'une section dans l'ordre des adresses
+ *//****************************************************************************/
+
+SectionsDeVote::Iterateur_t SectionsDeVote::reqDebutParAdresse(std::size_t p_section) const
+{
+	PRECONDITION(p_section < reqNbSections());
+
+	return m_parAdresse.begin() + m_debuts[p_section];
+}
+
+SectionsDeVote::Iterateur_t SectionsDeVote::reqFinParAdresse(std::size_t p_section) const
+{
+	PRECONDITION(p_section < reqNbSections());
+
+	return m_parAdresse.begin() + m_debuts[p_section + 1];
+}
+
+/****************************************************************************//**
+ * Les inscrits d'une section dans l'ordre alphabétique, celui de la liste
+ * imprimée
+ *//****************************************************************************/
+
+SectionsDeVote::Iterateur_t SectionsDeVote::reqDebutListe(std::size_t p_section) const
+{
+	PRECONDITION(p_section < reqNbSections());
+
+	return m_parNom.begin() + m_debuts[p_section];
+}
+
+SectionsDeVote::Iterateur_t SectionsDeVote::reqFinListe(std::size_t p_section) const
+{
+	PRECONDITION(p_section < reqNbSections());
+
+	return m_parNom.begin() + m_debuts[p_section + 1];
+}
+
+/****************************************************************************//**
+ * Liste imprimable d'un bureau de vote: la circonscription, le numéro de la
+ * section, puis ses inscrits dans l'ordre alphabétique, formatés comme dans
+ * Circonscription::reqCirconscriptionFormate()
+ *
+ * \param[in] p_section le numéro de la section, à partir de 0
+ *//****************************************************************************/
+
+std::string SectionsDeVote::reqListeFormatee(std::size_t p_section) const
+{
+	PRECONDITION(p_section < reqNbSections());
+
+	static const char ret = '\n';
+	std::ostringstream os;
+
+	os << "Circonscription: " << m_nomCirconscription << ret;
+	os << "Section de vote: " << p_section + 1 << " de " << reqNbSections() << ret << ret;
+	if (reqNbInscrits(p_section) == 0)
+	{
+		os << "Liste vide";
+	}
+	for (Iterateur_t it = reqDebutListe(p_section); it != reqFinListe(p_section); ++it)
+	{
+		os << formaterPersonne(**it) << ret << ret;
+	}
+	return os.str();
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS()
+ *//****************************************************************************/
+
+void SectionsDeVote::verifieInvariant() const
+{
+	INVARIANT(m_debuts.size() >= 2 and m_debuts.front() == 0 and m_debuts.back() == m_parAdresse.size());
+	INVARIANT(std::is_sorted(m_debuts.begin(), m_debuts.end()));
+	INVARIANT(m_parNom.size() == m_parAdresse.size());
+}
+
+} // namespace elections
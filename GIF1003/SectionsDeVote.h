@@ -0,0 +1,85 @@
+/**
+ * \file SectionsDeVote.h
+ *
+ * \brief Déclaration de la classe SectionsDeVote, qui découpe les inscrits
+ * d'une circonscription en sections de vote, une liste par bureau.
+ *
+ *  Created on: 2020-12-26
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef SECTIONSDEVOTE_H_
+#define SECTIONSDEVOTE_H_
+
+#include "Adresse.h"
+#include "Circonscription.h"
+#include "Personne.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace util
+{
+class BassinDeTaches;
+}
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class SectionsDeVote
+ *
+ * Les inscrits d'une circonscription répartis en N sections de vote de tailles
+ * voisines.  Chaque section est un intervalle d'adresses dans l'ordre (code
+ * postal, rue, numéro civique): les voisins votent au même bureau, et une même
+ * adresse n'est jamais partagée entre deux sections.  Les adresses hors du
+ * Canada forment le début de l'ordre.
+ *
+ * Les inscrits sont d'abord placés par un tri par dénombrement sur la région
+ * de tri du code postal, en un seul parcours, puis triés par adresse à
+ * l'intérieur de chaque région.  Les coupures sont placées à la frontière
+ * d'adresses la plus proche de k * n / N.  La liste alphabétique de chaque
+ * section (voir cleAlphabetique()) est ensuite triée, une tâche par section.
+ *
+ * Le découpage reflète la circonscription au moment de la construction, et ne
+ * doit pas survivre aux inscrits qu'il désigne.
+ *
+ *//*****************************************************************************/
+
+class SectionsDeVote
+{
+public:
+
+	typedef std::vector<const Personne*>::const_iterator Iterateur_t;
+
+	SectionsDeVote(const Circonscription& p_circonscription, std::size_t p_nbSections,
+	               util::BassinDeTaches* p_bassin = nullptr);
+
+	std::size_t reqNbSections() const;
+	std::size_t reqNbInscrits(std::size_t p_section) const;
+
+	const util::Adresse& reqPremiereAdresse(std::size_t p_section) const;
+	const util::Adresse& reqDerniereAdresse(std::size_t p_section) const;
+
+	Iterateur_t reqDebutParAdresse(std::size_t p_section) const;
+	Iterateur_t reqFinParAdresse(std::size_t p_section) const;
+	Iterateur_t reqDebutListe(std::size_t p_section) const;
+	Iterateur_t reqFinListe(std::size_t p_section) const;
+
+	std::string reqListeFormatee(std::size_t p_section) const;
+
+private:
+
+	void verifieInvariant() const;
+
+	std::string                   m_nomCirconscription;
+	std::vector<std::size_t>      m_debuts;
+	std::vector<const Personne*>  m_parAdresse;
+	std::vector<const Personne*>  m_parNom;
+};
+
+} // namespace elections
+
+#endif /* SECTIONSDEVOTE_H_ */
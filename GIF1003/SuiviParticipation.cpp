@@ -0,0 +1,198 @@
+/****************************************************************************//**
+ * \file SuiviParticipation.cpp
+ *
+ * \brief Implantation de la classe SuiviParticipation
+ *
+ *  Created on: 2020-12-18
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "SuiviParticipation.h"
+#include "ContratException.h"
+#include "validationFormat.h"
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Attribue les identifiants et les bureaux de scrutin
+ *
+ * \param[in] p_circonscription la circonscription suivie
+ * \param[in] p_nbBureaux nombre de bureaux de scrutin
+ * \param[in] p_repartition donne le bureau de chaque inscrit, entre 0 et
+ * p_nbBureaux - 1; par défaut, tous les inscrits votent au bureau 0
+ *
+ * \pre p_nbBureaux > 0
+ * \pre p_repartition retourne un bureau existant pour chaque inscrit
+ *//****************************************************************************/
+
+SuiviParticipation::SuiviParticipation(const Circonscription& p_circonscription, std::size_t p_nbBureaux,
+                                       const Repartition_t& p_repartition)
+: m_nomCirconscription(p_circonscription.reqNomCirconscription()),
+  m_identifiants(),
+  m_bureaux(),
+  m_nbMots((p_circonscription.reqNbInscrits() + 63) / 64),
+  m_aVote(new std::atomic<std::uint64_t>[(p_circonscription.reqNbInscrits() + 63) / 64]),
+  m_nbBureaux(p_nbBureaux),
+  m_compteurs(new Compteur[p_nbBureaux])
+{
+	PRECONDITION(p_nbBureaux > 0);
+
+	m_identifiants.reserver(p_circonscription.reqNbInscrits());
+	m_bureaux.reserve(p_circonscription.reqNbInscrits());
+	for (std::size_t i = 0; i < m_nbMots; ++i) m_aVote[i].store(0, std::memory_order_relaxed);
+
+	for (auto it = p_circonscription.reqDebutInscrits(); it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		std::size_t bureau = p_repartition ? p_repartition(**it) : 0;
+		PRECONDITION(bureau < p_nbBureaux);
+
+		m_identifiants.inserer(util::compacterNas((*it)->reqNas()), static_cast<std::uint32_t>(m_bureaux.size()));
+		m_bureaux.push_back(static_cast<std::uint32_t>(bureau));
+		++m_compteurs[bureau].nbInscrits;
+	}
+
+	POSTCONDITION(m_bureaux.size() == p_circonscription.reqNbInscrits());
+	INVARIANTS();
+}
+
+const std::string& SuiviParticipation::reqNomCirconscription() const
+{
+	return m_nomCirconscription;
+}
+
+/****************************************************************************//**
+ * \return l'identifiant dense d'un inscrit, PERSONNE_ABSENTE s'il n'était pas
+ * inscrit à la construction, NAS_INVALIDE si le NAS est mal formé
+ *//****************************************************************************/
+
+util::Resultat<std::uint32_t> SuiviParticipation::reqIdentifiant(const std::string& p_nas) const
+{
+	if (!util::validerNas(p_nas))
+		return util::NAS_INVALIDE;
+
+	const std::uint32_t* identifiant = m_identifiants.trouver(util::compacterNas(p_nas));
+	if (!identifiant)
+		return util::PERSONNE_ABSENTE;
+	return *identifiant;
+}
+
+/****************************************************************************//**
+ * \return le bureau de scrutin d'un inscrit
+ *//****************************************************************************/
+
+std::size_t SuiviParticipation::reqBureau(std::uint32_t p_identifiant) const
+{
+	PRECONDITION(p_identifiant < m_bureaux.size());
+
+	return m_bureaux[p_identifiant];
+}
+
+/****************************************************************************//**
+ * Enregistre le vote d'un électeur désigné par son NAS
+ *
+ * \return NAS_INVALIDE, PERSONNE_ABSENTE ou VOTE_DEJA_ENREGISTRE si le vote
+ * est refusé
+ *//****************************************************************************/
+
+util::Resultat<void> SuiviParticipation::enregistrerVote(const std::string& p_nas)
+{
+	util::Resultat<std::uint32_t> identifiant = reqIdentifiant(p_nas);
+
+	if (!identifiant)
+		return identifiant.reqErreur();
+	return enregistrerVote(identifiant.reqValeur());
+}
+
+/****************************************************************************//**
+ * Enregistre le vote d'un électeur désigné par son identifiant.  Un seul
+ * fetch_or atomique marque le vote et révèle un vote antérieur: de deux fils
+ * qui enregistrent le même électeur en même temps, un seul réussit.
+ *
+ * \return VOTE_DEJA_ENREGISTRE si l'électeur a déjà voté
+ *//****************************************************************************/
+
+util::Resultat<void> SuiviParticipation::enregistrerVote(std::uint32_t p_identifiant)
+{
+	PRECONDITION(p_identifiant < m_bureaux.size());
+
+	std::uint64_t masque = std::uint64_t(1) << (p_identifiant % 64);
+	std::uint64_t precedent = m_aVote[p_identifiant / 64].fetch_or(masque, std::memory_order_relaxed);
+
+	if (precedent & masque)
+		return util::VOTE_DEJA_ENREGISTRE;
+
+	m_compteurs[m_bureaux[p_identifiant]].nbVotants.fetch_add(1, std::memory_order_relaxed);
+	return util::AUCUNE_ERREUR;
+}
+
+/****************************************************************************//**
+ * \return true si l'électeur a voté
+ *//****************************************************************************/
+
+bool SuiviParticipation::aVote(std::uint32_t p_identifiant) const
+{
+	PRECONDITION(p_identifiant < m_bureaux.size());
+
+	return m_aVote[p_identifiant / 64].load(std::memory_order_relaxed) & (std::uint64_t(1) << (p_identifiant % 64));
+}
+
+std::size_t SuiviParticipation::reqNbBureaux() const
+{
+	return m_nbBureaux;
+}
+
+std::size_t SuiviParticipation::reqNbInscrits() const
+{
+	return m_bureaux.size();
+}
+
+std::size_t SuiviParticipation::reqNbInscrits(std::size_t p_bureau) const
+{
+	PRECONDITION(p_bureau < m_nbBureaux);
+
+	return m_compteurs[p_bureau].nbInscrits;
+}
+
+/****************************************************************************//**
+ * \return le nombre de votants de la circonscription.  Pendant le scrutin, la
+ * somme des bureaux est lue sans verrou: elle peut omettre un vote en cours
+ * d'enregistrement, jamais en compter un de trop.
+ *//****************************************************************************/
+
+std::size_t SuiviParticipation::reqNbVotants() const
+{
+	std::size_t total = 0;
+	for (std::size_t b = 0; b < m_nbBureaux; ++b)
+		total += m_compteurs[b].nbVotants.load(std::memory_order_relaxed);
+	return total;
+}
+
+std::size_t SuiviParticipation::reqNbVotants(std::size_t p_bureau) const
+{
+	PRECONDITION(p_bureau < m_nbBureaux);
+
+	return m_compteurs[p_bureau].nbVotants.load(std::memory_order_relaxed);
+}
+
+/****************************************************************************//**
+ * \return la proportion des inscrits qui ont voté, entre 0 et 1
+ *//****************************************************************************/
+
+double SuiviParticipation::reqTauxParticipation() const
+{
+	return m_bureaux.empty() ? 0.0 : static_cast<double>(reqNbVotants()) / m_bureaux.size();
+}
+
+/****************************************************************************//**
+ * Appelé par la macro INVARIANTS()
+ *//****************************************************************************/
+
+void SuiviParticipation::verifieInvariant() const
+{
+	INVARIANT(m_nbBureaux > 0);
+	INVARIANT(m_identifiants.reqNbElements() == m_bureaux.size());
+	INVARIANT(m_nbMots * 64 >= m_bureaux.size());
+}
+
+} // namespace elections
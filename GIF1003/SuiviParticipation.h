@@ -0,0 +1,111 @@
+/**
+ * \file SuiviParticipation.h
+ *
+ * \brief Déclaration de la classe SuiviParticipation, qui enregistre le jour du
+ * scrutin les électeurs qui ont voté.
+ *
+ *  Created on: 2020-12-18
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef SUIVIPARTICIPATION_H_
+#define SUIVIPARTICIPATION_H_
+
+#include "Circonscription.h"
+#include "IndexNas.h"
+#include "Resultat.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class SuiviParticipation
+ *
+ * Suivi de la participation d'une circonscription: « a voté ».
+ *
+ * À la construction, chaque inscrit reçoit un identifiant dense, de 0 à n - 1,
+ * et un bureau de scrutin.  Après la construction, l'index des NAS n'est plus
+ * modifié: plusieurs fils peuvent donc le consulter sans verrou.  Un vote
+ * positionne le bit de l'électeur dans un tableau de bits atomiques; le
+ * fetch_or dit du même coup si le bit l'était déjà, ce qui refuse un double
+ * vote en temps constant, sans verrou.  Un compteur atomique par bureau donne
+ * la participation en temps réel.
+ *
+ * La liste des inscrits est celle de la circonscription au moment de la
+ * construction: les inscriptions ultérieures ne sont pas suivies.
+ *
+ *//*****************************************************************************/
+
+class SuiviParticipation
+{
+public:
+
+	/**
+	 * \type Repartition_t Donne le bureau de scrutin d'un inscrit
+	 */
+
+	typedef std::function<std::size_t(const Personne&)> Repartition_t;
+
+	explicit SuiviParticipation(const Circonscription& p_circonscription, std::size_t p_nbBureaux = 1,
+	                            const Repartition_t& p_repartition = Repartition_t());
+
+	SuiviParticipation(const SuiviParticipation&) = delete;
+	SuiviParticipation& operator=(const SuiviParticipation&) = delete;
+
+	/* Identification */
+
+	const std::string& reqNomCirconscription() const;
+	util::Resultat<std::uint32_t> reqIdentifiant(const std::string& p_nas) const;
+	std::size_t reqBureau(std::uint32_t p_identifiant) const;
+
+	/* Enregistrement, sans verrou */
+
+	util::Resultat<void> enregistrerVote(const std::string& p_nas);
+	util::Resultat<void> enregistrerVote(std::uint32_t p_identifiant);
+	bool aVote(std::uint32_t p_identifiant) const;
+
+	/* Participation en temps réel */
+
+	std::size_t reqNbBureaux() const;
+	std::size_t reqNbInscrits() const;
+	std::size_t reqNbInscrits(std::size_t p_bureau) const;
+	std::size_t reqNbVotants() const;
+	std::size_t reqNbVotants(std::size_t p_bureau) const;
+	double reqTauxParticipation() const;
+
+private:
+
+	/**
+	 * Compteur d'un bureau, seul sur sa ligne de cache pour que les bureaux
+	 * ne se ralentissent pas mutuellement
+	 */
+
+	struct alignas(64) Compteur
+	{
+		std::atomic<std::size_t> nbVotants{0};
+		std::size_t              nbInscrits = 0;
+	};
+
+	void verifieInvariant() const;
+
+	std::string                                 m_nomCirconscription;
+	util::IndexNas<std::uint32_t>               m_identifiants;
+	std::vector<std::uint32_t>                  m_bureaux;
+	std::size_t                                 m_nbMots;
+	std::unique_ptr<std::atomic<std::uint64_t>[]> m_aVote;
+	std::size_t                                 m_nbBureaux;
+	std::unique_ptr<Compteur[]>                 m_compteurs;
+};
+
+} // namespace elections
+
+#endif /* SUIVIPARTICIPATION_H_ */
@@ -0,0 +1,117 @@
+/****************************************************************************//**
+ * \file VisiteurPersonne.cpp
+ *
+ * \brief Validation et formatage d'une Personne par visite de son type concret
+ *
+ *  Created on: 2020-12-23
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "VisiteurPersonne.h"
+
+#include <type_traits>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Conversion vérifiée par le type, sans dynamic_cast
+ *
+ * \return le candidat, ou nullptr si p_personne n'est pas un Candidat
+ *//****************************************************************************/
+
+const Candidat* commeCandidat(const Personne& p_personne)
+{
+	return p_personne.reqType() == TypePersonne::CANDIDAT ? static_cast<const Candidat*>(&p_personne) : nullptr;
+}
+
+/****************************************************************************//**
+ * Copie une personne dans l'espace d'une ressource mémoire: une seule
+ * allocation, à la taille exacte du type concret.
+ *
+ * \param[in] p_personne la personne à copier
+ * \param[in] p_ressource la ressource qui fournit l'espace; nullptr pour
+ * l'allocation habituelle par clone()
+ *
+ * \return la copie, à libérer par detruirePersonne() avec la même ressource
+ *//****************************************************************************/
+
+Personne* clonerPersonne(const Personne& p_personne, std::pmr::memory_resource* p_ressource)
+{
+	if (p_ressource == nullptr)
+		return p_personne.clone();
+
+	return visiter(p_personne, [p_ressource](const auto& p) -> Personne*
+	{
+		typedef std::decay_t<decltype(p)> Type_t;
+
+		if constexpr (std::is_same<Type_t, Personne>::value)
+		{
+			return p.clone();
+		}
+		else
+		{
+			void* espace = p_ressource->allocate(sizeof(Type_t), alignof(Type_t));
+			try
+			{
+				return new (espace) Type_t(p);
+			}
+			catch (...)
+			{
+				p_ressource->deallocate(espace, sizeof(Type_t), alignof(Type_t));
+				throw;
+			}
+		}
+	});
+}
+
+/****************************************************************************//**
+ * Détruit une personne copiée par clonerPersonne().  Une classe hors du modèle
+ * a été allouée par clone() et est libérée par delete.
+ *
+ * \param[in] p_personne la personne à détruire; peut être nullptr
+ * \param[in] p_ressource la ressource passée à clonerPersonne()
+ *//****************************************************************************/
+
+void detruirePersonne(Personne* p_personne, std::pmr::memory_resource* p_ressource)
+{
+	if (p_personne == nullptr or p_ressource == nullptr or p_personne->reqType() == TypePersonne::AUTRE)
+	{
+		delete p_personne;
+		return;
+	}
+
+	visiter(*p_personne, [p_ressource](const auto& p)
+	{
+		typedef std::decay_t<decltype(p)> Type_t;
+
+		if constexpr (!std::is_same<Type_t, Personne>::value)
+		{
+			Type_t* objet = const_cast<Type_t*>(&p);
+			objet->~Type_t();
+			p_ressource->deallocate(objet, sizeof(Type_t), alignof(Type_t));
+		}
+	});
+}
+
+/****************************************************************************//**
+ * Équivalent de p_personne.valider(), sans appel virtuel pour un électeur ou
+ * un candidat
+ *//****************************************************************************/
+
+bool validerPersonne(const Personne& p_personne)
+{
+	return visiter(p_personne, [](const auto& p) { return p.valider(); });
+}
+
+/****************************************************************************//**
+ * Équivalent de p_personne.reqPersonneFormate(), sans appel virtuel pour un
+ * électeur ou un candidat
+ *//****************************************************************************/
+
+std::string formaterPersonne(const Personne& p_personne)
+{
+	return visiter(p_personne, [](const auto& p) { return p.reqPersonneFormate(); });
+}
+
+} // namespace elections
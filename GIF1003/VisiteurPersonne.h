@@ -0,0 +1,66 @@
+/**
+ * \file VisiteurPersonne.h
+ *
+ * \brief Déclaration de la visite d'une Personne selon son type concret, sans
+ * appel virtuel.
+ *
+ * Electeur et Candidat sont les seules classes concrètes du modèle, et elles
+ * sont finales: une fois le type connu par Personne::reqType(), chaque appel
+ * sur l'objet converti est un appel direct, que le compilateur peut étendre en
+ * ligne.  Une classe dérivée hors du modèle (TypePersonne::AUTRE) est visitée
+ * comme une Personne, par les appels virtuels habituels.
+ *
+ *  Created on: 2020-12-23
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef VISITEURPERSONNE_H_
+#define VISITEURPERSONNE_H_
+
+#include "Candidat.h"
+#include "Electeur.h"
+#include "Personne.h"
+
+#include <memory_resource>
+#include <string>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Appelle p_visiteur avec la personne convertie en son type concret
+ *
+ * \param[in] p_personne la personne visitée
+ * \param[in] p_visiteur un objet appelable avec un const Electeur&, un
+ * const Candidat& et un const Personne&, qui retourne le même type dans les
+ * trois cas
+ *
+ * \return ce que retourne p_visiteur
+ *//****************************************************************************/
+
+template <typename Visiteur>
+decltype(auto) visiter(const Personne& p_personne, Visiteur&& p_visiteur)
+{
+	switch (p_personne.reqType())
+	{
+	case TypePersonne::ELECTEUR:
+		return p_visiteur(static_cast<const Electeur&>(p_personne));
+	case TypePersonne::CANDIDAT:
+		return p_visiteur(static_cast<const Candidat&>(p_personne));
+	default:
+		return p_visiteur(p_personne);
+	}
+}
+
+const Candidat* commeCandidat(const Personne& p_personne);
+
+Personne* clonerPersonne(const Personne& p_personne, std::pmr::memory_resource* p_ressource);
+void detruirePersonne(Personne* p_personne, std::pmr::memory_resource* p_ressource);
+
+bool validerPersonne(const Personne& p_personne);
+std::string formaterPersonne(const Personne& p_personne);
+
+} // namespace elections
+
+#endif /* VISITEURPERSONNE_H_ */
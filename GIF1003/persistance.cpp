@@ -0,0 +1,364 @@
+/****************************************************************************//**
+ * \file persistance.cpp
+ *
+ * \brief Sauvegarde et récupération d'une Circonscription dans un flux texte
+ *
+ *  Created on: 2020-12-12
+ *  \author Pascal Charpentier
+ *//****************************************************************************/
+
+#include "persistance.h"
+#include "Candidat.h"
+#include "Electeur.h"
+#include "validationFormat.h"
+#include "VisiteurPersonne.h"
+
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * Constantes du format de fichier
+ *//****************************************************************************/
+
+static const std::string SEPARATEUR_ADRESSE = ", ";
+static const std::size_t NB_CHAMPS_ADRESSE = 5;
+static const std::size_t LONGUEUR_MAX_NUMERO = 9;
+static const unsigned int PERIODE_SUIVI = 256;
+
+/****************************************************************************//**
+ * Constructeur: aucune progression, aucune annulation demandée
+ *//****************************************************************************/
+
+SuiviTraitement::SuiviTraitement() : m_progression(0), m_annulation(false)
+{
+}
+
+/****************************************************************************//**
+ * Publie l'avancement courant du traitement
+ *
+ * \param[in] p_progression nombre d'unités traitées jusqu'ici
+ *//****************************************************************************/
+
+void SuiviTraitement::asgProgression(long long p_progression)
+{
+	m_progression.store(p_progression, std::memory_order_relaxed);
+}
+
+/****************************************************************************//**
+ * \return le dernier avancement publié
+ *//****************************************************************************/
+
+long long SuiviTraitement::reqProgression() const
+{
+	return m_progression.load(std::memory_order_relaxed);
+}
+
+/****************************************************************************//**
+ * Demande l'arrêt du traitement.  Celui-ci s'arrête à la fin du bloc en cours.
+ *//****************************************************************************/
+
+void SuiviTraitement::annuler()
+{
+	m_annulation.store(true);
+}
+
+/****************************************************************************//**
+ * \return true si l'annulation a été demandée
+ *//****************************************************************************/
+
+bool SuiviTraitement::estAnnule() const
+{
+	return m_annulation.load();
+}
+
+/****************************************************************************//**
+ * Écrit le bloc d'une personne: NAS, nom, prénom, date JJ MM AAAA et adresse.
+ * Un candidat est précédé de la ligne de son parti politique.
+ *
+ * \param[in] p_os flux de sortie
+ * \param[in] p_personne électeur ou candidat à écrire
+ *//****************************************************************************/
+
+void ecrirePersonne(std::ostream& p_os, const Personne& p_personne)
+{
+	const Candidat* candidat = commeCandidat(p_personne);
+	const util::Date& date = p_personne.reqDateNaissance();
+
+	if (candidat)
+	{
+		p_os << Candidat::formatterPartiPolitique(candidat->reqPartiPolitique()) << '\n';
+	}
+	p_os << p_personne.reqNas() << '\n';
+	p_os << p_personne.reqNom() << '\n';
+	p_os << p_personne.reqPrenom() << '\n';
+	p_os << std::setfill('0') << std::setw(2) << date.reqJour() << ' '
+	     << std::setw(2) << date.reqMois() << ' ' << date.reqAnnee() << '\n';
+	p_os << p_personne.reqAdresse().reqAdresseFormatee() << '\n';
+}
+
+/****************************************************************************//**
+ * Écrit une circonscription complète dans un flux, au format de
+ * util::validerFormatFichier().
+ *
+ * \param[in] p_os flux de sortie
+ * \param[in] p_circonscription la circonscription à sauvegarder
+ * \param[in,out] p_suivi suivi optionnel: reçoit le nombre d'inscrits écrits
+ *
+ * \return false si le traitement a été annulé ou si le flux est en erreur
+ *//****************************************************************************/
+
+bool sauvegarderCirconscription(std::ostream& p_os, const Circonscription& p_circonscription, SuiviTraitement* p_suivi)
+{
+	bool annule = false;
+	long long nbEcrits = 0;
+
+	p_os << p_circonscription.reqNomCirconscription() << '\n';
+	ecrirePersonne(p_os, p_circonscription.reqDeputeElu());
+
+	for (auto it = p_circonscription.reqDebutInscrits(); !annule and it != p_circonscription.reqFinInscrits(); ++it)
+	{
+		ecrirePersonne(p_os, **it);
+		++nbEcrits;
+		if (p_suivi and (nbEcrits % PERIODE_SUIVI == 0))
+		{
+			p_suivi->asgProgression(nbEcrits);
+			annule = p_suivi->estAnnule();
+		}
+	}
+	if (p_suivi) p_suivi->asgProgression(nbEcrits);
+	p_os.flush();
+
+	return !annule and p_os.good();
+}
+
+/****************************************************************************//**
+ * \class LecteurDeLignes
+ *
+ * Lit les lignes d'un flux en comptant leur numéro, pour les messages d'erreur.
+ *//****************************************************************************/
+
+class LecteurDeLignes
+{
+public:
+	LecteurDeLignes(std::istream& p_is) : m_is(p_is), m_numero(0) {}
+
+	bool lire(std::string& p_ligne)
+	{
+		if (!std::getline(m_is, p_ligne)) return false;
+		if (!p_ligne.empty() and p_ligne.back() == '\r') p_ligne.pop_back();
+		++m_numero;
+		return true;
+	}
+
+	std::string lireObligatoire()
+	{
+		std::string ligne;
+		if (!lire(ligne)) erreur("bloc incomplet");
+		return ligne;
+	}
+
+	void erreur(const std::string& p_raison) const
+	{
+		throw FormatFichierException("ligne " + std::to_string(m_numero) + ": " + p_raison);
+	}
+
+	long long reqPosition() const
+	{
+		return static_cast<long long>(m_is.tellg());
+	}
+
+private:
+	std::istream& m_is;
+	unsigned int  m_numero;
+};
+
+/****************************************************************************//**
+ * Convertit la ligne d'un parti politique en constante PartisPolitiques
+ *//****************************************************************************/
+
+static PartisPolitiques analyserParti(const std::string& p_ligne)
+{
+	std::size_t i = 0;
+	while (i < util::NB_PARTIS and util::PARTIS_POLITIQUES_FEDERAUX[i] != p_ligne) ++i;
+	return static_cast<PartisPolitiques>(i);
+}
+
+/****************************************************************************//**
+ * Reconstruit un objet Adresse à partir de sa forme reqAdresseFormatee().
+ * Le nom de rue peut lui-même contenir le séparateur: on prend le numéro au
+ * début et les trois derniers champs à la fin.
+ *//****************************************************************************/
+
+static util::Adresse analyserAdresse(const std::string& p_ligne, const LecteurDeLignes& p_lecteur)
+{
+	std::vector<std::string> champs;
+	std::string::size_type debut = 0;
+	std::string::size_type fin;
+
+	while ((fin = p_ligne.find(SEPARATEUR_ADRESSE, debut)) != std::string::npos)
+	{
+		champs.push_back(p_ligne.substr(debut, fin - debut));
+		debut = fin + SEPARATEUR_ADRESSE.size();
+	}
+	champs.push_back(p_ligne.substr(debut));
+
+	if (champs.size() < NB_CHAMPS_ADRESSE or !util::estUnEntierPositif(champs[0]) or champs[0].size() > LONGUEUR_MAX_NUMERO)
+		p_lecteur.erreur(util::formatterCodeErreur(util::ADRESSE_INVALIDE));
+
+	std::string rue = champs[1];
+	for (std::size_t i = 2; i + 3 < champs.size(); ++i) rue += SEPARATEUR_ADRESSE + champs[i];
+
+	std::size_t n = champs.size();
+	int numero = std::stoi(champs[0]);
+	if (!util::Adresse::validerAdresse(numero, rue, champs[n - 3], champs[n - 2], champs[n - 1]))
+		p_lecteur.erreur(util::formatterCodeErreur(util::ADRESSE_INVALIDE));
+
+	return util::Adresse(numero, rue, champs[n - 3], champs[n - 2], champs[n - 1], util::DEJA_VALIDE);
+}
+
+/****************************************************************************//**
+ * Lit les cinq lignes d'un bloc à partir du NAS déjà lu, et construit un
+ * Electeur, ou un Candidat si un parti est fourni.
+ *
+ * \return un objet alloué dynamiquement, à désallouer par l'appelant
+ *//****************************************************************************/
+
+static Personne* lireBloc(LecteurDeLignes& p_lecteur, const std::string& p_nas, const PartisPolitiques* p_parti)
+{
+	std::string nom = p_lecteur.lireObligatoire();
+	std::string prenom = p_lecteur.lireObligatoire();
+	std::string date = p_lecteur.lireObligatoire();
+	std::string adresse = p_lecteur.lireObligatoire();
+	int champs[util::NB_CHAMPS_DATE];
+
+	util::CodeErreur code = Personne::diagnostiquerIdentite(p_nas, nom, prenom);
+	if (code != util::AUCUNE_ERREUR)
+		p_lecteur.erreur(util::formatterCodeErreur(code));
+	if (!util::validerLeFormatDeLaDate(date))
+		p_lecteur.erreur(util::formatterCodeErreur(util::DATE_INVALIDE));
+	util::extraireLesChampsDeLaDate(date, champs);
+	if (!util::Date::validerDate(champs[0], champs[1], champs[2]))
+		p_lecteur.erreur(util::formatterCodeErreur(util::DATE_INVALIDE));
+
+	util::Date ddn(champs[0], champs[1], champs[2]);
+	util::Adresse adr = analyserAdresse(adresse, p_lecteur);
+
+	if (p_parti)
+		return new Candidat(p_nas, nom, prenom, ddn, adr, *p_parti, util::DEJA_VALIDE);
+	return new Electeur(p_nas, nom, prenom, ddn, adr, util::DEJA_VALIDE);
+}
+
+/****************************************************************************//**
+ * Lit un seul bloc écrit par ecrirePersonne()
+ *
+ * \param[in] p_is flux d'entrée, positionné au début du bloc
+ *
+ * \return un Electeur ou un Candidat alloué dynamiquement, à désallouer par
+ * l'appelant
+ *
+ * \exception FormatFichierException si le bloc est incomplet ou invalide
+ *//****************************************************************************/
+
+Personne* lirePersonne(std::istream& p_is)
+{
+	LecteurDeLignes lecteur(p_is);
+	std::string ligne = lecteur.lireObligatoire();
+
+	if (util::estUnPartiPolitique(ligne))
+	{
+		PartisPolitiques parti = analyserParti(ligne);
+		return lireBloc(lecteur, lecteur.lireObligatoire(), &parti);
+	}
+	return lireBloc(lecteur, ligne, nullptr);
+}
+
+/****************************************************************************//**
+ * Reconstruit une circonscription à partir d'un flux écrit par
+ * sauvegarderCirconscription().
+ *
+ * \param[in] p_is flux d'entrée
+ * \param[in,out] p_suivi suivi optionnel: reçoit la position dans le flux et
+ * permet l'annulation
+ * \param[in] p_ressource ressource mémoire des inscrits, voir Circonscription
+ *
+ * \return une circonscription allouée dynamiquement, à désallouer par
+ * l'appelant.  nullptr si le traitement a été annulé.
+ *
+ * \exception FormatFichierException si un bloc est incomplet ou invalide, ou si
+ * un NAS y apparaît deux fois
+ *//****************************************************************************/
+
+Circonscription* recupererCirconscription(std::istream& p_is, SuiviTraitement* p_suivi,
+                                          std::pmr::memory_resource* p_ressource)
+{
+	LecteurDeLignes lecteur(p_is);
+	std::string nom;
+	std::string ligne;
+	PartisPolitiques parti;
+
+	if (!lecteur.lire(nom) or !util::estUnNom(nom)) lecteur.erreur("nom de circonscription invalide");
+	if (!util::estUnPartiPolitique(ligne = lecteur.lireObligatoire())) lecteur.erreur("parti politique invalide");
+	parti = analyserParti(ligne);
+
+	Personne* depute = lireBloc(lecteur, lecteur.lireObligatoire(), &parti);
+	Circonscription* circonscription = nullptr;
+	try
+	{
+		circonscription = new Circonscription(nom, *static_cast<Candidat*>(depute), p_ressource);
+	}
+	catch (...)
+	{
+		delete depute;
+		throw;
+	}
+	delete depute;
+
+	try
+	{
+		unsigned int nbLus = 0;
+		bool annule = false;
+
+		while (!annule and lecteur.lire(ligne))
+		{
+			std::unique_ptr<Personne> inscrit;
+			if (util::estUnPartiPolitique(ligne))
+			{
+				parti = analyserParti(ligne);
+				inscrit.reset(lireBloc(lecteur, lecteur.lireObligatoire(), &parti));
+			}
+			else
+			{
+				inscrit.reset(lireBloc(lecteur, ligne, nullptr));
+			}
+
+			util::Resultat<void> resultat = circonscription->tenterInscrire(*inscrit, util::DEJA_VALIDE);
+			inscrit.reset();
+			if (!resultat)
+				lecteur.erreur(util::formatterCodeErreur(resultat.reqErreur()));
+
+			if (p_suivi and (++nbLus % PERIODE_SUIVI == 0))
+			{
+				p_suivi->asgProgression(lecteur.reqPosition());
+				annule = p_suivi->estAnnule();
+			}
+		}
+		if (annule)
+		{
+			delete circonscription;
+			circonscription = nullptr;
+		}
+	}
+	catch (...)
+	{
+		delete circonscription;
+		throw;
+	}
+	return circonscription;
+}
+
+} // namespace elections
@@ -0,0 +1,82 @@
+/**
+ * \file persistance.h
+ *
+ * \brief Déclaration des fonctions de sauvegarde et de récupération d'une
+ * Circonscription dans un flux texte.
+ *
+ * Le format écrit est celui accepté par util::validerFormatFichier(): le nom
+ * de la circonscription, puis le bloc du député sortant, puis un bloc par
+ * inscrit.  Un bloc candidat débute par la ligne du parti politique.
+ *
+ *  Created on: 2020-12-12
+ * \author Pascal Charpentier
+ * \version 0.1
+ */
+
+#ifndef PERSISTANCE_H_
+#define PERSISTANCE_H_
+
+#include "Circonscription.h"
+
+#include <atomic>
+#include <istream>
+#include <memory_resource>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace elections
+{
+
+/****************************************************************************//**
+ * \class SuiviTraitement
+ *
+ * Permet à un autre fil d'exécution de suivre l'avancement d'une sauvegarde ou
+ * d'une récupération, et d'en demander l'annulation.  L'unité de progression
+ * est le nombre d'inscrits écrits pour une sauvegarde, et le nombre d'octets
+ * lus pour une récupération.
+ *
+ *//*****************************************************************************/
+
+class SuiviTraitement
+{
+private:
+
+	std::atomic<long long> m_progression;
+	std::atomic<bool>      m_annulation;
+
+public:
+
+	SuiviTraitement();
+
+	void asgProgression(long long p_progression);
+	long long reqProgression() const;
+
+	void annuler();
+	bool estAnnule() const;
+};
+
+/****************************************************************************//**
+ * \class FormatFichierException
+ *
+ * Lancée lorsque le flux à récupérer ne respecte pas le format attendu.  Le
+ * message contient le numéro de la ligne fautive.
+ *
+ *//*****************************************************************************/
+
+class FormatFichierException : public std::runtime_error
+{
+public:
+	FormatFichierException(const std::string& p_raison) : std::runtime_error(p_raison) {}
+};
+
+void ecrirePersonne(std::ostream& p_os, const Personne& p_personne);
+Personne* lirePersonne(std::istream& p_is);
+
+bool sauvegarderCirconscription(std::ostream& p_os, const Circonscription& p_circonscription, SuiviTraitement* p_suivi = nullptr);
+Circonscription* recupererCirconscription(std::istream& p_is, SuiviTraitement* p_suivi = nullptr,
+                                          std::pmr::memory_resource* p_ressource = nullptr);
+
+} // namespace elections
+
+#endif /* PERSISTANCE_H_ */
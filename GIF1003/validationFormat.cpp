@@ -30,6 +30,8 @@
 #include <algorithm>
 
 #include "validationFormat.h"
+#include "CodePostal.h"
+#include "Province.h"
 
 using namespace std;
 
@@ -53,19 +55,6 @@ using namespace std;
 namespace util
 {
 
-/****************************************************************************//**
- * Constantes pour la validation des adresses
- *
- *//****************************************************************************/
-
-static const std::string::size_type LONGUEUR_CODE_POSTAL = 7;
-
-static const std::size_t NB_PROVINCES_TERRITOIRES = 13;
-
-static const std::string PROVINCES_TERRITOIRES_FR[NB_PROVINCES_TERRITOIRES] = { "Colombie-Britannique", "Alberta", "Saskatchewan", "Manitoba",
-		"Ontario", "Québec", "Nouveau-Brunswick", "Nouvelle-Écosse", "Ile du Prince Édouard", "Terre-Neuve", "Nunavut", "Yukon",
-		"Territoires du Nord-Ouest" };
-
 /***************************************************************************//**
  * Constantes pour la validation des partis politiques
  *//****************************************************************************/
@@ -445,36 +434,47 @@ bool validerNas(const string& p_nas)
     return valide;
 }
 
+/****************************************************************************//**
+ *
+ * \brief Convertit un NAS en entier de 9 chiffres, pour servir de clé de
+ * recherche.  Les séparateurs sont ignorés: "245 367 996" et "245-367-996"
+ * donnent la même clé.
+ *
+ * \param[in] p_nas un NAS au format accepté par validerNas()
+ * \return les 9 chiffres du NAS, lus comme un entier décimal;
+ * CLE_NAS_INVALIDE si p_nas n'a pas le format d'un NAS
+ *
+ *//*****************************************************************************/
+
+unsigned int compacterNas(const std::string& p_nas)
+{
+	if (!validerLeFormatDuNas(p_nas))
+		return CLE_NAS_INVALIDE;
+
+	unsigned int cle = 0;
+
+	for (char caractere: p_nas)
+	{
+		if (isdigit(static_cast<unsigned char>(caractere)))
+			cle = 10 * cle + static_cast<unsigned int>(caractere - '0');
+	}
+	return cle;
+}
+
 /****************************************************************************//**
  * Vérifier si un objet string est au format d'un code postal canadien.
  *
  * \param[in] p_code un objet string à tester.
  *
  * \return true si la chaîne contient 7 caractères de la forme suivante:
- * LDL DLD ou D est un chiffre et L est une lettre majuscule.
+ * LDL DLD ou D est un chiffre et L est une lettre majuscule.  L'analyse est
+ * celle de CodePostal::creer().
  *
  *//****************************************************************************/
 
 bool validerCodePostal(const std::string& p_code)
 {
-    bool valide = (p_code.size() == LONGUEUR_CODE_POSTAL);
-
-    for (std::string::size_type i = 0; valide and i < LONGUEUR_CODE_POSTAL; ++i)
-    {
-    	if (i == 3)
-    	{
-    		valide = (p_code[i] == ' ');
-    	}
-    	else if ((i == 1) or (i == 4) or (i == 6))
-    	{
-    		valide = isdigit(p_code[i]);
-    	}
-    	else
-    	{
-    		valide = estUneLettreMajuscule(p_code[i]);
-    	}
-    }
-   return valide;
+	return CodePostal::creer(p_code).estValide();
 }
 
 /****************************************************************************//**
@@ -483,20 +483,16 @@ bool validerCodePostal(const std::string& p_code)
  *
  * \param[in] p_province un objet string à tester.
  *
- * \return true si la chaîne contient un des noms définis dans la constante
- * PROVINCES_TERRITOIRES_FR.
+ * \return true si la chaîne contient le nom français d'une province ou d'un
+ * territoire, tel que retourné par reqNomProvince().
  *
  *//****************************************************************************/
 
 bool validerProvinceOuTerritoire(const std::string& p_province)
 {
-	bool valide = false;
+	Resultat<Province> province = analyserProvince(p_province);
 
-	for (size_t i = 0; !valide and (i < NB_PROVINCES_TERRITOIRES); ++i)
-	{
-		valide = (p_province == PROVINCES_TERRITOIRES_FR[i]);
-	}
-	return valide;
+	return province and reqNomProvince(province.reqValeur()) == p_province;
 }
 
 
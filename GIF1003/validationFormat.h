@@ -30,6 +30,15 @@ const std::string PARTIS_POLITIQUES_FEDERAUX[NB_PARTIS]
 
 bool estUneLigneVide(const std::string& p_ligne);
 bool validerNas(const std::string& p_nas);
+unsigned int compacterNas(const std::string& p_nas);
+
+/**
+ * Valeur de compacterNas() pour une chaîne qui n'est pas au format d'un NAS.
+ * Aucun NAS de 9 chiffres ne la donne: une recherche par cette clé ne trouve
+ * personne.
+ */
+
+const unsigned int CLE_NAS_INVALIDE = 0xFFFFFFFF;
 bool validerCodePostal(const std::string& p_code);
 bool validerFormatFichier(std::istream& p_is);
 bool estUnNom(const std::string& p_ligne);
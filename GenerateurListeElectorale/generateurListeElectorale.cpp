@@ -0,0 +1,79 @@
+/**
+ * \file generateurListeElectorale.cpp
+ *
+ * Outil en ligne de commande qui écrit une liste électorale synthétique au
+ * format de util::validerFormatFichier(), pour les essais de charge du
+ * chargeur et des bancs d'essais.
+ *
+ *     generateurListeElectorale NB_INSCRITS [-g GERME] [-c PROPORTION_CANDIDATS]
+ *                               [-i PROPORTION_INVALIDES] [-n CIRCONSCRIPTION]
+ *                               [-o FICHIER]
+ *
+ * Sans -o, la liste est écrite sur la sortie standard.
+ *
+ *  Created on: 2020-12-15
+ * \author Pascal Charpentier
+ */
+
+#include "GenerateurInscrits.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static int afficherUsage(const char* p_programme)
+{
+	std::cerr << "usage: " << p_programme
+	          << " NB_INSCRITS [-g GERME] [-c PROPORTION_CANDIDATS] [-i PROPORTION_INVALIDES]"
+	             " [-n CIRCONSCRIPTION] [-o FICHIER]" << std::endl;
+	return EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) return afficherUsage(argv[0]);
+
+	char* fin = nullptr;
+	unsigned long long nbInscrits = std::strtoull(argv[1], &fin, 10);
+	unsigned long long germe = 1;
+	double proportionCandidats = 0.001;
+	double proportionInvalides = 0.0;
+	std::string circonscription = "Circonscription synthétique";
+	const char* nomFichier = nullptr;
+
+	if (*fin != '\0' or nbInscrits > elections::GenerateurInscrits::NB_MAX_INSCRITS) return afficherUsage(argv[0]);
+
+	for (int i = 2; i + 1 < argc; i += 2)
+	{
+		if (std::strcmp(argv[i], "-g") == 0) germe = std::strtoull(argv[i + 1], nullptr, 10);
+		else if (std::strcmp(argv[i], "-c") == 0) proportionCandidats = std::atof(argv[i + 1]);
+		else if (std::strcmp(argv[i], "-i") == 0) proportionInvalides = std::atof(argv[i + 1]);
+		else if (std::strcmp(argv[i], "-n") == 0) circonscription = argv[i + 1];
+		else if (std::strcmp(argv[i], "-o") == 0) nomFichier = argv[i + 1];
+		else return afficherUsage(argv[0]);
+	}
+	if (argc % 2 != 0 or proportionCandidats < 0.0 or proportionCandidats > 1.0 or
+		proportionInvalides < 0.0 or proportionInvalides > 1.0)
+		return afficherUsage(argv[0]);
+
+	std::ios_base::sync_with_stdio(false);
+	std::ofstream fichier;
+	if (nomFichier)
+	{
+		fichier.open(nomFichier, std::ios::binary);
+		if (!fichier)
+		{
+			std::cerr << "impossible d'ouvrir " << nomFichier << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	std::ostream& sortie = nomFichier ? static_cast<std::ostream&>(fichier) : std::cout;
+
+	elections::GenerateurInscrits generateur(germe, proportionCandidats, proportionInvalides);
+	generateur.ecrireFichier(sortie, circonscription, nbInscrits);
+	sortie.flush();
+
+	return sortie ? EXIT_SUCCESS : EXIT_FAILURE;
+}
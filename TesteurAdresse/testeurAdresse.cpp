@@ -218,6 +218,25 @@ TEST(Adresse, neConstruitPasUnObjetInvalide)
 	}
 }
 
+/**
+ * Méthode testée: Adresse::creer (STATIQUE)
+ *
+ * Cas testés: adresses valides puis non-valides
+ *
+ * Comportement attendu: retourne l'adresse ou le code ADRESSE_INVALIDE, sans exception
+ */
+
+TEST(Adresse, creerSansException)
+{
+	Resultat<Adresse> valide = Adresse::creer(2020, "du Finfin", "Alma", "G8Z 3S3", "Québec");
+	ASSERT_TRUE(valide.estValide());
+	EXPECT_EQ(valide.reqValeur().reqVille(), "Alma");
+
+	Resultat<Adresse> invalide = Adresse::creer(0, "du Finfin", "Alma", "G8Z 3S3", "Québec");
+	EXPECT_FALSE(invalide.estValide());
+	EXPECT_EQ(invalide.reqErreur(), ADRESSE_INVALIDE);
+}
+
 /**
  * \class AdresseTest
  *
@@ -300,6 +319,25 @@ TEST_F(AdresseTest, reqCodePostal)
 	EXPECT_EQ(adresseValide2.reqCodePostal(), "H7E 1M8");
 }
 
+/**
+ * Méthode testée: reqCodePostalCompact
+ *
+ * Cas testés: dispositif de test, assignation d'un code postal américain
+ *
+ * Comportement attendu: la forme compacte du code; un code non valide pour un
+ * code qui n'est pas canadien
+ */
+
+TEST_F(AdresseTest, reqCodePostalCompact)
+{
+	EXPECT_EQ(adresseValide1.reqCodePostalCompact(), CodePostal("G8Z 3S3"));
+	EXPECT_EQ(adresseValide2.reqCodePostalCompact().reqTexte(), "H7E 1M8");
+
+	adresseValide1.asg(1600, "Pennsylvania Avenue", "Washington", "20500", "DC");
+	EXPECT_EQ(adresseValide1.reqCodePostal(), "20500");
+	EXPECT_FALSE(adresseValide1.reqCodePostalCompact().estValide());
+}
+
 /**
  * Méthode testée: reqProvince
  *
@@ -315,6 +353,30 @@ TEST_F(AdresseTest, reqProvince)
 	EXPECT_EQ(adresseValide2.reqProvince(), "Québec");
 }
 
+/**
+ * Méthode testée: reqProvinceTerritoire, reqProvince
+ *
+ * Cas testés: nom français, abréviation, état américain
+ *
+ * Comportement attendu: la province reconnue et son nom français; hors du
+ * Canada, Province::AUTRE et le nom reçu
+ */
+
+TEST_F(AdresseTest, reqProvinceTerritoire)
+{
+	Adresse abregee(10567, "boulevard de l'Avenir", "Laval", "H7E 1M8", "QC");
+	Adresse etrangere(1600, "Pennsylvania Avenue", "Washington", "20500", "DC");
+
+	EXPECT_EQ(adresseValide1.reqProvinceTerritoire(), Province::QUEBEC);
+	EXPECT_EQ(abregee.reqProvinceTerritoire(), Province::QUEBEC);
+	EXPECT_EQ(abregee.reqProvince(), "Québec");
+	EXPECT_EQ(abregee, adresseValide2);
+	EXPECT_EQ(etrangere.reqProvinceTerritoire(), Province::AUTRE);
+	EXPECT_EQ(etrangere.reqProvince(), "DC");
+	EXPECT_NE(etrangere, Adresse(1600, "Pennsylvania Avenue", "Washington", "20500", "NY"));
+	EXPECT_EQ(etrangere, Adresse(1600, "Pennsylvania Avenue", "Washington", "20500", "DC"));
+}
+
 /**
  * Méthode testée: mutateur
  *
@@ -0,0 +1,107 @@
+/**
+ * \file testeurBassinDeTaches.cpp
+ *
+ * Tests unitaires de la classe BassinDeTaches.
+ *
+ *  Created on: 2020-12-16
+ * \author Pascal Charpentier
+ */
+
+#include "BassinDeTaches.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace util;
+
+/**
+ * Méthode testée: soumettre
+ *
+ * Cas testé: 1000 tâches sur 4 fils
+ *
+ * Comportement attendu: chaque futur livre le résultat de sa tâche
+ */
+
+TEST(BassinDeTaches, resultats)
+{
+	BassinDeTaches bassin(4);
+	std::vector<std::future<int>> futurs;
+
+	EXPECT_EQ(bassin.reqNbFils(), 4u);
+	for (int i = 0; i < 1000; ++i)
+	{
+		futurs.push_back(bassin.soumettre([i]() { return i * i; }));
+	}
+	for (int i = 0; i < 1000; ++i)
+	{
+		EXPECT_EQ(futurs[i].get(), i * i);
+	}
+}
+
+/**
+ * Méthode testée: soumettre
+ *
+ * Cas testé: tâche qui lance une exception
+ *
+ * Comportement attendu: l'exception est relancée par get()
+ */
+
+TEST(BassinDeTaches, exception)
+{
+	BassinDeTaches bassin(2);
+	std::future<void> futur = bassin.soumettre([]() { throw std::runtime_error("échec"); });
+	EXPECT_THROW(futur.get(), std::runtime_error);
+}
+
+/**
+ * Méthode testée: destructeur
+ *
+ * Cas testé: tâches en attente à la destruction
+ *
+ * Comportement attendu: toutes les tâches sont exécutées
+ */
+
+TEST(BassinDeTaches, destructeurTermineLesTaches)
+{
+	std::atomic<int> compteur(0);
+	{
+		BassinDeTaches bassin(2);
+		for (int i = 0; i < 500; ++i)
+		{
+			bassin.soumettre([&compteur]() { ++compteur; });
+		}
+	}
+	EXPECT_EQ(compteur.load(), 500);
+}
+
+/**
+ * Fonction testée: attendreToutes
+ *
+ * Cas testé: la première tâche lève une exception, la seconde se termine plus
+ * tard
+ *
+ * Comportement attendu: au retour, la seconde tâche est terminée; get() livre
+ * ensuite l'exception de la première
+ */
+
+TEST(BassinDeTaches, attendreToutes)
+{
+	BassinDeTaches bassin(2);
+	std::atomic<bool> terminee(false);
+	std::vector<std::future<void>> futurs;
+
+	futurs.push_back(bassin.soumettre([]() { throw std::runtime_error("échec"); }));
+	futurs.push_back(bassin.soumettre([&terminee]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		terminee = true;
+	}));
+	attendreToutes(futurs);
+
+	EXPECT_TRUE(terminee.load());
+	EXPECT_THROW(futurs[0].get(), std::runtime_error);
+	futurs[1].get();
+}
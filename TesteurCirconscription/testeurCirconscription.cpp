@@ -11,6 +11,7 @@
 #include "ContratException.h"
 #include "PersonneException.h"
 #include <gtest/gtest.h>
+#include <memory_resource>
 #include <vector>
 
 using namespace elections;
@@ -135,6 +136,23 @@ TEST_F(CirconscriptionTest, reqCirconscriptionFormate)
 	EXPECT_EQ(circonscription1.reqCirconscriptionFormate(), resultat);
 }
 
+/**
+ * Méthode testée: reqCirconscriptionFormate avec mémorisation
+ *
+ * Cas testé: deux inscrits, affichage répété
+ *
+ * Comportement attendu: le même texte que sans mémorisation
+ */
+
+TEST_F(CirconscriptionTest, reqCirconscriptionFormateMemorise)
+{
+	circonscription1.inscrire(*p1);
+	circonscription1.inscrire(*p2);
+
+	EXPECT_EQ(circonscription1.reqCirconscriptionFormate(true), circonscription1.reqCirconscriptionFormate());
+	EXPECT_EQ(circonscription1.reqCirconscriptionFormate(true), circonscription1.reqCirconscriptionFormate());
+}
+
 
 /**
  * Méthode testée: listeEstValide
@@ -252,6 +270,307 @@ TEST_F(CirconscriptionTest, desinscrireElecteurExistant)
 	EXPECT_EQ(circonscription1.reqCirconscriptionFormate(), resultat3);
 }
 
+/**
+ * Méthodes testées: desinscrire, reqInscrit, remplacer
+ *
+ * Cas testé: retrait du premier de trois inscrits, puis remplacement de
+ * l'inscrit déplacé
+ *
+ * Comportement attendu: le dernier inscrit prend la place du retiré et reste
+ * accessible par son NAS, où il est remplacé
+ */
+
+TEST_F(CirconscriptionTest, desinscrireDeplaceLeDernier)
+{
+	circonscription1.inscrire(*p1);
+	circonscription1.inscrire(*p2);
+	circonscription1.inscrire(*p3);
+
+	circonscription1.desinscrire("111 111 118");
+
+	ASSERT_EQ(circonscription1.reqNbInscrits(), 2u);
+	EXPECT_EQ(*circonscription1.reqDebutInscrits()[0], *p3);
+	EXPECT_EQ(*circonscription1.reqDebutInscrits()[1], *p2);
+	EXPECT_EQ(circonscription1.reqInscrit("333 333 334"), circonscription1.reqDebutInscrits()[0]);
+	EXPECT_EQ(circonscription1.reqInscrit("111 111 118"), nullptr);
+
+	Candidat demenage("333 333 334", "Snow", "Jon", util::Date(2, 2, 2002), util::Adresse(2, "Castle Black", "The Wall", "X3X 3X3", "Westeros"), CONSERVATEUR);
+	EXPECT_TRUE(circonscription1.remplacer(demenage).estValide());
+	EXPECT_EQ(*circonscription1.reqDebutInscrits()[0], demenage);
+	EXPECT_EQ(*circonscription1.reqDebutInscrits()[1], *p2);
+}
+
+/**
+ * Méthodes testées: tenterInscrire, tenterDesinscrire
+ *
+ * Cas testés: inscription valide, doublon, retrait d'un NAS absent puis présent, NAS mal formé
+ *
+ * Comportement attendu: retourne le code d'erreur approprié sans lancer d'exception
+ */
+
+TEST_F(CirconscriptionTest, tenterSansException)
+{
+	EXPECT_TRUE(circonscription1.tenterInscrire(*p1).estValide());
+	EXPECT_EQ(circonscription1.tenterInscrire(*p1).reqErreur(), util::PERSONNE_DEJA_PRESENTE);
+	EXPECT_EQ(circonscription1.reqNbInscrits(), 1u);
+
+	EXPECT_EQ(circonscription1.tenterDesinscrire("222 222 226").reqErreur(), util::PERSONNE_ABSENTE);
+	EXPECT_EQ(circonscription1.tenterDesinscrire("222 222 22").reqErreur(), util::NAS_INVALIDE);
+	EXPECT_TRUE(circonscription1.tenterDesinscrire("111 111 118").estValide());
+	EXPECT_EQ(circonscription1.reqNbInscrits(), 0u);
+}
+
+/**
+ * Méthode testée: tenterInscrire de confiance
+ *
+ * Cas testés: inscription valide, doublon
+ *
+ * Comportement attendu: inscrit la personne sans la revalider, mais refuse
+ * toujours un NAS déjà inscrit
+ */
+
+TEST_F(CirconscriptionTest, tenterInscrireDejaValide)
+{
+	EXPECT_TRUE(circonscription1.tenterInscrire(*p1, util::DEJA_VALIDE).estValide());
+	EXPECT_EQ(circonscription1.tenterInscrire(*p1, util::DEJA_VALIDE).reqErreur(), util::PERSONNE_DEJA_PRESENTE);
+	EXPECT_EQ(circonscription1.reqNbInscrits(), 1u);
+	EXPECT_TRUE(circonscription1.validerCirconscription());
+}
+
+/**
+ * Méthode testée: reqInscrit
+ *
+ * Cas testé: NAS inscrit, NAS absent, NAS inscrit écrit avec des tirets
+ *
+ * Comportement attendu: retourne l'inscrit, ou nullptr s'il est absent
+ */
+
+TEST_F(CirconscriptionTest, reqInscrit)
+{
+	circonscription1.inscrire(*p1);
+	circonscription1.inscrire(*p2);
+
+	ASSERT_NE(circonscription1.reqInscrit("222 222 226"), nullptr);
+	EXPECT_EQ(*circonscription1.reqInscrit("222 222 226"), *p2);
+	EXPECT_EQ(circonscription1.reqInscrit("333 333 334"), nullptr);
+	EXPECT_EQ(circonscription1.reqInscrit("111-111-118"), circonscription1.reqInscrit("111 111 118"));
+}
+
+/**
+ * Méthodes testées: reqInscrit, tenterDesinscrire
+ *
+ * Cas testé: NAS de 10 chiffres qui, lu modulo 2^32, donne le NAS d'un
+ * inscrit; chaîne qui donnerait la clé réservée aux cases vides de l'index
+ *
+ * Comportement attendu: personne n'est trouvé
+ */
+
+TEST_F(CirconscriptionTest, reqInscritNasMalForme)
+{
+	circonscription1.inscrire(Electeur("046 454 286", "Stark", "Arya", util::Date(3, 1, 2007), util::Adresse(1, "Winterfell", "The North", "X3X 3X3", "Westeros")));
+
+	EXPECT_EQ(circonscription1.reqInscrit("4341421582"), nullptr);
+	EXPECT_EQ(circonscription1.reqInscrit("4294967295"), nullptr);
+	EXPECT_EQ(circonscription1.tenterDesinscrire("4341421582").reqErreur(), util::NAS_INVALIDE);
+	EXPECT_EQ(circonscription1.reqNbInscrits(), 1u);
+}
+
+/**
+ * \class RessourceComptee
+ *
+ * Ressource mémoire qui compte les octets alloués et non libérés
+ */
+
+class RessourceComptee : public std::pmr::memory_resource
+{
+public:
+
+	std::size_t nbAllocations = 0;
+	std::size_t nbOctets = 0;
+
+private:
+
+	void* do_allocate(std::size_t p_taille, std::size_t p_alignement) override
+	{
+		++nbAllocations;
+		nbOctets += p_taille;
+		return std::pmr::new_delete_resource()->allocate(p_taille, p_alignement);
+	}
+	void do_deallocate(void* p, std::size_t p_taille, std::size_t p_alignement) override
+	{
+		nbOctets -= p_taille;
+		std::pmr::new_delete_resource()->deallocate(p, p_taille, p_alignement);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& p_autre) const noexcept override
+	{
+		return this == &p_autre;
+	}
+};
+
+/**
+ * Méthode testée: constructeur avec ressource mémoire
+ *
+ * Cas testé: inscriptions, désinscription, remplacement, copie sans ressource
+ * et copie dans la ressource, puis destruction
+ *
+ * Comportement attendu: chaque inscrit est alloué dans la ressource et y est
+ * rendu; la copie sans ressource n'y alloue rien
+ */
+
+TEST_F(CirconscriptionTest, ressourceMemoire)
+{
+	RessourceComptee ressource;
+	{
+		Circonscription circonscription("Circonscription Test 2", deputeSortant, &ressource);
+		circonscription.inscrire(*p1);
+		circonscription.inscrire(*p2);
+		circonscription.inscrire(*p3);
+		EXPECT_EQ(ressource.nbAllocations, 3u);
+		EXPECT_EQ(circonscription.reqRessource(), &ressource);
+
+		circonscription.desinscrire("222 222 226");
+		EXPECT_EQ(ressource.nbOctets, sizeof(Electeur) + sizeof(Candidat));
+		Electeur demenage("111 111 118", "Arryn", "Jon", util::Date(3, 1, 2007), util::Adresse(2, "Casterly Rock", "Westerlands", "X3X 3X3", "Westeros"));
+		EXPECT_TRUE(circonscription.remplacer(demenage).estValide());
+		EXPECT_EQ(**circonscription.reqDebutInscrits(), demenage);
+
+		Circonscription copie(circonscription);
+		EXPECT_EQ(copie.reqRessource(), nullptr);
+		EXPECT_EQ(ressource.nbAllocations, 4u);
+		Circonscription copieDansRessource(circonscription, &ressource);
+		EXPECT_EQ(ressource.nbAllocations, 6u);
+		EXPECT_EQ(copieDansRessource.reqCirconscriptionFormate(), circonscription.reqCirconscriptionFormate());
+	}
+	EXPECT_EQ(ressource.nbOctets, 0u);
+}
+
+/**
+ * Méthode testée: reqNbInscritsParProvince
+ *
+ * Cas testé: deux inscrits à Westeros, un au Québec
+ *
+ * Comportement attendu: un compteur par province, les adresses étrangères au
+ * dernier
+ */
+
+TEST_F(CirconscriptionTest, reqNbInscritsParProvince)
+{
+	circonscription1.inscrire(*p1);
+	circonscription1.inscrire(*p2);
+	circonscription1.inscrire(Electeur("444 444 442", "Tremblay", "Marie", util::Date(4, 4, 1984), util::Adresse(1, "des Érables", "Alma", "G8B 1A1", "QC")));
+
+	std::array<std::size_t, util::NB_PROVINCES + 1> nbInscrits = circonscription1.reqNbInscritsParProvince();
+	EXPECT_EQ(nbInscrits[static_cast<std::size_t>(util::Province::QUEBEC)], 1u);
+	EXPECT_EQ(nbInscrits[static_cast<std::size_t>(util::Province::AUTRE)], 2u);
+	EXPECT_EQ(nbInscrits[static_cast<std::size_t>(util::Province::ONTARIO)], 0u);
+}
+
+/**
+ * Méthode testée: remplacer
+ *
+ * Cas testé: nouvelle adresse d'un inscrit, NAS absent
+ *
+ * Comportement attendu: l'inscrit est remplacé à sa place; un NAS absent est refusé
+ */
+
+TEST_F(CirconscriptionTest, remplacer)
+{
+	circonscription1.inscrire(*p1);
+	circonscription1.inscrire(*p2);
+
+	Electeur demenage("111 111 118", "Arryn", "Jon", util::Date(3, 1, 2007), util::Adresse(2, "Casterly Rock", "Westerlands", "X3X 3X3", "Westeros"));
+	EXPECT_TRUE(circonscription1.remplacer(demenage).estValide());
+	EXPECT_EQ(**circonscription1.reqDebutInscrits(), demenage);
+	EXPECT_EQ(*circonscription1.reqInscrit("111 111 118"), demenage);
+	EXPECT_EQ(circonscription1.reqNbInscrits(), 2u);
+
+	EXPECT_EQ(circonscription1.remplacer(*p3).reqErreur(), util::PERSONNE_ABSENTE);
+}
+
+/**
+ * Méthode testée: transferer
+ *
+ * Cas testés: inscrit transféré, NAS absent, NAS mal formé, NAS déjà présent
+ * dans la destination
+ *
+ * Comportement attendu: l'inscrit passe dans la destination sans être
+ * recopié; les refus laissent les deux listes inchangées
+ */
+
+TEST_F(CirconscriptionTest, transferer)
+{
+	Circonscription destination("Circonscription Test 2", deputeSortant);
+	circonscription1.inscrire(*p1);
+	circonscription1.inscrire(*p2);
+	destination.inscrire(*p3);
+	const Personne* inscrit = circonscription1.reqInscrit("111 111 118");
+
+	EXPECT_TRUE(circonscription1.transferer("111 111 118", destination).estValide());
+	EXPECT_EQ(circonscription1.reqInscrit("111 111 118"), nullptr);
+	EXPECT_EQ(destination.reqInscrit("111 111 118"), inscrit);
+	EXPECT_EQ(*(destination.reqFinInscrits() - 1), inscrit);
+	EXPECT_EQ(circonscription1.reqNbInscrits(), 1u);
+	EXPECT_EQ(destination.reqNbInscrits(), 2u);
+
+	EXPECT_EQ(circonscription1.transferer("111 111 118", destination).reqErreur(), util::PERSONNE_ABSENTE);
+	EXPECT_EQ(circonscription1.transferer("123", destination).reqErreur(), util::NAS_INVALIDE);
+	EXPECT_THROW(circonscription1.transferer("222 222 226", circonscription1), PreconditionException);
+
+	circonscription1.inscrire(*p3);
+	EXPECT_EQ(circonscription1.transferer("333 333 334", destination).reqErreur(), util::PERSONNE_DEJA_PRESENTE);
+	EXPECT_EQ(circonscription1.reqNbInscrits(), 2u);
+	EXPECT_EQ(destination.reqNbInscrits(), 2u);
+}
+
+/**
+ * Méthode testée: transfererSi
+ *
+ * Cas testés: transfert des inscrits de Westeros, dont un déjà dans la
+ * destination, puis sans lui; transfert vers une autre ressource mémoire
+ *
+ * Comportement attendu: rien ne bouge tant qu'un NAS est en conflit; ensuite
+ * tous les inscrits choisis passent, dans leur ordre, et les autres restent.
+ * Vers une autre ressource, les inscrits y sont recopiés et rendus à la
+ * première.
+ */
+
+TEST_F(CirconscriptionTest, transfererSi)
+{
+	Circonscription destination("Circonscription Test 2", deputeSortant);
+	Electeur quebecois("444 444 442", "Tremblay", "Marie", util::Date(4, 4, 1984), util::Adresse(1, "des Érables", "Alma", "G8B 1A1", "QC"));
+	circonscription1.inscrire(*p1);
+	circonscription1.inscrire(quebecois);
+	circonscription1.inscrire(*p2);
+	circonscription1.inscrire(*p3);
+	destination.inscrire(*p3);
+	auto westeros = [](const Personne& p) { return p.reqAdresse().reqProvince() == "Westeros"; };
+
+	EXPECT_EQ(circonscription1.transfererSi(westeros, destination).reqErreur(), util::PERSONNE_DEJA_PRESENTE);
+	EXPECT_EQ(circonscription1.reqNbInscrits(), 4u);
+	EXPECT_EQ(destination.reqNbInscrits(), 1u);
+
+	circonscription1.desinscrire("333 333 334");
+	util::Resultat<std::size_t> nbTransferes = circonscription1.transfererSi(westeros, destination);
+	ASSERT_TRUE(nbTransferes.estValide());
+	EXPECT_EQ(nbTransferes.reqValeur(), 2u);
+	ASSERT_EQ(circonscription1.reqNbInscrits(), 1u);
+	EXPECT_EQ(**circonscription1.reqDebutInscrits(), quebecois);
+	ASSERT_EQ(destination.reqNbInscrits(), 3u);
+	EXPECT_EQ(*destination.reqDebutInscrits()[1], *p1);
+	EXPECT_EQ(*destination.reqDebutInscrits()[2], *p2);
+
+	RessourceComptee ressource;
+	{
+		Circonscription dansRessource("Circonscription Test 3", deputeSortant, &ressource);
+		dansRessource.inscrire(*p1);
+		dansRessource.inscrire(*p2);
+		Circonscription horsRessource("Circonscription Test 4", deputeSortant);
+		EXPECT_EQ(dansRessource.transfererSi(westeros, horsRessource).reqValeur(), 2u);
+		EXPECT_EQ(ressource.nbOctets, 0u);
+		EXPECT_EQ(horsRessource.reqNbInscrits(), 2u);
+	}
+}
+
 /**
  * Méthode testée: opérator=
  *
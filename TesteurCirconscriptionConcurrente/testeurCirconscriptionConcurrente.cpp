@@ -0,0 +1,182 @@
+/**
+ * \file testeurCirconscriptionConcurrente.cpp
+ *
+ * Tests unitaires et test de charge de la classe CirconscriptionConcurrente.
+ *
+ *  Created on: 2020-12-17
+ * \author Pascal Charpentier
+ */
+
+#include "CirconscriptionConcurrente.h"
+#include "GenerateurInscrits.h"
+#include "PersonneException.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace elections;
+
+/**
+ * Dispositif de test: une liste partagée vide et un générateur d'électeurs
+ */
+
+class CirconscriptionConcurrenteTest : public ::testing::Test
+{
+public:
+
+	CirconscriptionConcurrenteTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute(), 16) {}
+
+	GenerateurInscrits generateur;
+	CirconscriptionConcurrente circonscription;
+};
+
+/**
+ * Méthodes testées: inscrire, desinscrire, estInscrit, reqCopieInscrit
+ *
+ * Cas testé: un seul fil
+ *
+ * Comportement attendu: même comportement que Circonscription
+ */
+
+TEST_F(CirconscriptionConcurrenteTest, unSeulFil)
+{
+	Electeur electeur = generateur.reqElecteur(1);
+
+	circonscription.inscrire(electeur);
+	EXPECT_THROW(circonscription.inscrire(electeur), PersonneDejaPresenteException);
+	EXPECT_TRUE(circonscription.estInscrit(electeur.reqNas()));
+
+	Personne* copie = circonscription.reqCopieInscrit(electeur.reqNas());
+	ASSERT_NE(copie, nullptr);
+	EXPECT_EQ(*copie, electeur);
+	delete copie;
+
+	circonscription.desinscrire(electeur.reqNas());
+	EXPECT_THROW(circonscription.desinscrire(electeur.reqNas()), PersonneAbsenteException);
+	EXPECT_EQ(circonscription.reqNbInscrits(), 0u);
+}
+
+/**
+ * Méthode testée: reqCirconscription
+ *
+ * Cas testé: liste construite à partir d'une Circonscription
+ *
+ * Comportement attendu: la copie est identique, dans l'ordre d'inscription
+ */
+
+TEST_F(CirconscriptionConcurrenteTest, allerRetourCirconscription)
+{
+	Circonscription originale("Chicoutimi", generateur.reqDepute());
+	generateur.inscrireElecteurs(originale, 1, 200);
+
+	CirconscriptionConcurrente partagee(originale);
+	EXPECT_EQ(partagee.reqCirconscription().reqCirconscriptionFormate(), originale.reqCirconscriptionFormate());
+}
+
+/**
+ * Méthodes testées: tenterInscrire, tenterDesinscrire, consulter, en concurrence
+ *
+ * Cas testé: 8 fils inscrivent chacun 1000 électeurs qui leur sont propres et
+ * tentent tous d'inscrire les mêmes 200 électeurs communs, pendant que 2 fils
+ * lisent; puis chaque fil retire la moitié de ses propres électeurs
+ *
+ * Comportement attendu: chaque électeur commun n'est inscrit qu'une fois, et
+ * le nombre final d'inscrits est exact
+ */
+
+TEST_F(CirconscriptionConcurrenteTest, chargeConcurrente)
+{
+	const std::size_t NB_FILS = 8;
+	const std::size_t NB_PROPRES = 1000;
+	const std::size_t NB_COMMUNS = 200;
+
+	std::vector<Electeur> electeurs;
+	for (std::size_t i = 1; i <= NB_COMMUNS + NB_FILS * NB_PROPRES; ++i) electeurs.push_back(generateur.reqElecteur(i));
+
+	std::atomic<std::size_t> communsInscrits(0);
+	std::atomic<bool> fini(false);
+	std::atomic<std::size_t> lectures(0);
+	std::vector<std::thread> fils;
+
+	for (int l = 0; l < 2; ++l)
+	{
+		fils.emplace_back([&]()
+		{
+			while (!fini.load())
+			{
+				for (std::size_t i = 0; i < electeurs.size(); i += 37)
+				{
+					circonscription.consulter(electeurs[i].reqNas(), [&](const Personne& p_personne)
+					{
+						EXPECT_EQ(p_personne.reqNas(), electeurs[i].reqNas());
+					});
+					++lectures;
+				}
+			}
+		});
+	}
+
+	std::vector<std::thread> redacteurs;
+	for (std::size_t f = 0; f < NB_FILS; ++f)
+	{
+		redacteurs.emplace_back([&, f]()
+		{
+			for (std::size_t i = 0; i < NB_PROPRES; ++i)
+			{
+				EXPECT_TRUE(circonscription.tenterInscrire(electeurs[NB_COMMUNS + f * NB_PROPRES + i]).estValide());
+				if (i < NB_COMMUNS and circonscription.tenterInscrire(electeurs[i]).estValide()) ++communsInscrits;
+			}
+			for (std::size_t i = 0; i < NB_PROPRES; i += 2)
+			{
+				EXPECT_TRUE(circonscription.tenterDesinscrire(electeurs[NB_COMMUNS + f * NB_PROPRES + i].reqNas()).estValide());
+			}
+		});
+	}
+	for (std::thread& t: redacteurs) t.join();
+	fini = true;
+	for (std::thread& t: fils) t.join();
+
+	EXPECT_EQ(communsInscrits.load(), NB_COMMUNS);
+	EXPECT_EQ(circonscription.reqNbInscrits(), NB_COMMUNS + NB_FILS * NB_PROPRES / 2);
+	EXPECT_EQ(circonscription.reqCirconscription().reqNbInscrits(), circonscription.reqNbInscrits());
+	EXPECT_GT(lectures.load(), 0u);
+}
+
+/**
+ * Méthodes testées: tenterInscrire, tenterDesinscrire, reqNbInscrits
+ *
+ * Cas testé: un fil inscrit sans cesse le même électeur, un autre le
+ * désinscrit aussitôt, un troisième lit le nombre d'inscrits
+ *
+ * Comportement attendu: le nombre lu n'est jamais négatif, donc jamais
+ * supérieur à un
+ */
+
+TEST_F(CirconscriptionConcurrenteTest, compteSansDebordement)
+{
+	const int NB_ESSAIS = 20000;
+	Electeur electeur = generateur.reqElecteur(1);
+	std::atomic<bool> fini(false);
+	std::atomic<std::size_t> maximum(0);
+
+	std::thread lecteur([&]()
+	{
+		while (!fini.load())
+		{
+			std::size_t nb = circonscription.reqNbInscrits();
+			if (nb > maximum.load()) maximum = nb;
+		}
+	});
+	std::thread retrait([&]()
+	{
+		while (!fini.load()) circonscription.tenterDesinscrire(electeur.reqNas());
+	});
+	for (int i = 0; i < NB_ESSAIS; ++i) circonscription.tenterInscrire(electeur);
+	fini = true;
+	lecteur.join();
+	retrait.join();
+
+	EXPECT_LE(maximum.load(), 1u);
+	EXPECT_LE(circonscription.reqNbInscrits(), 1u);
+}
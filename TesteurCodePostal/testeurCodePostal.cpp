@@ -0,0 +1,103 @@
+/**
+ * \file testeurCodePostal.cpp
+ *
+ * Tests unitaires de la classe CodePostal.
+ *
+ *  Created on: 2020-12-22
+ * \author Pascal Charpentier
+ */
+
+#include "CodePostal.h"
+#include "ContratException.h"
+#include "validationFormat.h"
+#include "gtest/gtest.h"
+#include <string>
+
+using namespace util;
+
+/**
+ * Méthode testée: creer
+ *
+ * Cas testé: codes bien formés, codes mal formés (minuscules, sans espace,
+ * lettre et chiffre inversés, trop long, caractère hors ASCII)
+ *
+ * Comportement attendu: un code valide seulement pour le format LDL DLD, le
+ * même verdict que validerCodePostal
+ */
+
+TEST(CodePostal, creer)
+{
+	for (const std::string code: {"G8Z 3S3", "H7E 1M8", "A0A 0A0", "Z9Z 9Z9"})
+	{
+		EXPECT_TRUE(CodePostal::creer(code).estValide()) << code;
+		EXPECT_TRUE(validerCodePostal(code)) << code;
+	}
+	for (const std::string code: {"", "g8z 3s3", "G8Z3S3", "8GZ 3S3", "G8Z 3S3 ", "G8Z-3S3", "É8Z 3S3", "12345"})
+	{
+		EXPECT_EQ(CodePostal::creer(code).reqErreur(), ADRESSE_INVALIDE) << code;
+		EXPECT_FALSE(validerCodePostal(code)) << code;
+	}
+}
+
+/**
+ * Méthode testée: reqTexte, reqTexteRegionTri, reqRegionTri
+ *
+ * Cas testé: codes des deux bouts de l'intervalle et code quelconque
+ *
+ * Comportement attendu: le texte d'origine est restitué; la région est celle
+ * que donne analyserRegionTri; les valeurs couvrent 1 à NB_REGIONS_TRI * NB_UNITES
+ */
+
+TEST(CodePostal, allerRetour)
+{
+	for (const std::string texte: {"A0A 0A0", "G8T 1A1", "Z9Z 9Z9"})
+	{
+		CodePostal code(texte);
+		EXPECT_EQ(code.reqTexte(), texte);
+		EXPECT_EQ(code.reqTexteRegionTri(), texte.substr(0, 3));
+		EXPECT_EQ(code.reqRegionTri(), CodePostal::analyserRegionTri(texte.substr(0, 3)).reqValeur());
+	}
+	EXPECT_EQ(CodePostal("A0A 0A0").reqRegionTri(), 0u);
+	EXPECT_EQ(CodePostal("Z9Z 9Z9").reqRegionTri(), CodePostal::NB_REGIONS_TRI - 1);
+	EXPECT_EQ(CodePostal("A0A 0A0").reqValeur(), 1u);
+	EXPECT_EQ(CodePostal("Z9Z 9Z9").reqValeur(), CodePostal::NB_REGIONS_TRI * CodePostal::NB_UNITES);
+	EXPECT_FALSE(CodePostal::analyserRegionTri("G8").estValide());
+	EXPECT_FALSE(CodePostal::analyserRegionTri("8GT").estValide());
+}
+
+/**
+ * Méthode testée: operator<, operator==, constructeur par défaut
+ *
+ * Cas testé: codes de régions différentes et d'une même région
+ *
+ * Comportement attendu: l'ordre des valeurs est l'ordre alphabétique des
+ * codes; le code par défaut n'est pas valide et précède tous les autres
+ */
+
+TEST(CodePostal, ordre)
+{
+	CodePostal absent;
+
+	EXPECT_FALSE(absent.estValide());
+	EXPECT_EQ(absent.reqTexte(), "");
+	EXPECT_THROW(absent.reqRegionTri(), PreconditionException);
+	EXPECT_TRUE(absent < CodePostal("A0A 0A0"));
+	EXPECT_TRUE(CodePostal("G8T 1A1") < CodePostal("G8T 1A2"));
+	EXPECT_TRUE(CodePostal("G8T 9Z9") < CodePostal("G8V 0A0"));
+	EXPECT_TRUE(CodePostal("G8Z 3S3") < CodePostal("H0A 0A0"));
+	EXPECT_EQ(CodePostal("H7E 1M8"), CodePostal::creer("H7E 1M8").reqValeur());
+	EXPECT_NE(CodePostal("H7E 1M8"), CodePostal("H7E 1M9"));
+}
+
+/**
+ * Méthode testée: constructeur
+ *
+ * Cas testé: code mal formé
+ *
+ * Comportement attendu: soulève une exception de précondition
+ */
+
+TEST(CodePostal, constructeurInvalide)
+{
+	EXPECT_THROW(CodePostal("g8z 3s3"), PreconditionException);
+}
@@ -0,0 +1,93 @@
+/**
+ * \file testeurDate.cpp
+ *
+ * Tests unitaires du formatage de la classe Date.
+ *
+ *  Created on: 2020-12-24
+ * \author Pascal Charpentier
+ */
+
+#include "Date.h"
+#include "ContratException.h"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace util;
+
+/**
+ * Méthode testée: reqDateFormatee
+ *
+ * Cas testé: jour à un chiffre, texte le plus long, bornes de l'intervalle
+ *
+ * Comportement attendu: le nom du jour, le jour sur deux chiffres, le mois
+ * et l'année
+ */
+
+TEST(Date, reqDateFormatee)
+{
+	EXPECT_EQ(Date(8, 5, 1990).reqDateFormatee(), "Mardi le 08 mai 1990");
+	EXPECT_EQ(Date(30, 9, 2037).reqDateFormatee(), "Mercredi le 30 septembre 2037");
+	EXPECT_EQ(Date(1, 1, 1971).reqDateFormatee(), "Vendredi le 01 janvier 1971");
+	EXPECT_EQ(Date(31, 12, 2037).reqDateFormatee(), "Jeudi le 31 decembre 2037");
+	EXPECT_EQ(Date(29, 2, 2000).reqDateFormatee(), "Mardi le 29 fevrier 2000");
+}
+
+/**
+ * Méthode testée: formaterDate
+ *
+ * Cas testés: tampon suffisant, tampon trop petit
+ *
+ * Comportement attendu: le texte de reqDateFormatee(), sans zéro final; une
+ * exception de contrat si le tampon est trop petit
+ */
+
+TEST(Date, formaterDate)
+{
+	char tampon[Date::TAILLE_MAX_DATE_FORMATEE];
+	Date date(30, 9, 2037);
+
+	char* fin = date.formaterDate(tampon, tampon + sizeof(tampon));
+	EXPECT_EQ(std::string(tampon, fin), date.reqDateFormatee());
+
+	EXPECT_THROW(date.formaterDate(tampon, tampon + 8), PreconditionException);
+}
+
+/**
+ * Méthode testée: formaterDates (STATIQUE)
+ *
+ * Cas testé: dates distinctes et répétées
+ *
+ * Comportement attendu: chaque date formatée comme par reqDateFormatee(),
+ * suivie du séparateur
+ */
+
+TEST(Date, formaterDates)
+{
+	std::vector<Date> dates = {Date(8, 5, 1990), Date(1, 1, 1971), Date(8, 5, 1990), Date(31, 12, 2037)};
+	std::vector<char> tampon(dates.size() * (Date::TAILLE_MAX_DATE_FORMATEE + 1));
+	std::string attendu;
+
+	for (const Date& date: dates) attendu += date.reqDateFormatee() + ';';
+
+	char* fin = Date::formaterDates(dates.data(), dates.size(), tampon.data(), tampon.data() + tampon.size(), ';');
+	EXPECT_EQ(std::string(tampon.data(), fin), attendu);
+	EXPECT_EQ(Date::formaterDates(dates.data(), 0, tampon.data(), tampon.data()), tampon.data());
+}
+
+/**
+ * Méthode testée: operator<<
+ *
+ * Cas testé: jour et mois à un chiffre
+ *
+ * Comportement attendu: jj/mm/aaaa
+ */
+
+TEST(Date, operateurSortie)
+{
+	std::ostringstream os;
+
+	os << Date(8, 5, 1990);
+	EXPECT_EQ(os.str(), "08/05/1990");
+}
@@ -0,0 +1,181 @@
+/**
+ * \file testeurDeltaCirconscription.cpp
+ *
+ * Tests unitaires de la classe DeltaCirconscription et de
+ * Circonscription::appliquer.
+ *
+ *  Created on: 2020-12-21
+ * \author Pascal Charpentier
+ */
+
+#include "DeltaCirconscription.h"
+#include "GenerateurInscrits.h"
+#include "gtest/gtest.h"
+#include <memory_resource>
+#include <new>
+
+using namespace elections;
+
+/**
+ * Dispositif de test: une liste de 20 électeurs, et une version à jour où
+ * l'électeur 3 est retiré, l'électeur 21 ajouté, l'électeur 5 a déménagé et
+ * l'électeur 8 est devenu candidat
+ */
+
+class DeltaCirconscriptionTest : public ::testing::Test
+{
+public:
+
+	DeltaCirconscriptionTest() : generateur(2020), ancienne("Lac Saint-Jean", generateur.reqDepute()),
+	                             nouvelle("Lac Saint-Jean", generateur.reqDepute())
+	{
+		generateur.inscrireElecteurs(ancienne, 1, 20);
+		for (std::size_t i = 21; i >= 1; --i)
+		{
+			Electeur e = generateur.reqElecteur(i);
+			if (i == 3) continue;
+			if (i == 5) e.asgAdresse(util::Adresse(10, "des Érables", "Alma", "G8B 1A1", "Québec"));
+			if (i == 8) nouvelle.inscrire(generateur.reqCandidat(i, LIBERAL));
+			else nouvelle.inscrire(e);
+		}
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription ancienne;
+	Circonscription nouvelle;
+};
+
+/**
+ * Méthode testée: constructeur
+ *
+ * Cas testé: deux listes dans des ordres différents
+ *
+ * Comportement attendu: un ajout, un retrait, deux modifications
+ */
+
+TEST_F(DeltaCirconscriptionTest, calculer)
+{
+	DeltaCirconscription delta(ancienne, nouvelle);
+
+	ASSERT_EQ(delta.reqNbAjouts(), 1u);
+	EXPECT_EQ(delta.reqAjout(0).reqNas(), generateur.reqNas(21));
+	ASSERT_EQ(delta.reqNbRetraits(), 1u);
+	EXPECT_EQ(delta.reqRetrait(0), generateur.reqNas(3));
+	ASSERT_EQ(delta.reqNbModifications(), 2u);
+	EXPECT_FALSE(delta.estVide());
+}
+
+/**
+ * Méthode testée: constructeur
+ *
+ * Cas testé: une liste et sa copie
+ *
+ * Comportement attendu: delta vide
+ */
+
+TEST_F(DeltaCirconscriptionTest, listesIdentiques)
+{
+	Circonscription copie(ancienne);
+
+	EXPECT_TRUE(DeltaCirconscription(ancienne, copie).estVide());
+}
+
+/**
+ * Méthodes testées: Circonscription::appliquer, constructeur copie
+ *
+ * Cas testé: copie du delta appliquée à l'ancienne liste
+ *
+ * Comportement attendu: plus aucune différence avec la nouvelle liste; les
+ * inscrits conservés gardent leur ordre
+ */
+
+TEST_F(DeltaCirconscriptionTest, appliquer)
+{
+	DeltaCirconscription delta;
+	delta = DeltaCirconscription(ancienne, nouvelle);
+
+	EXPECT_TRUE(ancienne.appliquer(delta).estValide());
+	EXPECT_EQ(ancienne.reqNbInscrits(), nouvelle.reqNbInscrits());
+	EXPECT_TRUE(DeltaCirconscription(ancienne, nouvelle).estVide());
+	EXPECT_EQ((*ancienne.reqDebutInscrits())->reqNas(), generateur.reqNas(1));
+	EXPECT_NE(dynamic_cast<const Candidat*>(ancienne.reqInscrit(generateur.reqNas(8))), nullptr);
+}
+
+/**
+ * Méthode testée: Circonscription::appliquer
+ *
+ * Cas testé: delta appliqué deux fois
+ *
+ * Comportement attendu: la seconde application est refusée, la liste est inchangée
+ */
+
+TEST_F(DeltaCirconscriptionTest, appliquerDeuxFois)
+{
+	DeltaCirconscription delta(ancienne, nouvelle);
+
+	ASSERT_TRUE(ancienne.appliquer(delta).estValide());
+	std::string avant = ancienne.reqCirconscriptionFormate();
+
+	EXPECT_EQ(ancienne.appliquer(delta).reqErreur(), util::PERSONNE_ABSENTE);
+	EXPECT_EQ(ancienne.reqCirconscriptionFormate(), avant);
+}
+
+/**
+ * \class RessourceDefaillante
+ *
+ * Ressource mémoire qui refuse l'allocation numéro nbAvantEchec, une fois armée
+ */
+
+class RessourceDefaillante : public std::pmr::memory_resource
+{
+public:
+
+	std::size_t nbAvantEchec = 0;
+
+private:
+
+	void* do_allocate(std::size_t p_taille, std::size_t p_alignement) override
+	{
+		if (nbAvantEchec > 0 and --nbAvantEchec == 0)
+			throw std::bad_alloc();
+		return std::pmr::new_delete_resource()->allocate(p_taille, p_alignement);
+	}
+	void do_deallocate(void* p, std::size_t p_taille, std::size_t p_alignement) override
+	{
+		std::pmr::new_delete_resource()->deallocate(p, p_taille, p_alignement);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& p_autre) const noexcept override
+	{
+		return this == &p_autre;
+	}
+};
+
+/**
+ * Méthode testée: Circonscription::appliquer
+ *
+ * Cas testé: la copie de la seconde modification échoue
+ *
+ * Comportement attendu: l'exception est propagée; la liste et ses index sont
+ * inchangés, et le même delta s'applique ensuite normalement
+ */
+
+TEST_F(DeltaCirconscriptionTest, appliquerCopieEnEchec)
+{
+	RessourceDefaillante ressource;
+	DeltaCirconscription delta(ancienne, nouvelle);
+	{
+		Circonscription liste(ancienne, &ressource);
+		liste.indexerParNom();
+		std::string avant = liste.reqCirconscriptionFormate();
+
+		ressource.nbAvantEchec = 2;
+		EXPECT_THROW(liste.appliquer(delta), std::bad_alloc);
+		EXPECT_EQ(liste.reqCirconscriptionFormate(), avant);
+		EXPECT_NE(liste.reqInscrit(generateur.reqNas(3)), nullptr);
+		EXPECT_EQ(liste.reqInscrit(generateur.reqNas(21)), nullptr);
+		EXPECT_TRUE(liste.validerCirconscription());
+
+		EXPECT_TRUE(liste.appliquer(delta).estValide());
+		EXPECT_TRUE(DeltaCirconscription(liste, nouvelle).estVide());
+	}
+}
@@ -0,0 +1,96 @@
+/**
+ * \file testeurDepouillementBulletins.cpp
+ *
+ * Tests unitaires de la classe DepouillementBulletins.
+ *
+ *  Created on: 2020-12-19
+ * \author Pascal Charpentier
+ */
+
+#include "DepouillementBulletins.h"
+#include "GenerateurInscrits.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace elections;
+
+/**
+ * Dispositif de test: une circonscription de 100 électeurs et de trois
+ * candidats, deux libéraux et un conservateur
+ */
+
+class DepouillementBulletinsTest : public ::testing::Test
+{
+public:
+
+	DepouillementBulletinsTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute())
+	{
+		generateur.inscrireElecteurs(circonscription, 1, 100);
+		circonscription.inscrire(generateur.reqCandidat(101, LIBERAL));
+		circonscription.inscrire(generateur.reqCandidat(102, CONSERVATEUR));
+		circonscription.inscrire(generateur.reqCandidat(103, LIBERAL));
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription circonscription;
+};
+
+/**
+ * Méthodes testées: reqNbCandidats, reqIndiceCandidat
+ *
+ * Cas testé: NAS d'un candidat, d'un électeur, mal formé
+ *
+ * Comportement attendu: seuls les candidats ont un indice, dans l'ordre d'inscription
+ */
+
+TEST_F(DepouillementBulletinsTest, candidats)
+{
+	DepouillementBulletins depouillement(circonscription, 2, 2);
+
+	EXPECT_EQ(depouillement.reqNbCandidats(), 3u);
+	EXPECT_EQ(depouillement.reqIndiceCandidat(generateur.reqNas(102)).reqValeur(), 1u);
+	EXPECT_EQ(depouillement.reqCandidat(1).reqPartiPolitique(), CONSERVATEUR);
+	EXPECT_EQ(depouillement.reqIndiceCandidat(generateur.reqNas(50)).reqErreur(), util::PERSONNE_ABSENTE);
+	EXPECT_EQ(depouillement.reqIndiceCandidat("1").reqErreur(), util::NAS_INVALIDE);
+}
+
+/**
+ * Méthodes testées: depouiller, reqResultats
+ *
+ * Cas testé: deux lots, dont un d'un million de bulletins réparti sur 4 fils,
+ * avec des bulletins pour un candidat ou un bureau inexistant
+ *
+ * Comportement attendu: voix exactes par candidat et par parti, bulletins
+ * invalides rejetés
+ */
+
+TEST_F(DepouillementBulletinsTest, depouiller)
+{
+	DepouillementBulletins depouillement(circonscription, 2, 4);
+	std::vector<Bulletin> lot;
+
+	for (std::uint32_t i = 0; i < 1000000; ++i)
+	{
+		lot.push_back(Bulletin{i % 4, i % 3 == 0 ? 2u : 0u});
+	}
+	depouillement.depouiller(lot);
+	depouillement.depouiller(std::vector<Bulletin>{{0, 1}, {2, 1}});
+
+	ResultatsDepouillement resultats = depouillement.reqResultats();
+
+	std::uint64_t attendus[4] = {0, 0, 0, 0};
+	std::uint64_t rejetes = 0;
+	for (std::uint32_t i = 0; i < 1000000; ++i)
+	{
+		if (i % 3 == 0 or i % 4 == 3) ++rejetes;
+		else ++attendus[i % 4];
+	}
+	EXPECT_EQ(resultats.nbBulletins, 1000002u);
+	EXPECT_EQ(resultats.nbRejetes, rejetes);
+	EXPECT_EQ(resultats.voixParCandidat[0], attendus[0] + 1);
+	EXPECT_EQ(resultats.voixParCandidat[1], attendus[1]);
+	EXPECT_EQ(resultats.voixParCandidat[2], attendus[2] + 1);
+	EXPECT_EQ(resultats.voixParParti[LIBERAL], attendus[0] + attendus[2] + 2);
+	EXPECT_EQ(resultats.voixParParti[CONSERVATEUR], attendus[1]);
+	EXPECT_EQ(resultats.voixParParti[BLOC_QUEBECOIS], 0u);
+}
@@ -0,0 +1,124 @@
+/**
+ * \file testeurDetectionDoublons.cpp
+ *
+ * Tests unitaires des fonctions de détection des doublons.
+ *
+ *  Created on: 2020-12-22
+ * \author Pascal Charpentier
+ */
+
+#include "DetectionDoublons.h"
+#include "GenerateurInscrits.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace elections;
+
+/**
+ * Méthode testée: normaliserNom
+ *
+ * Cas testé: accents, minuscules, trait d'union, apostrophe
+ *
+ * Comportement attendu: lettres majuscules sans accents seulement
+ */
+
+TEST(DetectionDoublons, normaliserNom)
+{
+	EXPECT_EQ(normaliserNom("Bélanger"), "BELANGER");
+	EXPECT_EQ(normaliserNom("Jean-François"), "JEANFRANCOIS");
+	EXPECT_EQ(normaliserNom("D'Amours"), "DAMOURS");
+	EXPECT_EQ(normaliserNom("ÉLOÏSE"), "ELOISE");
+}
+
+/**
+ * Méthode testée: distanceEdition
+ *
+ * Cas testé: exemples connus, chaîne vide
+ *
+ * Comportement attendu: distance de Levenshtein
+ */
+
+TEST(DetectionDoublons, distanceEdition)
+{
+	EXPECT_EQ(distanceEdition("KITTEN", "SITTING"), 3u);
+	EXPECT_EQ(distanceEdition("TREMBLAY", "TREMBLAY"), 0u);
+	EXPECT_EQ(distanceEdition("TREMBLAY", "TREMLBAY"), 2u);
+	EXPECT_EQ(distanceEdition("", "GAGNON"), 6u);
+	EXPECT_EQ(distanceEdition("GAGNON", "GAGNO"), 1u);
+}
+
+/**
+ * Méthode testée: distanceEdition
+ *
+ * Cas testé: chaînes aléatoires de 0 à 100 caractères, de part et d'autre de
+ * la limite de 64 caractères du calcul par mots
+ *
+ * Comportement attendu: même distance que le calcul classique
+ */
+
+TEST(DetectionDoublons, distanceEditionAleatoire)
+{
+	std::mt19937 generateur(2020);
+	auto chaine = [&generateur](std::size_t p_longueur)
+	{
+		std::string s;
+		for (std::size_t i = 0; i < p_longueur; ++i) s += static_cast<char>('A' + generateur() % 4);
+		return s;
+	};
+	auto reference = [](const std::string& a, const std::string& b)
+	{
+		std::vector<std::vector<unsigned int>> d(a.size() + 1, std::vector<unsigned int>(b.size() + 1));
+		for (std::size_t i = 0; i <= a.size(); ++i) d[i][0] = i;
+		for (std::size_t j = 0; j <= b.size(); ++j) d[0][j] = j;
+		for (std::size_t i = 1; i <= a.size(); ++i)
+			for (std::size_t j = 1; j <= b.size(); ++j)
+				d[i][j] = std::min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (a[i - 1] != b[j - 1])});
+		return d[a.size()][b.size()];
+	};
+
+	for (int essai = 0; essai < 500; ++essai)
+	{
+		std::string a = chaine(generateur() % 100);
+		std::string b = chaine(generateur() % 100);
+		ASSERT_EQ(distanceEdition(a, b), reference(a, b)) << a << " / " << b;
+	}
+}
+
+/**
+ * Méthode testée: detecterDoublons
+ *
+ * Cas testé: 1000 électeurs synthétiques, plus trois copies sous un autre NAS:
+ * une avec une faute de frappe, une avec nom et prénom inversés, une avec une
+ * autre date de naissance
+ *
+ * Comportement attendu: seules les deux premières copies sont signalées, avec
+ * leur original
+ */
+
+TEST(DetectionDoublons, detecterDoublons)
+{
+	GenerateurInscrits generateur(2020);
+	Circonscription circonscription("Lac Saint-Jean", generateur.reqDepute());
+	generateur.inscrireElecteurs(circonscription, 1, 1000);
+
+	Electeur e10 = generateur.reqElecteur(10);
+	Electeur e20 = generateur.reqElecteur(20);
+	Electeur e30 = generateur.reqElecteur(30);
+	std::string nomModifie = e10.reqNom();
+	nomModifie[1] = nomModifie[1] == 'x' ? 'y' : 'x';
+	circonscription.inscrire(Electeur(generateur.reqNas(1001), nomModifie, e10.reqPrenom(), e10.reqDateNaissance(), e10.reqAdresse()));
+	circonscription.inscrire(Electeur(generateur.reqNas(1002), e20.reqPrenom(), e20.reqNom(), e20.reqDateNaissance(), e20.reqAdresse()));
+	circonscription.inscrire(Electeur(generateur.reqNas(1003), e30.reqNom(), e30.reqPrenom(), util::Date(1, 1, 1990), e30.reqAdresse()));
+
+	std::vector<PaireDoublons> doublons = detecterDoublons(circonscription);
+
+	ASSERT_EQ(doublons.size(), 2u);
+	EXPECT_EQ(doublons[0].premiere->reqNas(), e10.reqNas());
+	EXPECT_EQ(doublons[0].seconde->reqNas(), generateur.reqNas(1001));
+	EXPECT_EQ(doublons[0].distance, 1u);
+	EXPECT_EQ(doublons[1].premiere->reqNas(), e20.reqNas());
+	EXPECT_EQ(doublons[1].distance, 0u);
+}
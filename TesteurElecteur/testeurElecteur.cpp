@@ -47,6 +47,49 @@ TEST(Electeur, constructeurInvalide)
 	EXPECT_THROW(Electeur test("111 111 118", "Pascal", "", date, adresse), PreconditionException);
 }
 
+/**
+ * Méthode testée: creer (STATIQUE)
+ *
+ * Cas testé: paramètres valides et non valides
+ *
+ * Comportement attendu: retourne l'électeur, ou le code du premier champ invalide, sans exception
+ */
+
+TEST(Electeur, creerSansException)
+{
+	util::Adresse adresse(2020, "du Finfin", "Alma", "G8Z 3S3", "Québec");
+	util::Date date(8, 4, 1990);
+
+	util::Resultat<Electeur> valide = Electeur::creer("111 111 118", "Pascal", "Charpentier", date, adresse);
+	ASSERT_TRUE(valide.estValide());
+	EXPECT_EQ(valide.reqValeur().reqNas(), "111 111 118");
+
+	EXPECT_EQ(Electeur::creer("111 111 117", "Pascal", "Charpentier", date, adresse).reqErreur(), util::NAS_INVALIDE);
+	EXPECT_EQ(Electeur::creer("111 111 118", "", "Charpentier", date, adresse).reqErreur(), util::NOM_INVALIDE);
+	EXPECT_EQ(Electeur::creer("111 111 118", "Pascal", "", date, adresse).reqErreur(), util::PRENOM_INVALIDE);
+}
+
+/**
+ * Méthode testée: constructeur de confiance
+ *
+ * Cas testé: paramètres déjà validés
+ *
+ * Comportement attendu: construit le même électeur que le constructeur vérifié
+ */
+
+TEST(Electeur, constructeurDejaValide)
+{
+	util::Adresse adresse(2020, "du Finfin", "Alma", "G8Z 3S3", "Québec", util::DEJA_VALIDE);
+	util::Date date(8, 4, 1990);
+
+	Electeur verifie("111 111 118", "Pascal", "Charpentier", date, adresse);
+	Electeur confiance("111 111 118", "Pascal", "Charpentier", date, adresse, util::DEJA_VALIDE);
+
+	EXPECT_TRUE(confiance == verifie);
+	EXPECT_EQ(confiance.reqType(), TypePersonne::ELECTEUR);
+	EXPECT_TRUE(adresse == util::Adresse(2020, "du Finfin", "Alma", "G8Z 3S3", "Québec"));
+}
+
 /**
  * Dispositif de test pour la classe Electeur
  *
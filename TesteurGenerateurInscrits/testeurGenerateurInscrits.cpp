@@ -0,0 +1,135 @@
+/**
+ * \file testeurGenerateurInscrits.cpp
+ *
+ * Tests unitaires du générateur de listes électorales synthétiques.
+ *
+ *  Created on: 2020-12-15
+ * \author Pascal Charpentier
+ */
+
+#include "GenerateurInscrits.h"
+#include "Circonscription.h"
+#include "ContratException.h"
+#include "persistance.h"
+#include "validationFormat.h"
+#include "gtest/gtest.h"
+#include <set>
+#include <sstream>
+#include <string>
+
+using namespace elections;
+
+/**
+ * Méthode testée: ecrireFichier
+ *
+ * Cas testé: deux générateurs de même germe, puis un germe différent
+ *
+ * Comportement attendu: même germe, même texte; germe différent, texte différent
+ */
+
+TEST(GenerateurInscrits, deterministe)
+{
+	std::ostringstream a, b, c;
+	GenerateurInscrits(42, 0.01).ecrireFichier(a, "Lac Saint-Jean", 500);
+	GenerateurInscrits(42, 0.01).ecrireFichier(b, "Lac Saint-Jean", 500);
+	GenerateurInscrits(43, 0.01).ecrireFichier(c, "Lac Saint-Jean", 500);
+
+	EXPECT_EQ(a.str(), b.str());
+	EXPECT_NE(a.str(), c.str());
+}
+
+/**
+ * Méthodes testées: reqNas, reqElecteur
+ *
+ * Cas testé: 10 000 premiers indices
+ *
+ * Comportement attendu: NAS valides et distincts, électeurs valides
+ */
+
+TEST(GenerateurInscrits, nasValidesEtDistincts)
+{
+	GenerateurInscrits generateur(7);
+	std::set<std::string> lesNas;
+
+	for (std::size_t i = 0; i < 10000; ++i)
+	{
+		std::string nas = generateur.reqNas(i);
+		ASSERT_TRUE(util::validerNas(nas)) << nas;
+		lesNas.insert(nas);
+	}
+	EXPECT_EQ(lesNas.size(), 10000u);
+	EXPECT_TRUE(generateur.reqElecteur(1).valider());
+	EXPECT_TRUE(generateur.reqDepute().valider());
+}
+
+/**
+ * Méthodes testées: ecrireFichier, avec recupererCirconscription
+ *
+ * Cas testé: liste sans bloc invalide, 5% de candidats
+ *
+ * Comportement attendu: le format est valide et le chargeur récupère tous les inscrits
+ */
+
+TEST(GenerateurInscrits, listeValideEstChargee)
+{
+	std::stringstream flux;
+	GenerateurInscrits(3, 0.05).ecrireFichier(flux, "Lac Saint-Jean", 2000);
+
+	EXPECT_TRUE(util::validerFormatFichier(flux));
+	flux.clear();
+	flux.seekg(0);
+
+	Circonscription* circonscription = recupererCirconscription(flux);
+	ASSERT_NE(circonscription, nullptr);
+	EXPECT_EQ(circonscription->reqNbInscrits(), 2000u);
+	delete circonscription;
+}
+
+/**
+ * Méthode testée: ecrireBloc
+ *
+ * Cas testé: proportion d'invalides de 1
+ *
+ * Comportement attendu: aucun bloc, sauf celui du député, n'est accepté par le chargeur
+ */
+
+TEST(GenerateurInscrits, blocsInvalides)
+{
+	GenerateurInscrits generateur(11, 0.0, 1.0);
+	std::string debut;
+	char tampon[GenerateurInscrits::TAILLE_MAX_BLOC];
+
+	debut = "Lac Saint-Jean\n" + std::string(tampon, generateur.ecrireBloc(0, tampon));
+	for (std::size_t i = 1; i <= 50; ++i)
+	{
+		std::istringstream flux(debut + std::string(tampon, generateur.ecrireBloc(i, tampon)));
+		EXPECT_THROW(delete recupererCirconscription(flux), FormatFichierException);
+	}
+}
+
+/**
+ * Méthodes testées: reqCandidat, inscrireElecteurs
+ *
+ * Cas testés: candidat d'un indice donné; électeurs 1 à 50 inscrits, puis
+ * premier indice nul
+ *
+ * Comportement attendu: le candidat a l'identité de l'électeur de même indice
+ * et le parti demandé; la circonscription reçoit les 50 électeurs; l'indice 0,
+ * celui du député, est refusé
+ */
+
+TEST(GenerateurInscrits, candidatsEtCirconscription)
+{
+	GenerateurInscrits generateur(2020);
+	Candidat candidat = generateur.reqCandidat(7, CONSERVATEUR);
+	Circonscription circonscription("Lac Saint-Jean", generateur.reqDepute());
+
+	EXPECT_TRUE(candidat.valider());
+	EXPECT_EQ(static_cast<const Personne&>(candidat), static_cast<const Personne&>(generateur.reqElecteur(7)));
+	EXPECT_EQ(candidat.reqPartiPolitique(), CONSERVATEUR);
+
+	generateur.inscrireElecteurs(circonscription, 1, 50);
+	EXPECT_EQ(circonscription.reqNbInscrits(), 50u);
+	EXPECT_EQ(*circonscription.reqInscrit(generateur.reqNas(50)), generateur.reqElecteur(50));
+	EXPECT_THROW(generateur.inscrireElecteurs(circonscription, 0, 1), PreconditionException);
+}
@@ -0,0 +1,157 @@
+/**
+ * \file testeurHistoriqueModifications.cpp
+ *
+ * Tests unitaires de la classe HistoriqueModifications.
+ *
+ *  Created on: 2020-12-28
+ * \author Pascal Charpentier
+ */
+
+#include "HistoriqueModifications.h"
+#include "ContratException.h"
+#include "Electeur.h"
+#include "GenerateurInscrits.h"
+#include "JournalCirconscription.h"
+#include "persistance.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace elections;
+
+/**
+ * \class HistoriqueModificationsTest
+ *
+ * Dispositif de test: une circonscription de 10 inscrits et une nouvelle
+ * adresse
+ */
+
+class HistoriqueModificationsTest : public ::testing::Test
+{
+public:
+
+	HistoriqueModificationsTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute()),
+	                                adresse(12, "des Érables", "Alma", "G8B 2C2", "Québec")
+	{
+		generateur.inscrireElecteurs(circonscription, 1, 10);
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription circonscription;
+	util::Adresse adresse;
+};
+
+/**
+ * Méthodes testées: inscrire, desinscrire, changerAdresse, annuler, retablir
+ *
+ * Cas testé: une modification de chaque type, toutes annulées puis rétablies
+ *
+ * Comportement attendu: chaque annulation défait la dernière modification,
+ * jusqu'à la liste initiale; les rétablissements les refont dans l'ordre
+ */
+
+TEST_F(HistoriqueModificationsTest, annulerRetablir)
+{
+	HistoriqueModifications historique;
+	Electeur initial = generateur.reqElecteur(4);
+
+	EXPECT_FALSE(historique.peutAnnuler());
+	EXPECT_TRUE(historique.inscrire(circonscription, generateur.reqElecteur(11)).estValide());
+	EXPECT_TRUE(historique.desinscrire(circonscription, generateur.reqNas(3)).estValide());
+	EXPECT_TRUE(historique.changerAdresse(circonscription, generateur.reqNas(4), adresse).estValide());
+	EXPECT_EQ(circonscription.reqInscrit(generateur.reqNas(4))->reqAdresse(), adresse);
+	EXPECT_EQ(historique.reqNbModifications(), 3u);
+
+	EXPECT_EQ(historique.reqTypeAnnulation(), HistoriqueModifications::CHANGEMENT_ADRESSE);
+	EXPECT_TRUE(historique.annuler(circonscription).estValide());
+	EXPECT_EQ(*circonscription.reqInscrit(generateur.reqNas(4)), initial);
+	EXPECT_EQ(historique.reqTypeAnnulation(), HistoriqueModifications::DESINSCRIPTION);
+	EXPECT_TRUE(historique.annuler(circonscription).estValide());
+	EXPECT_NE(circonscription.reqInscrit(generateur.reqNas(3)), nullptr);
+	EXPECT_EQ(historique.reqTypeAnnulation(), HistoriqueModifications::INSCRIPTION);
+	EXPECT_TRUE(historique.annuler(circonscription).estValide());
+	EXPECT_EQ(circonscription.reqInscrit(generateur.reqNas(11)), nullptr);
+	EXPECT_EQ(circonscription.reqNbInscrits(), 10u);
+	EXPECT_FALSE(historique.peutAnnuler());
+	EXPECT_THROW(historique.annuler(circonscription), PreconditionException);
+
+	EXPECT_EQ(historique.reqTypeRetablissement(), HistoriqueModifications::INSCRIPTION);
+	while (historique.peutRetablir()) EXPECT_TRUE(historique.retablir(circonscription).estValide());
+	EXPECT_NE(circonscription.reqInscrit(generateur.reqNas(11)), nullptr);
+	EXPECT_EQ(circonscription.reqInscrit(generateur.reqNas(3)), nullptr);
+	EXPECT_EQ(circonscription.reqInscrit(generateur.reqNas(4))->reqAdresse(), adresse);
+}
+
+/**
+ * Méthodes testées: inscrire, desinscrire, changerAdresse
+ *
+ * Cas testés: modifications refusées, nouvelle modification après une
+ * annulation, profondeur maximale dépassée
+ *
+ * Comportement attendu: une modification refusée n'est pas retenue; une
+ * nouvelle modification efface celles qui étaient annulées; les plus
+ * anciennes sont oubliées au-delà de la profondeur maximale
+ */
+
+TEST_F(HistoriqueModificationsTest, pileDesModifications)
+{
+	HistoriqueModifications historique(3);
+
+	EXPECT_EQ(historique.inscrire(circonscription, generateur.reqElecteur(1)).reqErreur(), util::PERSONNE_DEJA_PRESENTE);
+	EXPECT_EQ(historique.desinscrire(circonscription, generateur.reqNas(11)).reqErreur(), util::PERSONNE_ABSENTE);
+	EXPECT_EQ(historique.changerAdresse(circonscription, "123", adresse).reqErreur(), util::NAS_INVALIDE);
+	EXPECT_EQ(historique.reqNbModifications(), 0u);
+
+	historique.desinscrire(circonscription, generateur.reqNas(1));
+	historique.desinscrire(circonscription, generateur.reqNas(2));
+	historique.annuler(circonscription);
+	historique.desinscrire(circonscription, generateur.reqNas(5));
+	EXPECT_FALSE(historique.peutRetablir());
+	EXPECT_EQ(historique.reqNbModifications(), 2u);
+
+	historique.desinscrire(circonscription, generateur.reqNas(6));
+	historique.desinscrire(circonscription, generateur.reqNas(7));
+	EXPECT_EQ(historique.reqNbModifications(), 3u);
+	while (historique.peutAnnuler()) historique.annuler(circonscription);
+	EXPECT_EQ(circonscription.reqInscrit(generateur.reqNas(1)), nullptr);
+	EXPECT_EQ(circonscription.reqNbInscrits(), 9u);
+
+	EXPECT_THROW(HistoriqueModifications(0), PreconditionException);
+}
+
+/**
+ * Méthodes testées: asgJournal, annuler
+ *
+ * Cas testé: modifications et annulation journalisées, puis restauration
+ *
+ * Comportement attendu: la circonscription restaurée tient compte de
+ * l'annulation
+ */
+
+TEST_F(HistoriqueModificationsTest, journaliser)
+{
+	const std::string fichier("testeurHistorique.circ");
+	{
+		std::ofstream os(fichier.c_str(), std::ios::binary);
+		sauvegarderCirconscription(os, circonscription);
+	}
+	{
+		JournalCirconscription journal(fichier);
+		HistoriqueModifications historique;
+		historique.asgJournal(&journal);
+
+		historique.desinscrire(circonscription, generateur.reqNas(3));
+		historique.changerAdresse(circonscription, generateur.reqNas(4), adresse);
+		historique.annuler(circonscription);
+		EXPECT_EQ(journal.reqNbEnregistrements(), 3u);
+
+		Circonscription* restauree = journal.restaurer();
+		EXPECT_EQ(restauree->reqInscrit(generateur.reqNas(3)), nullptr);
+		EXPECT_EQ(*restauree->reqInscrit(generateur.reqNas(4)), generateur.reqElecteur(4));
+		EXPECT_EQ(restauree->reqNbInscrits(), 9u);
+		delete restauree;
+	}
+	std::remove(fichier.c_str());
+	std::remove((fichier + JournalCirconscription::EXTENSION_JOURNAL).c_str());
+}
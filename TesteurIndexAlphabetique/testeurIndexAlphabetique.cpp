@@ -0,0 +1,193 @@
+/**
+ * \file testeurIndexAlphabetique.cpp
+ *
+ * Tests unitaires de la classe IndexAlphabetique et des clés de collation.
+ *
+ *  Created on: 2020-12-24
+ * \author Pascal Charpentier
+ */
+
+#include "IndexAlphabetique.h"
+#include "BassinDeTaches.h"
+#include "Circonscription.h"
+#include "Electeur.h"
+#include "GenerateurInscrits.h"
+#include "gtest/gtest.h"
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace elections;
+
+/**
+ * Méthode testée: cleCollation
+ *
+ * Cas testés: accents, accents lus de la fin du mot, casse, ligature, trait
+ * d'union
+ *
+ * Comportement attendu: les clés sont dans l'ordre alphabétique français
+ */
+
+TEST(IndexAlphabetique, cleCollation)
+{
+	std::vector<std::string> ordonnes = {"Edmond", "emond", "Emond", "Émond", "Emonet", "Zola"};
+	for (std::size_t i = 0; i + 1 < ordonnes.size(); ++i)
+		EXPECT_LT(cleCollation(ordonnes[i]), cleCollation(ordonnes[i + 1])) << ordonnes[i];
+
+	std::vector<std::string> accents = {"cote", "côte", "coté", "côté"};
+	for (std::size_t i = 0; i + 1 < accents.size(); ++i)
+		EXPECT_LT(cleCollation(accents[i]), cleCollation(accents[i + 1])) << accents[i];
+
+	EXPECT_LT(cleCollation("Coeur"), cleCollation("Cœur"));
+	EXPECT_LT(cleCollation("Cœur"), cleCollation("Coeurs"));
+	EXPECT_LT(cleCollation("Sainte"), cleCollation("Saint-Pierre"));
+	EXPECT_LT(cleCollation("Saint Pierre"), cleCollation("Saint-Pierre"));
+}
+
+/**
+ * \class IndexAlphabetiqueTest
+ *
+ * Dispositif de test: une circonscription de quelques inscrits aux noms
+ * accentués
+ */
+
+class IndexAlphabetiqueTest : public ::testing::Test
+{
+public:
+
+	IndexAlphabetiqueTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute())
+	{
+		inscrire(1, "Émond", "Alain");
+		inscrire(2, "Zola", "Émile");
+		inscrire(3, "Emond", "Zoé");
+		inscrire(4, "Bélanger", "Marc");
+		inscrire(5, "Belanger", "Luc");
+	}
+
+	void inscrire(std::size_t p_indice, const std::string& p_nom, const std::string& p_prenom)
+	{
+		circonscription.inscrire(Electeur(generateur.reqNas(p_indice), p_nom, p_prenom, util::Date(1, 1, 1980),
+		                                  util::Adresse(1, "Principale", "Alma", "G8B 1A1", "Québec")));
+	}
+
+	std::vector<std::string> reqNoms() const
+	{
+		std::vector<std::string> noms;
+		const IndexAlphabetique* index = circonscription.reqIndexAlphabetique();
+		for (auto it = index->reqDebut(); it != index->reqFin(); ++it)
+			noms.push_back(it->second->reqNom() + ", " + it->second->reqPrenom());
+		return noms;
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription circonscription;
+};
+
+/**
+ * Méthodes testées: Circonscription::indexerParNom, reqIndexAlphabetique
+ *
+ * Cas testé: noms accentués inscrits dans le désordre
+ *
+ * Comportement attendu: l'index est absent avant indexerParNom(), puis range
+ * les inscrits par nom et prénom sans égard aux accents
+ */
+
+TEST_F(IndexAlphabetiqueTest, indexerParNom)
+{
+	EXPECT_EQ(circonscription.reqIndexAlphabetique(), nullptr);
+
+	circonscription.indexerParNom();
+
+	std::vector<std::string> attendus = {"Belanger, Luc", "Bélanger, Marc", "Émond, Alain", "Emond, Zoé", "Zola, Émile"};
+	EXPECT_EQ(reqNoms(), attendus);
+}
+
+/**
+ * Méthodes testées: inscrire, desinscrire, remplacer, constructeur copie
+ *
+ * Cas testé: modifications après indexerParNom(), dont un remplacement qui
+ * garde le nom
+ *
+ * Comportement attendu: l'index suit la liste et désigne la nouvelle version,
+ * et la copie a son propre index
+ */
+
+TEST_F(IndexAlphabetiqueTest, suitLesModifications)
+{
+	circonscription.indexerParNom();
+
+	inscrire(6, "Archambault", "Jeanne");
+	circonscription.desinscrire(generateur.reqNas(2));
+	circonscription.remplacer(Electeur(generateur.reqNas(4), "Tremblay", "Marc", util::Date(1, 1, 1980),
+	                                   util::Adresse(1, "Principale", "Alma", "G8B 1A1", "Québec")));
+
+	std::vector<std::string> attendus = {"Archambault, Jeanne", "Belanger, Luc", "Émond, Alain", "Emond, Zoé", "Tremblay, Marc"};
+	EXPECT_EQ(reqNoms(), attendus);
+
+	circonscription.remplacer(Electeur(generateur.reqNas(5), "Belanger", "Luc", util::Date(1, 1, 1980),
+	                                   util::Adresse(2, "Principale", "Alma", "G8B 1A1", "Québec")));
+	EXPECT_EQ(reqNoms(), attendus);
+	EXPECT_EQ(circonscription.reqIndexAlphabetique()->reqInscritsNom("Belanger").first->second,
+	          circonscription.reqInscrit(generateur.reqNas(5)));
+
+	Circonscription copie(circonscription);
+	circonscription.desinscrire(generateur.reqNas(6));
+	ASSERT_NE(copie.reqIndexAlphabetique(), nullptr);
+	EXPECT_EQ(copie.reqIndexAlphabetique()->reqNbInscrits(), 5u);
+	EXPECT_EQ(copie.reqIndexAlphabetique()->reqDebut()->second->reqNom(), "Archambault");
+}
+
+/**
+ * Méthode testée: reqInscritsNom
+ *
+ * Cas testés: nom en majuscules sans accent, nom absent
+ *
+ * Comportement attendu: les inscrits de ce nom, accentué ou non, par prénom;
+ * un intervalle vide pour un nom absent
+ */
+
+TEST_F(IndexAlphabetiqueTest, reqInscritsNom)
+{
+	circonscription.indexerParNom();
+
+	IndexAlphabetique::Intervalle_t emond = circonscription.reqIndexAlphabetique()->reqInscritsNom("EMOND");
+	ASSERT_NE(emond.first, emond.second);
+	EXPECT_EQ(emond.first->second->reqPrenom(), "Alain");
+	EXPECT_EQ(std::next(emond.first)->second->reqPrenom(), "Zoé");
+	EXPECT_EQ(std::next(emond.first, 2), emond.second);
+
+	IndexAlphabetique::Intervalle_t absent = circonscription.reqIndexAlphabetique()->reqInscritsNom("Emon");
+	EXPECT_EQ(absent.first, absent.second);
+}
+
+/**
+ * Méthode testée: construire
+ *
+ * Cas testé: 3000 inscrits, construction dans le fil appelant et par un
+ * bassin de 4 fils
+ *
+ * Comportement attendu: le même ordre, croissant selon cleAlphabetique()
+ */
+
+TEST(IndexAlphabetique, construireEnParallele)
+{
+	GenerateurInscrits generateur(2020);
+	std::vector<Personne*> inscrits;
+	for (std::size_t i = 1; i <= 3000; ++i) inscrits.push_back(generateur.reqElecteur(i).clone());
+
+	util::BassinDeTaches bassin(4);
+	IndexAlphabetique sequentiel;
+	IndexAlphabetique parallele;
+	sequentiel.construire(inscrits.begin(), inscrits.end());
+	parallele.construire(inscrits.begin(), inscrits.end(), &bassin);
+
+	ASSERT_EQ(parallele.reqNbInscrits(), inscrits.size());
+	auto s = sequentiel.reqDebut();
+	for (auto p = parallele.reqDebut(); p != parallele.reqFin(); ++p, ++s)
+	{
+		EXPECT_EQ(p->second, s->second);
+		EXPECT_EQ(p->first, cleAlphabetique(*p->second));
+	}
+
+	for (Personne* p: inscrits) delete p;
+}
@@ -0,0 +1,148 @@
+/**
+ * \file testeurIndexCodesPostaux.cpp
+ *
+ * Tests unitaires de la classe IndexCodesPostaux.
+ *
+ *  Created on: 2020-12-22
+ * \author Pascal Charpentier
+ */
+
+#include "IndexCodesPostaux.h"
+#include "ContratException.h"
+#include "Electeur.h"
+#include "GenerateurInscrits.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace elections;
+using util::CodePostal;
+
+/**
+ * \class IndexCodesPostauxTest
+ *
+ * Dispositif de test: une circonscription de 2000 inscrits aléatoires, plus
+ * deux inscrits à une adresse américaine
+ */
+
+class IndexCodesPostauxTest : public ::testing::Test
+{
+public:
+
+	IndexCodesPostauxTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute())
+	{
+		generateur.inscrireElecteurs(circonscription, 1, 2000);
+		for (std::size_t i = 2001; i <= 2002; ++i)
+		{
+			Electeur e = generateur.reqElecteur(i);
+			circonscription.inscrire(Electeur(e.reqNas(), e.reqNom(), e.reqPrenom(), e.reqDateNaissance(),
+			                                  util::Adresse(1600, "Pennsylvania Avenue", "Washington", "20500", "DC")));
+		}
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription    circonscription;
+};
+
+/**
+ * Méthode testée: reqInscritsRegion
+ *
+ * Cas testé: chaque région qui a au moins un inscrit
+ *
+ * Comportement attendu: exactement les inscrits de la région, ordonnés par
+ * code, et dans l'ordre de la liste à code égal
+ */
+
+TEST_F(IndexCodesPostauxTest, reqInscritsRegion)
+{
+	IndexCodesPostaux index(circonscription);
+	std::size_t total = 0;
+
+	EXPECT_EQ(index.reqNbInscrits(), 2000u);
+	for (std::uint32_t r = 0; r < CodePostal::NB_REGIONS_TRI; ++r)
+	{
+		std::vector<const Personne*> attendus;
+		for (auto it = circonscription.reqDebutInscrits(); it != circonscription.reqFinInscrits(); ++it)
+		{
+			CodePostal code = (*it)->reqAdresse().reqCodePostalCompact();
+			if (code.estValide() and code.reqRegionTri() == r) attendus.push_back(*it);
+		}
+		std::stable_sort(attendus.begin(), attendus.end(), [](const Personne* a, const Personne* b)
+		{
+			return a->reqAdresse().reqCodePostalCompact() < b->reqAdresse().reqCodePostalCompact();
+		});
+
+		IndexCodesPostaux::Intervalle_t region = index.reqInscritsRegion(r);
+		ASSERT_EQ(std::vector<const Personne*>(region.first, region.second), attendus);
+		EXPECT_EQ(index.reqNbInscritsRegion(r), attendus.size());
+		total += attendus.size();
+	}
+	EXPECT_EQ(total, 2000u);
+}
+
+/**
+ * Méthode testée: reqInscritsRegion par texte
+ *
+ * Cas testé: région d'un inscrit, région mal formée
+ *
+ * Comportement attendu: même intervalle que par numéro; ADRESSE_INVALIDE
+ */
+
+TEST_F(IndexCodesPostauxTest, reqInscritsRegionTexte)
+{
+	IndexCodesPostaux index(circonscription);
+	CodePostal code = (*circonscription.reqDebutInscrits())->reqAdresse().reqCodePostalCompact();
+
+	util::Resultat<IndexCodesPostaux::Intervalle_t> region = index.reqInscritsRegion(code.reqTexteRegionTri());
+	ASSERT_TRUE(region.estValide());
+	EXPECT_TRUE(region.reqValeur() == index.reqInscritsRegion(code.reqRegionTri()));
+	EXPECT_NE(region.reqValeur().first, region.reqValeur().second);
+	EXPECT_EQ(index.reqInscritsRegion("G8").reqErreur(), util::ADRESSE_INVALIDE);
+	EXPECT_THROW(index.reqInscritsRegion(CodePostal::NB_REGIONS_TRI), PreconditionException);
+}
+
+/**
+ * Méthode testée: reqInscritsCode, reqInscritsEntre
+ *
+ * Cas testé: un code existant, l'intervalle complet, intervalle inversé
+ *
+ * Comportement attendu: les inscrits dont le code est dans l'intervalle
+ */
+
+TEST_F(IndexCodesPostauxTest, reqInscritsEntre)
+{
+	IndexCodesPostaux index(circonscription);
+	CodePostal code = (*circonscription.reqDebutInscrits())->reqAdresse().reqCodePostalCompact();
+
+	IndexCodesPostaux::Intervalle_t memeCode = index.reqInscritsCode(code);
+	ASSERT_NE(memeCode.first, memeCode.second);
+	for (auto it = memeCode.first; it != memeCode.second; ++it)
+		EXPECT_EQ((*it)->reqAdresse().reqCodePostalCompact(), code);
+
+	IndexCodesPostaux::Intervalle_t tout = index.reqInscritsEntre(CodePostal("A0A 0A0"), CodePostal("Z9Z 9Z9"));
+	EXPECT_EQ(static_cast<std::size_t>(tout.second - tout.first), 2000u);
+
+	IndexCodesPostaux::Intervalle_t inverse = index.reqInscritsEntre(CodePostal("Z9Z 9Z9"), CodePostal("A0A 0A0"));
+	EXPECT_EQ(inverse.first, inverse.second);
+	IndexCodesPostaux::Intervalle_t absent = index.reqInscritsCode(CodePostal());
+	EXPECT_EQ(absent.first, absent.second);
+}
+
+/**
+ * Méthode testée: reqInscritsHorsCanada
+ *
+ * Cas testé: dispositif de test
+ *
+ * Comportement attendu: les deux inscrits à une adresse américaine
+ */
+
+TEST_F(IndexCodesPostauxTest, reqInscritsHorsCanada)
+{
+	IndexCodesPostaux index(circonscription);
+	IndexCodesPostaux::Intervalle_t horsCanada = index.reqInscritsHorsCanada();
+
+	ASSERT_EQ(horsCanada.second - horsCanada.first, 2);
+	EXPECT_EQ((*horsCanada.first)->reqNas(), generateur.reqNas(2001));
+	EXPECT_EQ((*(horsCanada.first + 1))->reqNas(), generateur.reqNas(2002));
+}
@@ -0,0 +1,135 @@
+/**
+ * \file testeurIndexNas.cpp
+ *
+ * Tests unitaires du gabarit IndexNas.
+ *
+ *  Created on: 2020-12-16
+ * \author Pascal Charpentier
+ */
+
+#include "IndexNas.h"
+#include "validationFormat.h"
+#include "gtest/gtest.h"
+#include <map>
+
+using namespace util;
+
+/**
+ * Fonction testée: compacterNas
+ *
+ * Cas testé: NAS avec espaces et avec tirets
+ *
+ * Comportement attendu: les séparateurs sont ignorés
+ */
+
+TEST(IndexNas, compacterNas)
+{
+	EXPECT_EQ(compacterNas("046 454 286"), 46454286u);
+	EXPECT_EQ(compacterNas("245-367 996"), compacterNas("245 367 996"));
+}
+
+/**
+ * Fonction testée: compacterNas
+ *
+ * Cas testés: trop de chiffres, pas assez de chiffres, séparateur interdit
+ *
+ * Comportement attendu: la clé invalide, même si les chiffres, lus modulo
+ * 2^32, donneraient la clé d'un autre NAS
+ */
+
+TEST(IndexNas, compacterNasMalForme)
+{
+	EXPECT_EQ(compacterNas("4341421582"), CLE_NAS_INVALIDE);
+	EXPECT_EQ(compacterNas("4294967295"), CLE_NAS_INVALIDE);
+	EXPECT_EQ(compacterNas("046 454 28"), CLE_NAS_INVALIDE);
+	EXPECT_EQ(compacterNas("046 454 2866"), CLE_NAS_INVALIDE);
+	EXPECT_EQ(compacterNas("046/454/286"), CLE_NAS_INVALIDE);
+	EXPECT_EQ(compacterNas(""), CLE_NAS_INVALIDE);
+}
+
+/**
+ * Méthodes testées: inserer, trouver, retirer
+ *
+ * Cas testé: ajout d'une clé, doublon, retrait, retrait d'une clé absente
+ *
+ * Comportement attendu: un doublon est refusé sans modifier la valeur; une clé
+ * retirée est introuvable
+ */
+
+TEST(IndexNas, insererTrouverRetirer)
+{
+	IndexNas<int> index;
+
+	EXPECT_TRUE(index.inserer(111111118, 1));
+	EXPECT_FALSE(index.inserer(111111118, 2));
+	ASSERT_NE(index.trouver(111111118), nullptr);
+	EXPECT_EQ(*index.trouver(111111118), 1);
+	EXPECT_EQ(index.trouver(222222226), nullptr);
+
+	EXPECT_TRUE(index.retirer(111111118));
+	EXPECT_FALSE(index.retirer(111111118));
+	EXPECT_EQ(index.trouver(111111118), nullptr);
+	EXPECT_EQ(index.reqNbElements(), 0u);
+}
+
+/**
+ * Méthodes testées: trouver, retirer
+ *
+ * Cas testé: clés réservées aux cases vides et libérées, dans une table vide
+ * puis après un retrait
+ *
+ * Comportement attendu: introuvables, et le retrait est refusé
+ */
+
+TEST(IndexNas, clesReservees)
+{
+	IndexNas<int> index;
+	const IndexNas<int>& constante = index;
+
+	EXPECT_EQ(index.trouver(CLE_NAS_INVALIDE), nullptr);
+	EXPECT_EQ(constante.trouver(CLE_NAS_INVALIDE - 1), nullptr);
+
+	index.inserer(111111118, 1);
+	index.retirer(111111118);
+	EXPECT_EQ(index.trouver(CLE_NAS_INVALIDE), nullptr);
+	EXPECT_EQ(index.trouver(CLE_NAS_INVALIDE - 1), nullptr);
+	EXPECT_FALSE(index.retirer(CLE_NAS_INVALIDE - 1));
+	EXPECT_EQ(index.reqNbElements(), 0u);
+}
+
+/**
+ * Méthodes testées: inserer, retirer, trouver
+ *
+ * Cas testé: 100 000 clés insérées puis une sur deux retirées et réinsérée avec
+ * une autre valeur, comparé à std::map
+ *
+ * Comportement attendu: l'index et la map contiennent les mêmes associations
+ */
+
+TEST(IndexNas, conformeAStdMap)
+{
+	IndexNas<unsigned int> index;
+	std::map<unsigned int, unsigned int> reference;
+
+	for (unsigned int i = 0; i < 100000; ++i)
+	{
+		unsigned int cle = (i * 2654435761u) % 1000000000u;
+		index.inserer(cle, i);
+		reference.emplace(cle, i);
+	}
+	for (unsigned int i = 0; i < 100000; i += 2)
+	{
+		unsigned int cle = (i * 2654435761u) % 1000000000u;
+		index.retirer(cle);
+		index.inserer(cle, i + 1);
+		reference[cle] = i + 1;
+	}
+
+	ASSERT_EQ(index.reqNbElements(), reference.size());
+	for (const auto& association: reference)
+	{
+		const unsigned int* valeur = index.trouver(association.first);
+		ASSERT_NE(valeur, nullptr);
+		EXPECT_EQ(*valeur, association.second);
+	}
+}
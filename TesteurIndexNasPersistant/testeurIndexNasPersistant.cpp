@@ -0,0 +1,119 @@
+/**
+ * \file testeurIndexNasPersistant.cpp
+ *
+ * Tests unitaires du gabarit IndexNasPersistant.
+ *
+ *  Created on: 2020-12-27
+ * \author Pascal Charpentier
+ */
+
+#include "IndexNasPersistant.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <map>
+#include <random>
+
+using namespace util;
+
+/**
+ * Méthodes testées: inserer, trouver, remplacer, retirer
+ *
+ * Cas testé: ajout d'une clé, doublon, remplacement, retrait, clés extrêmes
+ *
+ * Comportement attendu: un doublon est refusé sans modifier la valeur; une
+ * clé absente ne peut être remplacée ni retirée
+ */
+
+TEST(IndexNasPersistant, insererTrouverRetirer)
+{
+	IndexNasPersistant<int> index;
+
+	EXPECT_EQ(index.trouver(111111118), nullptr);
+	EXPECT_TRUE(index.inserer(111111118, 1));
+	EXPECT_FALSE(index.inserer(111111118, 2));
+	ASSERT_NE(index.trouver(111111118), nullptr);
+	EXPECT_EQ(*index.trouver(111111118), 1);
+	EXPECT_EQ(index.trouver(111111119), nullptr);
+
+	EXPECT_TRUE(index.remplacer(111111118, 3));
+	EXPECT_EQ(*index.trouver(111111118), 3);
+	EXPECT_FALSE(index.remplacer(222222226, 4));
+
+	EXPECT_TRUE(index.inserer(0, 5));
+	EXPECT_TRUE(index.inserer(999999999, 6));
+	EXPECT_EQ(index.reqNbElements(), 3u);
+
+	EXPECT_TRUE(index.retirer(111111118));
+	EXPECT_FALSE(index.retirer(111111118));
+	EXPECT_EQ(index.trouver(111111118), nullptr);
+	EXPECT_EQ(*index.trouver(0), 5);
+	EXPECT_EQ(*index.trouver(999999999), 6);
+	EXPECT_EQ(index.reqNbElements(), 2u);
+}
+
+/**
+ * Méthodes testées: constructeur copie, inserer, remplacer, retirer
+ *
+ * Cas testé: une copie modifiée après coup
+ *
+ * Comportement attendu: l'original est inchangé, et les valeurs que la copie
+ * n'a pas touchées sont partagées avec lui
+ */
+
+TEST(IndexNasPersistant, versionsIndependantes)
+{
+	IndexNasPersistant<int> original;
+	for (std::uint32_t cle = 1000; cle < 2000; ++cle) original.inserer(cle * 7919, static_cast<int>(cle));
+
+	IndexNasPersistant<int> copie = original;
+	copie.retirer(1000 * 7919);
+	copie.remplacer(1001 * 7919, -1);
+	copie.inserer(1, 1);
+
+	EXPECT_EQ(original.reqNbElements(), 1000u);
+	EXPECT_EQ(copie.reqNbElements(), 1000u);
+	EXPECT_EQ(*original.trouver(1000 * 7919), 1000);
+	EXPECT_EQ(*original.trouver(1001 * 7919), 1001);
+	EXPECT_EQ(original.trouver(1), nullptr);
+	EXPECT_EQ(*copie.trouver(1001 * 7919), -1);
+	EXPECT_EQ(original.trouver(1999 * 7919), copie.trouver(1999 * 7919));
+}
+
+/**
+ * Méthodes testées: inserer, remplacer, retirer, parcourir
+ *
+ * Cas testé: 20 000 opérations aléatoires, comparées à std::map
+ *
+ * Comportement attendu: le même contenu, parcouru par clé croissante
+ */
+
+TEST(IndexNasPersistant, commeStdMap)
+{
+	IndexNasPersistant<std::uint32_t> index;
+	std::map<std::uint32_t, std::uint32_t> reference;
+	std::mt19937 generateur(2020);
+	std::uniform_int_distribution<std::uint32_t> cles(0, 4999);
+
+	for (std::uint32_t i = 0; i < 20000; ++i)
+	{
+		std::uint32_t cle = cles(generateur) * 199999;
+		switch (generateur() % 3)
+		{
+		case 0: EXPECT_EQ(index.inserer(cle, i), reference.emplace(cle, i).second); break;
+		case 1: EXPECT_EQ(index.retirer(cle), reference.erase(cle) == 1); break;
+		default:
+			EXPECT_EQ(index.remplacer(cle, i), reference.count(cle) == 1);
+			if (reference.count(cle)) reference[cle] = i;
+		}
+	}
+
+	ASSERT_EQ(index.reqNbElements(), reference.size());
+	auto attendu = reference.begin();
+	index.parcourir([&attendu](std::uint32_t p_cle, std::uint32_t p_valeur)
+	{
+		EXPECT_EQ(p_cle, attendu->first);
+		EXPECT_EQ(p_valeur, attendu->second);
+		++attendu;
+	});
+	EXPECT_EQ(attendu, reference.end());
+}
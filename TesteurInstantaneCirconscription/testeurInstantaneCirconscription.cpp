@@ -0,0 +1,225 @@
+/**
+ * \file testeurInstantaneCirconscription.cpp
+ *
+ * Tests unitaires de la classe InstantaneCirconscription et des instantanés
+ * d'une Circonscription.
+ *
+ *  Created on: 2020-12-27
+ * \author Pascal Charpentier
+ */
+
+#include "InstantaneCirconscription.h"
+#include "ContratException.h"
+#include "Electeur.h"
+#include "GenerateurInscrits.h"
+#include "validationFormat.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace elections;
+
+/**
+ * \class InstantaneCirconscriptionTest
+ *
+ * Dispositif de test: une circonscription de 100 inscrits aléatoires
+ */
+
+class InstantaneCirconscriptionTest : public ::testing::Test
+{
+public:
+
+	InstantaneCirconscriptionTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute())
+	{
+		generateur.inscrireElecteurs(circonscription, 1, 100);
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription circonscription;
+};
+
+/**
+ * Méthodes testées: activerInstantanes, reqInstantane
+ *
+ * Cas testés: instantané demandé avant et après activerInstantanes()
+ *
+ * Comportement attendu: exception de contrat avant; après, l'instantané a le
+ * nom, le député et les inscrits de la circonscription
+ */
+
+TEST_F(InstantaneCirconscriptionTest, reqInstantane)
+{
+	EXPECT_THROW(circonscription.reqInstantane(), PreconditionException);
+
+	circonscription.activerInstantanes();
+	InstantaneCirconscription instantane = circonscription.reqInstantane();
+
+	EXPECT_EQ(instantane.reqNomCirconscription(), "Lac Saint-Jean");
+	EXPECT_EQ(instantane.reqDeputeElu(), circonscription.reqDeputeElu());
+	ASSERT_EQ(instantane.reqNbInscrits(), 100u);
+	for (auto it = circonscription.reqDebutInscrits(); it != circonscription.reqFinInscrits(); ++it)
+	{
+		ASSERT_NE(instantane.reqInscrit((*it)->reqNas()), nullptr);
+		EXPECT_EQ(*instantane.reqInscrit((*it)->reqNas()), **it);
+	}
+	EXPECT_EQ(instantane.reqInscrit(generateur.reqNas(101)), nullptr);
+}
+
+/**
+ * Méthode testée: InstantaneCirconscription::reqInscrit
+ *
+ * Cas testé: NAS de 10 chiffres, dont l'un donnerait, lu modulo 2^32, le NAS
+ * d'un inscrit
+ *
+ * Comportement attendu: nullptr, sans exception
+ */
+
+TEST_F(InstantaneCirconscriptionTest, reqInscritNasMalForme)
+{
+	circonscription.inscrire(Electeur("046 454 286", "Stark", "Arya", util::Date(3, 1, 2007),
+	                                  util::Adresse(1, "Winterfell", "The North", "X3X 3X3", "Westeros")));
+	circonscription.activerInstantanes();
+	InstantaneCirconscription instantane = circonscription.reqInstantane();
+
+	ASSERT_NE(instantane.reqInscrit("046 454 286"), nullptr);
+	EXPECT_EQ(instantane.reqInscrit("4341421582"), nullptr);
+	EXPECT_EQ(instantane.reqInscrit("4294967295"), nullptr);
+	EXPECT_NO_THROW(EXPECT_EQ(instantane.reqInscrit("9999999999"), nullptr));
+}
+
+/**
+ * Méthodes testées: reqInstantane, inscrire, desinscrire, remplacer
+ *
+ * Cas testé: deux instantanés séparés par des modifications
+ *
+ * Comportement attendu: le premier est inchangé, le second les reflète, et
+ * les inscrits non modifiés sont partagés par les deux
+ */
+
+TEST_F(InstantaneCirconscriptionTest, figeParModifications)
+{
+	circonscription.activerInstantanes();
+	InstantaneCirconscription avant = circonscription.reqInstantane();
+
+	circonscription.inscrire(generateur.reqElecteur(101));
+	circonscription.desinscrire(generateur.reqNas(1));
+	Electeur e = generateur.reqElecteur(2);
+	Electeur demenage(e.reqNas(), e.reqNom(), e.reqPrenom(), e.reqDateNaissance(),
+	                  util::Adresse(12, "des Érables", "Alma", "G8B 2C2", "Québec"));
+	circonscription.remplacer(demenage);
+	InstantaneCirconscription apres = circonscription.reqInstantane();
+
+	EXPECT_EQ(avant.reqNbInscrits(), 100u);
+	EXPECT_NE(avant.reqInscrit(generateur.reqNas(1)), nullptr);
+	EXPECT_EQ(avant.reqInscrit(generateur.reqNas(101)), nullptr);
+	EXPECT_EQ(*avant.reqInscrit(generateur.reqNas(2)), e);
+
+	EXPECT_EQ(apres.reqNbInscrits(), 100u);
+	EXPECT_EQ(apres.reqInscrit(generateur.reqNas(1)), nullptr);
+	EXPECT_NE(apres.reqInscrit(generateur.reqNas(101)), nullptr);
+	EXPECT_EQ(*apres.reqInscrit(generateur.reqNas(2)), demenage);
+
+	EXPECT_EQ(avant.reqInscrit(generateur.reqNas(3)), apres.reqInscrit(generateur.reqNas(3)));
+	EXPECT_EQ(apres.reqCirconscription().reqNbInscrits(), circonscription.reqNbInscrits());
+}
+
+/**
+ * Méthodes testées: constructeur copie, transferer
+ *
+ * Cas testé: copie d'une circonscription aux instantanés actifs, transfert
+ * vers une autre circonscription aux instantanés actifs
+ *
+ * Comportement attendu: la copie partage les versions de l'original; la
+ * version transférée n'est pas recopiée
+ */
+
+TEST_F(InstantaneCirconscriptionTest, copieEtTransfert)
+{
+	circonscription.activerInstantanes();
+	Circonscription copie(circonscription);
+	EXPECT_EQ(copie.reqInstantane().reqInscrit(generateur.reqNas(5)),
+	          circonscription.reqInstantane().reqInscrit(generateur.reqNas(5)));
+
+	Circonscription destination("Chicoutimi", generateur.reqDepute());
+	destination.activerInstantanes();
+	const Personne* version = circonscription.reqInstantane().reqInscrit(generateur.reqNas(5));
+	ASSERT_TRUE(circonscription.transferer(generateur.reqNas(5), destination).estValide());
+
+	EXPECT_EQ(destination.reqInstantane().reqInscrit(generateur.reqNas(5)), version);
+	EXPECT_EQ(circonscription.reqInstantane().reqInscrit(generateur.reqNas(5)), nullptr);
+	EXPECT_EQ(copie.reqInstantane().reqInscrit(generateur.reqNas(5)), version);
+}
+
+/**
+ * Méthodes testées: reqCirconscriptionFormate, parcourir
+ *
+ * Cas testé: instantané qui survit à sa circonscription
+ *
+ * Comportement attendu: les inscrits y sont toujours, par NAS croissant, au
+ * format de Circonscription::reqCirconscriptionFormate()
+ */
+
+TEST(InstantaneCirconscription, survitALaCirconscription)
+{
+	GenerateurInscrits generateur(2020);
+	Circonscription* circonscription = new Circonscription("Lac Saint-Jean", generateur.reqDepute());
+	for (std::size_t i = 1; i <= 10; ++i) circonscription->inscrire(generateur.reqElecteur(i));
+	circonscription->activerInstantanes();
+	InstantaneCirconscription instantane = circonscription->reqInstantane();
+	Circonscription parNas = instantane.reqCirconscription();
+	delete circonscription;
+
+	EXPECT_EQ(instantane.reqCirconscriptionFormate(), parNas.reqCirconscriptionFormate());
+	std::string precedent;
+	instantane.parcourir([&precedent](const Personne& p_inscrit)
+	{
+		EXPECT_LT(util::compacterNas(precedent.empty() ? "000 000 000" : precedent), util::compacterNas(p_inscrit.reqNas()));
+		precedent = p_inscrit.reqNas();
+	});
+}
+
+/**
+ * Méthode testée: reqInstantane
+ *
+ * Cas testé: quatre fils lisent des instantanés pendant que le fil principal
+ * inscrit et désinscrit
+ *
+ * Comportement attendu: chaque instantané lu reste cohérent: autant
+ * d'inscrits parcourus que reqNbInscrits()
+ */
+
+TEST_F(InstantaneCirconscriptionTest, lecteursConcurrents)
+{
+	circonscription.activerInstantanes();
+	std::vector<InstantaneCirconscription> instantanes(1, circonscription.reqInstantane());
+	std::atomic<bool> coherent(true);
+
+	for (std::size_t i = 101; i <= 200; ++i)
+	{
+		circonscription.inscrire(generateur.reqElecteur(i));
+		circonscription.desinscrire(generateur.reqNas(i - 100));
+		if (i % 25 == 0) instantanes.push_back(circonscription.reqInstantane());
+	}
+
+	std::vector<std::thread> lecteurs;
+	for (std::size_t f = 0; f < 4; ++f)
+	{
+		lecteurs.emplace_back([&instantanes, &coherent]()
+		{
+			for (const InstantaneCirconscription& instantane: instantanes)
+			{
+				std::size_t nbParcourus = 0;
+				instantane.parcourir([&nbParcourus](const Personne&) { ++nbParcourus; });
+				if (nbParcourus != instantane.reqNbInscrits()) coherent = false;
+			}
+		});
+	}
+	generateur.inscrireElecteurs(circonscription, 1, 100);
+	for (std::thread& lecteur: lecteurs) lecteur.join();
+
+	EXPECT_TRUE(coherent);
+	EXPECT_EQ(instantanes.front().reqNbInscrits(), 100u);
+	EXPECT_EQ(circonscription.reqNbInscrits(), 200u);
+}
@@ -0,0 +1,247 @@
+/**
+ * \file testeurJournalCirconscription.cpp
+ *
+ * Tests unitaires de la classe JournalCirconscription.
+ *
+ *  Created on: 2020-12-20
+ * \author Pascal Charpentier
+ */
+
+#include "JournalCirconscription.h"
+#include "Electeur.h"
+#include "GenerateurInscrits.h"
+#include "persistance.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+using namespace elections;
+
+/**
+ * Dispositif de test: une circonscription de 10 électeurs, sauvegardée dans
+ * un fichier du répertoire courant
+ */
+
+class JournalCirconscriptionTest : public ::testing::Test
+{
+public:
+
+	JournalCirconscriptionTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute()),
+	                               fichier("testeurJournal.circ")
+	{
+		generateur.inscrireElecteurs(circonscription, 1, 10);
+		std::ofstream os(fichier.c_str(), std::ios::binary);
+		sauvegarderCirconscription(os, circonscription);
+	}
+
+	~JournalCirconscriptionTest()
+	{
+		std::remove(fichier.c_str());
+		std::remove((fichier + JournalCirconscription::EXTENSION_JOURNAL).c_str());
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription circonscription;
+	std::string fichier;
+};
+
+/**
+ * Méthodes testées: inscrire, desinscrire, restaurer
+ *
+ * Cas testé: modifications journalisées, puis un nouveau journal ouvert sur
+ * les mêmes fichiers, comme après un arrêt brutal
+ *
+ * Comportement attendu: la circonscription restaurée contient les
+ * modifications; une modification refusée n'est pas journalisée
+ */
+
+TEST_F(JournalCirconscriptionTest, restaurerApresArret)
+{
+	{
+		JournalCirconscription journal(fichier);
+		EXPECT_TRUE(journal.inscrire(circonscription, generateur.reqElecteur(11)).estValide());
+		EXPECT_TRUE(journal.desinscrire(circonscription, generateur.reqNas(3)).estValide());
+		EXPECT_EQ(journal.inscrire(circonscription, generateur.reqElecteur(5)).reqErreur(), util::PERSONNE_DEJA_PRESENTE);
+		EXPECT_EQ(journal.desinscrire(circonscription, generateur.reqNas(3)).reqErreur(), util::PERSONNE_ABSENTE);
+		EXPECT_EQ(journal.reqNbEnregistrements(), 2u);
+	}
+
+	JournalCirconscription journal(fichier);
+	Circonscription* restauree = journal.restaurer();
+
+	EXPECT_EQ(journal.reqNbEnregistrements(), 2u);
+	EXPECT_EQ(restauree->reqNbInscrits(), 10u);
+	EXPECT_NE(restauree->reqInscrit(generateur.reqNas(11)), nullptr);
+	EXPECT_EQ(restauree->reqInscrit(generateur.reqNas(3)), nullptr);
+	EXPECT_EQ(restauree->reqCirconscriptionFormate(), circonscription.reqCirconscriptionFormate());
+	delete restauree;
+}
+
+/**
+ * Méthodes testées: remplacer, restaurer
+ *
+ * Cas testé: changement d'adresse journalisé, puis remplacement d'un NAS absent
+ *
+ * Comportement attendu: la circonscription restaurée a la nouvelle adresse, à
+ * la même place; le remplacement refusé n'est pas journalisé
+ */
+
+TEST_F(JournalCirconscriptionTest, remplacer)
+{
+	Electeur e = generateur.reqElecteur(4);
+	Electeur demenage(e.reqNas(), e.reqNom(), e.reqPrenom(), e.reqDateNaissance(),
+	                  util::Adresse(12, "des Érables", "Alma", "G8B 2C2", "Québec"));
+	{
+		JournalCirconscription journal(fichier);
+		EXPECT_TRUE(journal.remplacer(circonscription, demenage).estValide());
+		EXPECT_EQ(journal.remplacer(circonscription, generateur.reqElecteur(11)).reqErreur(), util::PERSONNE_ABSENTE);
+		EXPECT_EQ(journal.reqNbEnregistrements(), 1u);
+	}
+
+	JournalCirconscription journal(fichier);
+	Circonscription* restauree = journal.restaurer();
+
+	ASSERT_NE(restauree->reqInscrit(e.reqNas()), nullptr);
+	EXPECT_EQ(*restauree->reqInscrit(e.reqNas()), demenage);
+	EXPECT_EQ(restauree->reqCirconscriptionFormate(), circonscription.reqCirconscriptionFormate());
+	delete restauree;
+}
+
+/**
+ * Méthode testée: constructeur
+ *
+ * Cas testé: dernier enregistrement écrit à moitié, puis somme de contrôle fausse
+ *
+ * Comportement attendu: l'enregistrement est retiré, les suivants sont lisibles
+ */
+
+TEST_F(JournalCirconscriptionTest, enregistrementIncomplet)
+{
+	{
+		JournalCirconscription journal(fichier);
+		journal.inscrire(circonscription, generateur.reqElecteur(11));
+	}
+	{
+		std::ofstream os((fichier + JournalCirconscription::EXTENSION_JOURNAL).c_str(), std::ios::binary | std::ios::app);
+		os << "+ 200 0badcafe\n" << generateur.reqNas(12) << "\nNom";
+	}
+	{
+		JournalCirconscription journal(fichier);
+		EXPECT_EQ(journal.reqNbEnregistrements(), 1u);
+		journal.inscrire(circonscription, generateur.reqElecteur(13));
+	}
+	{
+		std::ofstream os((fichier + JournalCirconscription::EXTENSION_JOURNAL).c_str(), std::ios::binary | std::ios::app);
+		os << "- 12 00000000\n" << generateur.reqNas(13) << "\n";
+	}
+
+	JournalCirconscription journal(fichier);
+	Circonscription* restauree = journal.restaurer();
+
+	EXPECT_EQ(journal.reqNbEnregistrements(), 2u);
+	EXPECT_EQ(restauree->reqNbInscrits(), 12u);
+	EXPECT_NE(restauree->reqInscrit(generateur.reqNas(13)), nullptr);
+	delete restauree;
+}
+
+/**
+ * Méthodes testées: compacter, rejouer
+ *
+ * Cas testé: compactage, puis le journal d'avant le compactage rejoué sur la
+ * nouvelle sauvegarde, comme après un arrêt entre les deux étapes
+ *
+ * Comportement attendu: journal vide; le rejeu ne change pas la circonscription
+ */
+
+TEST_F(JournalCirconscriptionTest, compacter)
+{
+	std::string ancienJournal;
+	{
+		JournalCirconscription journal(fichier);
+		journal.inscrire(circonscription, generateur.reqElecteur(11));
+		journal.desinscrire(circonscription, generateur.reqNas(1));
+		journal.desinscrire(circonscription, generateur.reqNas(11));
+		journal.inscrire(circonscription, generateur.reqElecteur(11));
+		std::ifstream is(journal.reqFichierJournal().c_str(), std::ios::binary);
+		ancienJournal.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+
+		journal.compacter(circonscription);
+		EXPECT_EQ(journal.reqNbEnregistrements(), 0u);
+	}
+	{
+		std::ofstream os((fichier + JournalCirconscription::EXTENSION_JOURNAL).c_str(), std::ios::binary);
+		os << ancienJournal;
+	}
+
+	JournalCirconscription journal(fichier);
+	Circonscription* restauree = journal.restaurer();
+
+	EXPECT_EQ(journal.reqNbEnregistrements(), 4u);
+	EXPECT_EQ(restauree->reqNbInscrits(), circonscription.reqNbInscrits());
+	EXPECT_EQ(restauree->reqInscrit(generateur.reqNas(1)), nullptr);
+	EXPECT_NE(restauree->reqInscrit(generateur.reqNas(11)), nullptr);
+	delete restauree;
+}
+
+/**
+ * Méthode testée: remplacerFichier
+ *
+ * Cas testés: destination existante, puis source absente
+ *
+ * Comportement attendu: la destination prend le contenu de la source, qui
+ * disparaît; sans source, l'échec est signalé et la destination est intacte
+ */
+
+TEST_F(JournalCirconscriptionTest, remplacerFichier)
+{
+	const std::string source = fichier + ".tmp";
+	{
+		std::ofstream os(source.c_str(), std::ios::binary);
+		os << "nouvelle";
+	}
+
+	EXPECT_TRUE(remplacerFichier(source, fichier));
+	EXPECT_FALSE(remplacerFichier(source, fichier));
+
+	std::ifstream is(fichier.c_str(), std::ios::binary);
+	EXPECT_EQ(std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()), "nouvelle");
+	EXPECT_FALSE(std::ifstream(source.c_str()).good());
+}
+
+/**
+ * Méthodes testées: journaliserInscription, synchroniser
+ *
+ * Cas testé: quatre fils journalisent en même temps, en mode SYNCHRONE puis DIFFERE
+ *
+ * Comportement attendu: tous les enregistrements sont relus après synchroniser()
+ */
+
+TEST_F(JournalCirconscriptionTest, filsConcurrents)
+{
+	std::vector<Electeur> electeurs;
+	for (std::size_t i = 100; i < 300; ++i) electeurs.push_back(generateur.reqElecteur(i));
+
+	for (JournalCirconscription::Durabilite durabilite: {JournalCirconscription::SYNCHRONE, JournalCirconscription::DIFFERE})
+	{
+		Circonscription copie(circonscription);
+		JournalCirconscription journal(fichier, durabilite);
+		journal.reinitialiser();
+
+		std::vector<std::thread> fils;
+		for (std::size_t f = 0; f < 4; ++f)
+		{
+			fils.emplace_back([f, &electeurs, &journal]()
+			{
+				for (std::size_t i = 0; i < 50; ++i) journal.journaliserInscription(electeurs[f * 50 + i]);
+			});
+		}
+		for (std::thread& fil: fils) fil.join();
+		journal.synchroniser();
+
+		EXPECT_EQ(journal.rejouer(copie), 200u);
+		EXPECT_EQ(copie.reqNbInscrits(), 210u);
+	}
+}
@@ -0,0 +1,147 @@
+/**
+ * \file testeurPersistance.cpp
+ *
+ * Tests unitaires de la sauvegarde et de la récupération d'une Circonscription.
+ *
+ *  Created on: 2020-12-12
+ * \author Pascal Charpentier
+ */
+
+#include "persistance.h"
+#include "Circonscription.h"
+#include "Electeur.h"
+#include "Candidat.h"
+#include "validationFormat.h"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <string>
+
+using namespace elections;
+
+/**
+ * Dispositif de test: une circonscription contenant un électeur et un candidat
+ */
+
+class PersistanceTest : public ::testing::Test
+{
+public:
+
+	PersistanceTest() : circonscription("Matane Centre",
+			Candidat("111 111 118", "Poulin", "Paulo", util::Date(1, 1, 2001), util::Adresse(2020, "du Finfin", "Alma", "G8T 5R5", "Québec"), LIBERAL))
+	{
+		circonscription.inscrire(Electeur("222 222 226", "Wick", "John", util::Date(2, 2, 2002), util::Adresse(1, "Death Alley, app. 3", "New-York", "12345", "NY")));
+		circonscription.inscrire(Candidat("333 333 334", "Hendrix", "Jimi", util::Date(3, 3, 2003), util::Adresse(2, "Woodstock", "Woodstock", "50210", "NY"), BLOC_QUEBECOIS));
+	}
+
+	Circonscription circonscription;
+};
+
+/**
+ * Méthode testée: sauvegarderCirconscription
+ *
+ * Cas testé: dispositif de test
+ *
+ * Comportement attendu: le flux produit respecte le format de validerFormatFichier
+ */
+
+TEST_F(PersistanceTest, sauvegardeRespecteLeFormat)
+{
+	std::stringstream flux;
+	ASSERT_TRUE(sauvegarderCirconscription(flux, circonscription));
+	EXPECT_TRUE(util::validerFormatFichier(flux));
+}
+
+/**
+ * Méthode testée: recupererCirconscription
+ *
+ * Cas testé: flux produit par sauvegarderCirconscription
+ *
+ * Comportement attendu: la circonscription récupérée est identique à l'originale
+ */
+
+TEST_F(PersistanceTest, allerRetour)
+{
+	std::stringstream flux;
+	SuiviTraitement suivi;
+	sauvegarderCirconscription(flux, circonscription, &suivi);
+	EXPECT_EQ(suivi.reqProgression(), 2);
+
+	Circonscription* recuperee = recupererCirconscription(flux);
+	ASSERT_NE(recuperee, nullptr);
+	EXPECT_EQ(recuperee->reqCirconscriptionFormate(), circonscription.reqCirconscriptionFormate());
+	delete recuperee;
+}
+
+/**
+ * Méthode testée: recupererCirconscription
+ *
+ * Cas testé: bloc tronqué, NAS en double
+ *
+ * Comportement attendu: lance FormatFichierException
+ */
+
+TEST_F(PersistanceTest, fluxInvalide)
+{
+	std::stringstream flux;
+	sauvegarderCirconscription(flux, circonscription);
+	std::string texte = flux.str();
+
+	std::istringstream tronque(texte.substr(0, texte.size() - 20));
+	EXPECT_THROW(delete recupererCirconscription(tronque), FormatFichierException);
+
+	std::istringstream doublon(texte + "222 222 226\nWick\nJohn\n02 02 2002\n1, Death Alley, New-York, 12345, NY\n");
+	EXPECT_THROW(delete recupererCirconscription(doublon), FormatFichierException);
+}
+
+/**
+ * Construit un NAS valide à partir d'un entier de 8 chiffres, en calculant le
+ * chiffre de contrôle
+ */
+
+static std::string nasValide(unsigned int p_base)
+{
+	unsigned int chiffres[9];
+	unsigned int somme = 0;
+	for (int i = 7; i >= 0; --i)
+	{
+		chiffres[i] = p_base % 10;
+		p_base /= 10;
+	}
+	for (int i = 0; i < 8; ++i)
+	{
+		somme += (i % 2) ? (2 * chiffres[i] - 9 * (chiffres[i] / 5)) : chiffres[i];
+	}
+	chiffres[8] = (10 - somme % 10) % 10;
+
+	std::string nas;
+	for (int i = 0; i < 9; ++i)
+	{
+		if (i == 3 or i == 6) nas += ' ';
+		nas += static_cast<char>('0' + chiffres[i]);
+	}
+	return nas;
+}
+
+/**
+ * Méthodes testées: sauvegarderCirconscription, recupererCirconscription
+ *
+ * Cas testé: annulation demandée avant le début d'un traitement de plus de 256 inscrits
+ *
+ * Comportement attendu: la sauvegarde retourne false, la récupération retourne nullptr
+ */
+
+TEST_F(PersistanceTest, annulation)
+{
+	for (unsigned int i = 0; i < 300; ++i)
+	{
+		circonscription.inscrire(Electeur(nasValide(40000000 + i), "Tremblay", "Marie", util::Date(4, 4, 1984), util::Adresse(1 + i, "des Érables", "Alma", "G8B 1A1", "Québec")));
+	}
+	std::stringstream complet;
+	ASSERT_TRUE(sauvegarderCirconscription(complet, circonscription));
+
+	SuiviTraitement suivi;
+	suivi.annuler();
+	std::stringstream partiel;
+	EXPECT_FALSE(sauvegarderCirconscription(partiel, circonscription, &suivi));
+	EXPECT_EQ(recupererCirconscription(complet, &suivi), nullptr);
+}
@@ -372,3 +372,28 @@ TEST_F(PersonneTest, testFormattage)
 
 
 
+
+/**
+ * Méthodes testées: reqTexteFormate, asgAdresse
+ *
+ * Cas testés: appels répétés, copie, changement d'adresse
+ *
+ * Comportement attendu: le texte est celui de reqPersonneFormate(), partagé
+ * tant que la personne n'est pas modifiée, reconstruit après asgAdresse
+ */
+
+TEST_F(PersonneTest, reqTexteFormate)
+{
+	std::shared_ptr<const std::string> texte = personneValide1.reqTexteFormate();
+
+	EXPECT_EQ(*texte, personneValide1.reqPersonneFormate());
+	EXPECT_EQ(personneValide1.reqTexteFormate(), texte);
+
+	PersonneConcrete copie(personneValide1);
+	EXPECT_EQ(copie.reqTexteFormate(), texte);
+
+	personneValide1.asgAdresse(util::Adresse(1, "Rack", "Dreadfort", "T5T 5T5", "The North"));
+	EXPECT_NE(personneValide1.reqTexteFormate(), texte);
+	EXPECT_EQ(*personneValide1.reqTexteFormate(), personneValide1.reqPersonneFormate());
+	EXPECT_EQ(copie.reqTexteFormate(), texte);
+}
@@ -0,0 +1,68 @@
+/**
+ * \file testeurProvince.cpp
+ *
+ * Tests unitaires de l'énumération Province et de son analyse.
+ *
+ *  Created on: 2020-12-23
+ * \author Pascal Charpentier
+ */
+
+#include "Province.h"
+#include "gtest/gtest.h"
+#include <string>
+
+using namespace util;
+
+/**
+ * Méthode testée: analyserProvince
+ *
+ * Cas testé: nom français, nom anglais et abréviation de chaque province
+ *
+ * Comportement attendu: la province correspondante, et les noms restitués
+ * sont ceux qui ont été analysés
+ */
+
+TEST(Province, analyserToutesLesGraphies)
+{
+	for (std::size_t i = 0; i < NB_PROVINCES; ++i)
+	{
+		Province province = static_cast<Province>(i);
+
+		EXPECT_EQ(analyserProvince(reqNomProvince(province)).reqValeur(), province) << i;
+		EXPECT_EQ(analyserProvince(reqNomAnglaisProvince(province)).reqValeur(), province) << i;
+		EXPECT_EQ(analyserProvince(reqAbreviationProvince(province)).reqValeur(), province) << i;
+	}
+	EXPECT_EQ(reqNomProvince(Province::QUEBEC), "Québec");
+	EXPECT_EQ(reqNomAnglaisProvince(Province::QUEBEC), "Quebec");
+	EXPECT_EQ(reqAbreviationProvince(Province::QUEBEC), "QC");
+}
+
+/**
+ * Méthode testée: analyserProvince
+ *
+ * Cas testé: graphies officielles qui diffèrent de celles des fichiers
+ *
+ * Comportement attendu: la province correspondante
+ */
+
+TEST(Province, analyserAutresGraphies)
+{
+	EXPECT_EQ(analyserProvince("Île-du-Prince-Édouard").reqValeur(), Province::ILE_DU_PRINCE_EDOUARD);
+	EXPECT_EQ(analyserProvince("Terre-Neuve-et-Labrador").reqValeur(), Province::TERRE_NEUVE);
+}
+
+/**
+ * Méthode testée: analyserProvince
+ *
+ * Cas testé: casse différente, préfixe, état américain, chaînes courtes
+ *
+ * Comportement attendu: ADRESSE_INVALIDE
+ */
+
+TEST(Province, analyserInvalide)
+{
+	for (const std::string texte: {"", "Q", "Qc", "quebec", "QUÉBEC", "Ontari", "Ontario ", "NY", "ile de Ré"})
+	{
+		EXPECT_EQ(analyserProvince(texte).reqErreur(), ADRESSE_INVALIDE) << texte;
+	}
+}
@@ -0,0 +1,198 @@
+/**
+ * \file testeurRegistreProvincial.cpp
+ *
+ * Tests unitaires de la classe RegistreProvincial.
+ *
+ *  Created on: 2020-12-16
+ * \author Pascal Charpentier
+ */
+
+#include "RegistreProvincial.h"
+#include "validationFormat.h"
+#include "GenerateurInscrits.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+using namespace elections;
+
+/**
+ * Dispositif de test: un registre de trois circonscriptions vides et un
+ * générateur d'électeurs
+ */
+
+class RegistreProvincialTest : public ::testing::Test
+{
+public:
+
+	RegistreProvincialTest() : registre(4), generateur(2020)
+	{
+		const char* noms[] = {"Lac Saint-Jean", "Chicoutimi", "Jonquière"};
+		for (const char* nom: noms)
+		{
+			registre.ajouterCirconscription(Circonscription(nom, generateur.reqDepute()));
+		}
+	}
+
+	RegistreProvincial registre;
+	GenerateurInscrits generateur;
+};
+
+/**
+ * Méthodes testées: inscrire, localiser
+ *
+ * Cas testé: un électeur inscrit dans une circonscription, puis dans une autre
+ *
+ * Comportement attendu: la seconde inscription est refusée; localiser donne la
+ * première circonscription
+ */
+
+TEST_F(RegistreProvincialTest, inscrireDansDeuxCirconscriptions)
+{
+	Electeur electeur = generateur.reqElecteur(1);
+
+	EXPECT_TRUE(registre.inscrire(0, electeur).estValide());
+	EXPECT_EQ(registre.inscrire(2, electeur).reqErreur(), util::PERSONNE_DEJA_PRESENTE);
+
+	ASSERT_EQ(registre.localiser(electeur.reqNas()), &registre.reqCirconscription(0));
+	EXPECT_EQ(registre.localiser(generateur.reqNas(2)), nullptr);
+	EXPECT_EQ(registre.reqCirconscription(2).reqNbInscrits(), 0u);
+}
+
+/**
+ * Méthode testée: localiser
+ *
+ * Cas testé: NAS de 10 chiffres, dont l'un donnerait la clé réservée aux cases
+ * vides de l'index, dans un registre vide puis peuplé
+ *
+ * Comportement attendu: nullptr
+ */
+
+TEST_F(RegistreProvincialTest, localiserNasMalForme)
+{
+	RegistreProvincial vide;
+	EXPECT_EQ(vide.localiser("4294967295"), nullptr);
+
+	registre.inscrire(1, generateur.reqElecteur(1));
+	EXPECT_EQ(registre.localiser("4294967295"), nullptr);
+	EXPECT_EQ(registre.localiser(std::to_string(4294967296ULL + util::compacterNas(generateur.reqNas(1)))), nullptr);
+}
+
+/**
+ * Méthode testée: desinscrire
+ *
+ * Cas testé: électeur inscrit, puis déjà retiré, puis NAS mal formé
+ *
+ * Comportement attendu: l'électeur n'est plus localisé et peut être inscrit ailleurs
+ */
+
+TEST_F(RegistreProvincialTest, desinscrire)
+{
+	Electeur electeur = generateur.reqElecteur(1);
+	registre.inscrire(1, electeur);
+
+	EXPECT_TRUE(registre.desinscrire(electeur.reqNas()).estValide());
+	EXPECT_EQ(registre.desinscrire(electeur.reqNas()).reqErreur(), util::PERSONNE_ABSENTE);
+	EXPECT_EQ(registre.desinscrire("123").reqErreur(), util::NAS_INVALIDE);
+	EXPECT_EQ(registre.localiser(electeur.reqNas()), nullptr);
+	EXPECT_TRUE(registre.inscrire(2, electeur).estValide());
+}
+
+/**
+ * Méthodes testées: transferer, transfererSi
+ *
+ * Cas testés: un électeur transféré seul, puis les électeurs d'une
+ * circonscription dont le NAS est pair
+ *
+ * Comportement attendu: localiser donne la circonscription d'accueil, les
+ * autres restent, et le registre reste valide
+ */
+
+TEST_F(RegistreProvincialTest, transferer)
+{
+	for (std::size_t i = 1; i <= 10; ++i) registre.inscrire(0, generateur.reqElecteur(i));
+	const Personne* inscrit = registre.reqCirconscription(0).reqInscrit(generateur.reqNas(1));
+
+	EXPECT_TRUE(registre.transferer(generateur.reqNas(1), 2).estValide());
+	EXPECT_EQ(registre.localiser(generateur.reqNas(1)), &registre.reqCirconscription(2));
+	EXPECT_EQ(registre.reqCirconscription(2).reqInscrit(generateur.reqNas(1)), inscrit);
+	EXPECT_TRUE(registre.transferer(generateur.reqNas(1), 2).estValide());
+	EXPECT_EQ(registre.transferer(generateur.reqNas(11), 2).reqErreur(), util::PERSONNE_ABSENTE);
+
+	auto pair = [](const Personne& p) { return (p.reqNas().back() - '0') % 2 == 0; };
+	std::size_t nbPairs = 0;
+	for (std::size_t i = 2; i <= 10; ++i) nbPairs += pair(generateur.reqElecteur(i));
+
+	util::Resultat<std::size_t> nbTransferes = registre.transfererSi(0, pair, 1);
+	ASSERT_TRUE(nbTransferes.estValide());
+	EXPECT_EQ(nbTransferes.reqValeur(), nbPairs);
+	EXPECT_EQ(registre.reqCirconscription(1).reqNbInscrits(), nbPairs);
+	EXPECT_EQ(registre.reqCirconscription(0).reqNbInscrits(), 9 - nbPairs);
+	for (std::size_t i = 2; i <= 10; ++i)
+		EXPECT_EQ(registre.localiser(generateur.reqNas(i)), &registre.reqCirconscription(pair(generateur.reqElecteur(i)) ? 1 : 0));
+	EXPECT_TRUE(registre.validerRegistre());
+}
+
+/**
+ * Méthode testée: inscrireEnLot
+ *
+ * Cas testé: trois lots de 1000 électeurs; le troisième lot reprend les 100
+ * premiers électeurs du premier lot
+ *
+ * Comportement attendu: les doublons entre circonscriptions sont refusés, les
+ * autres inscrits, et le registre reste valide
+ */
+
+TEST_F(RegistreProvincialTest, inscrireEnLot)
+{
+	std::vector<Electeur> electeurs;
+	for (std::size_t i = 1; i <= 2900; ++i) electeurs.push_back(generateur.reqElecteur(i));
+
+	std::vector<RegistreProvincial::Lot> lots(3);
+	for (std::size_t l = 0; l < 3; ++l)
+	{
+		lots[l].circonscription = l;
+		for (std::size_t i = 0; i < 1000; ++i)
+		{
+			std::size_t indice = (l == 2 and i < 100) ? i : l * 1000 + i - (l == 2 ? 100 : 0);
+			lots[l].personnes.push_back(&electeurs[indice]);
+		}
+	}
+
+	std::vector<std::vector<util::CodeErreur>> codes = registre.inscrireEnLot(lots);
+
+	ASSERT_EQ(codes.size(), 3u);
+	EXPECT_EQ(codes[2][0], util::PERSONNE_DEJA_PRESENTE);
+	EXPECT_EQ(codes[2][99], util::PERSONNE_DEJA_PRESENTE);
+	EXPECT_EQ(codes[2][100], util::AUCUNE_ERREUR);
+	EXPECT_EQ(registre.reqCirconscription(0).reqNbInscrits(), 1000u);
+	EXPECT_EQ(registre.reqCirconscription(2).reqNbInscrits(), 900u);
+	EXPECT_EQ(registre.reqNbInscrits(), 2900u);
+	EXPECT_EQ(registre.localiser(electeurs[2899].reqNas()), &registre.reqCirconscription(2));
+	EXPECT_TRUE(registre.validerRegistre());
+}
+
+/**
+ * Méthode testée: ajouterCirconscription
+ *
+ * Cas testé: circonscription dont un inscrit l'est déjà dans le registre
+ *
+ * Comportement attendu: PERSONNE_DEJA_PRESENTE, le registre est inchangé
+ */
+
+TEST_F(RegistreProvincialTest, ajouterCirconscriptionEnConflit)
+{
+	Electeur electeur = generateur.reqElecteur(1);
+	Circonscription autre("Roberval", generateur.reqDepute());
+	autre.inscrire(electeur);
+	autre.inscrire(generateur.reqElecteur(2));
+	registre.inscrire(0, electeur);
+
+	EXPECT_EQ(registre.ajouterCirconscription(autre).reqErreur(), util::PERSONNE_DEJA_PRESENTE);
+	EXPECT_EQ(registre.reqNbCirconscriptions(), 3u);
+
+	autre.desinscrire(electeur.reqNas());
+	util::Resultat<std::size_t> numero = registre.ajouterCirconscription(autre);
+	ASSERT_TRUE(numero.estValide());
+	EXPECT_EQ(registre.localiser(generateur.reqNas(2)), &registre.reqCirconscription(numero.reqValeur()));
+}
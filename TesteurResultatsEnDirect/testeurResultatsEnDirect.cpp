@@ -0,0 +1,157 @@
+/**
+ * \file testeurResultatsEnDirect.cpp
+ *
+ * Tests unitaires de la classe ResultatsEnDirect.
+ *
+ *  Created on: 2020-12-19
+ * \author Pascal Charpentier
+ */
+
+#include "ResultatsEnDirect.h"
+#include "GenerateurInscrits.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace elections;
+
+/**
+ * Dispositif de test: une circonscription de 10 électeurs et de trois
+ * candidats, deux libéraux et un conservateur
+ */
+
+class ResultatsEnDirectTest : public ::testing::Test
+{
+public:
+
+	ResultatsEnDirectTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute())
+	{
+		generateur.inscrireElecteurs(circonscription, 1, 10);
+		circonscription.inscrire(generateur.reqCandidat(11, LIBERAL));
+		circonscription.inscrire(generateur.reqCandidat(12, CONSERVATEUR));
+		circonscription.inscrire(generateur.reqCandidat(13, LIBERAL));
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription circonscription;
+};
+
+/**
+ * Méthodes testées: constructeur, reqInstantane
+ *
+ * Cas testé: aucun bureau n'a transmis
+ *
+ * Comportement attendu: totaux nuls, version 0
+ */
+
+TEST_F(ResultatsEnDirectTest, constructeur)
+{
+	ResultatsEnDirect resultats(circonscription, 3);
+	std::shared_ptr<const ResultatsEnDirect::Instantane> instantane = resultats.reqInstantane();
+
+	EXPECT_EQ(resultats.reqNbCandidats(), 3u);
+	EXPECT_EQ(resultats.reqNbBureaux(), 3u);
+	EXPECT_EQ(resultats.reqCandidat(1).reqPartiPolitique(), CONSERVATEUR);
+	EXPECT_EQ(instantane->voixParCandidat, std::vector<std::uint64_t>(3, 0));
+	EXPECT_EQ(instantane->voixParParti[LIBERAL], 0u);
+	EXPECT_EQ(instantane->nbBureauxRapportes, 0u);
+	EXPECT_EQ(instantane->version, 0u);
+}
+
+/**
+ * Méthode testée: rapporter
+ *
+ * Cas testé: deux bureaux transmettent, puis le premier corrige son décompte à la baisse
+ *
+ * Comportement attendu: la correction remplace l'ancien décompte, totaux
+ * par candidat et par parti exacts, un instantané antérieur reste inchangé
+ */
+
+TEST_F(ResultatsEnDirectTest, rapporterEtCorriger)
+{
+	ResultatsEnDirect resultats(circonscription, 3);
+
+	EXPECT_FALSE(resultats.rapporter(0, {10, 20, 30}));
+	EXPECT_FALSE(resultats.rapporter(2, {1, 2, 3}));
+	std::shared_ptr<const ResultatsEnDirect::Instantane> avant = resultats.reqInstantane();
+	EXPECT_TRUE(resultats.rapporter(0, {5, 25, 30}));
+
+	std::shared_ptr<const ResultatsEnDirect::Instantane> apres = resultats.reqInstantane();
+	EXPECT_EQ(apres->voixParCandidat, (std::vector<std::uint64_t>{6, 27, 33}));
+	EXPECT_EQ(apres->voixParParti[LIBERAL], 39u);
+	EXPECT_EQ(apres->voixParParti[CONSERVATEUR], 27u);
+	EXPECT_EQ(apres->nbBureauxRapportes, 2u);
+	EXPECT_EQ(apres->version, 3u);
+
+	EXPECT_EQ(avant->voixParCandidat, (std::vector<std::uint64_t>{11, 22, 33}));
+	EXPECT_EQ(avant->version, 2u);
+}
+
+/**
+ * Méthode testée: rapporter
+ *
+ * Cas testé: décompte issu de DepouillementBulletins
+ *
+ * Comportement attendu: les voix par candidat sont reprises
+ */
+
+TEST_F(ResultatsEnDirectTest, rapporterDepouillement)
+{
+	ResultatsEnDirect resultats(circonscription, 1);
+	DepouillementBulletins depouillement(circonscription, 1, 1);
+
+	depouillement.depouiller(std::vector<Bulletin>{{0, 0}, {2, 0}, {2, 0}});
+	resultats.rapporter(0, depouillement.reqResultats());
+
+	EXPECT_EQ(resultats.reqInstantane()->voixParCandidat, (std::vector<std::uint64_t>{1, 0, 2}));
+}
+
+/**
+ * Méthodes testées: rapporter, reqInstantane
+ *
+ * Cas testé: des lecteurs lisent pendant que deux fils transmettent et
+ * corrigent; chaque transmission d'un bureau b vaut (v, v, v) avec une somme
+ * par candidat connue pour chaque version
+ *
+ * Comportement attendu: chaque instantané lu est cohérent: mêmes voix pour
+ * les trois candidats, parti libéral au double, versions croissantes
+ */
+
+TEST_F(ResultatsEnDirectTest, lecteursConcurrents)
+{
+	ResultatsEnDirect resultats(circonscription, 2);
+	std::atomic<bool> fini(false);
+	std::atomic<int> incoherences(0);
+
+	auto lecteur = [&]()
+	{
+		std::uint64_t derniere = 0;
+		while (!fini.load())
+		{
+			std::shared_ptr<const ResultatsEnDirect::Instantane> i = resultats.reqInstantane();
+			if (i->version < derniere
+			    or i->voixParCandidat[0] != i->voixParCandidat[1]
+			    or i->voixParCandidat[1] != i->voixParCandidat[2]
+			    or i->voixParParti[LIBERAL] != 2 * i->voixParCandidat[0])
+				++incoherences;
+			derniere = i->version;
+		}
+	};
+	auto redacteur = [&](std::size_t p_bureau)
+	{
+		for (std::uint64_t v = 1; v <= 2000; ++v) resultats.rapporter(p_bureau, {v, v, v});
+	};
+
+	std::thread l1(lecteur), l2(lecteur);
+	std::thread r1(redacteur, 0), r2(redacteur, 1);
+	r1.join();
+	r2.join();
+	fini = true;
+	l1.join();
+	l2.join();
+
+	EXPECT_EQ(incoherences.load(), 0);
+	EXPECT_EQ(resultats.reqInstantane()->voixParCandidat[0], 4000u);
+	EXPECT_EQ(resultats.reqInstantane()->version, 4000u);
+}
@@ -0,0 +1,160 @@
+/**
+ * \file testeurSectionsDeVote.cpp
+ *
+ * Tests unitaires de la classe SectionsDeVote.
+ *
+ *  Created on: 2020-12-26
+ * \author Pascal Charpentier
+ */
+
+#include "SectionsDeVote.h"
+#include "BassinDeTaches.h"
+#include "ContratException.h"
+#include "Electeur.h"
+#include "GenerateurInscrits.h"
+#include "IndexAlphabetique.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace elections;
+
+/**
+ * Clé d'ordre d'une adresse: code postal compact, rue, numéro civique
+ */
+
+static std::tuple<std::uint32_t, std::string, int> cleAdresse(const util::Adresse& p_adresse)
+{
+	return std::make_tuple(p_adresse.reqCodePostalCompact().reqValeur(), p_adresse.reqNomRue(), p_adresse.reqNumeroCivic());
+}
+
+/**
+ * \class SectionsDeVoteTest
+ *
+ * Dispositif de test: une circonscription de 2000 inscrits aléatoires
+ */
+
+class SectionsDeVoteTest : public ::testing::Test
+{
+public:
+
+	SectionsDeVoteTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute())
+	{
+		generateur.inscrireElecteurs(circonscription, 1, 2000);
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription circonscription;
+};
+
+/**
+ * Méthode testée: constructeur
+ *
+ * Cas testé: 2000 inscrits en 7 sections
+ *
+ * Comportement attendu: chaque inscrit est dans une seule section, les
+ * sections se suivent dans l'ordre des adresses et ont des tailles voisines
+ */
+
+TEST_F(SectionsDeVoteTest, decoupage)
+{
+	SectionsDeVote sections(circonscription, 7);
+	std::size_t total = 0;
+
+	ASSERT_EQ(sections.reqNbSections(), 7u);
+	for (std::size_t s = 0; s < sections.reqNbSections(); ++s)
+	{
+		total += sections.reqNbInscrits(s);
+		EXPECT_NEAR(static_cast<double>(sections.reqNbInscrits(s)), 2000.0 / 7, 10.0) << s;
+		EXPECT_TRUE(std::is_sorted(sections.reqDebutParAdresse(s), sections.reqFinParAdresse(s),
+		            [](const Personne* a, const Personne* b) { return cleAdresse(a->reqAdresse()) < cleAdresse(b->reqAdresse()); }));
+		if (s > 0)
+		{
+			EXPECT_LT(cleAdresse(sections.reqDerniereAdresse(s - 1)), cleAdresse(sections.reqPremiereAdresse(s))) << s;
+		}
+	}
+	EXPECT_EQ(total, circonscription.reqNbInscrits());
+}
+
+/**
+ * Méthodes testées: reqDebutListe, reqFinListe
+ *
+ * Cas testé: listes triées dans le fil appelant et par un bassin de 4 fils
+ *
+ * Comportement attendu: les inscrits de chaque section, dans l'ordre de
+ * cleAlphabetique(), les mêmes dans les deux cas
+ */
+
+TEST_F(SectionsDeVoteTest, listesAlphabetiques)
+{
+	util::BassinDeTaches bassin(4);
+	SectionsDeVote sequentiel(circonscription, 5);
+	SectionsDeVote parallele(circonscription, 5, &bassin);
+
+	for (std::size_t s = 0; s < sequentiel.reqNbSections(); ++s)
+	{
+		EXPECT_TRUE(std::equal(sequentiel.reqDebutListe(s), sequentiel.reqFinListe(s), parallele.reqDebutListe(s)));
+		EXPECT_TRUE(std::is_sorted(sequentiel.reqDebutListe(s), sequentiel.reqFinListe(s),
+		            [](const Personne* a, const Personne* b) { return cleAlphabetique(*a) < cleAlphabetique(*b); }));
+		EXPECT_TRUE(std::is_permutation(sequentiel.reqDebutListe(s), sequentiel.reqFinListe(s), sequentiel.reqDebutParAdresse(s)));
+	}
+}
+
+/**
+ * Méthode testée: constructeur
+ *
+ * Cas testés: trois inscrits à la même adresse, plus de sections que
+ * d'adresses, nombre de sections nul
+ *
+ * Comportement attendu: une adresse n'est jamais partagée entre deux
+ * sections, les sections en trop sont vides; exception de contrat si le
+ * nombre de sections est nul
+ */
+
+TEST(SectionsDeVote, adressePartagee)
+{
+	GenerateurInscrits generateur(2020);
+	Circonscription circonscription("Lac Saint-Jean", generateur.reqDepute());
+	util::Adresse commune(12, "des Érables", "Alma", "G8B 2C2", "Québec");
+
+	for (std::size_t i = 1; i <= 3; ++i)
+	{
+		Electeur e = generateur.reqElecteur(i);
+		circonscription.inscrire(Electeur(e.reqNas(), e.reqNom(), e.reqPrenom(), e.reqDateNaissance(), commune));
+	}
+	Electeur e = generateur.reqElecteur(4);
+	circonscription.inscrire(Electeur(e.reqNas(), e.reqNom(), e.reqPrenom(), e.reqDateNaissance(),
+	                                  util::Adresse(14, "des Érables", "Alma", "G8B 2C2", "Québec")));
+
+	SectionsDeVote deux(circonscription, 2);
+	EXPECT_EQ(deux.reqNbInscrits(0), 3u);
+	EXPECT_EQ(deux.reqNbInscrits(1), 1u);
+
+	SectionsDeVote quatre(circonscription, 4);
+	EXPECT_EQ(quatre.reqNbInscrits(0) + quatre.reqNbInscrits(1) + quatre.reqNbInscrits(2) + quatre.reqNbInscrits(3), 4u);
+	EXPECT_EQ(quatre.reqNbInscrits(1), 1u);
+	EXPECT_EQ(quatre.reqNbInscrits(3), 0u);
+
+	EXPECT_THROW(SectionsDeVote(circonscription, 0), PreconditionException);
+}
+
+/**
+ * Méthode testée: reqListeFormatee
+ *
+ * Cas testé: une section de la circonscription
+ *
+ * Comportement attendu: l'en-tête de la section, puis chaque inscrit de la
+ * liste alphabétique
+ */
+
+TEST_F(SectionsDeVoteTest, reqListeFormatee)
+{
+	SectionsDeVote sections(circonscription, 3);
+	std::string liste = sections.reqListeFormatee(1);
+
+	EXPECT_EQ(liste.find("Circonscription: Lac Saint-Jean\nSection de vote: 2 de 3\n\n"), 0u);
+	for (auto it = sections.reqDebutListe(1); it != sections.reqFinListe(1); ++it)
+		EXPECT_NE(liste.find((*it)->reqPersonneFormate()), std::string::npos);
+}
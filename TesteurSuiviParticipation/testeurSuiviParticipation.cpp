@@ -0,0 +1,104 @@
+/**
+ * \file testeurSuiviParticipation.cpp
+ *
+ * Tests unitaires de la classe SuiviParticipation.
+ *
+ *  Created on: 2020-12-18
+ * \author Pascal Charpentier
+ */
+
+#include "SuiviParticipation.h"
+#include "GenerateurInscrits.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace elections;
+
+/**
+ * Dispositif de test: une circonscription de 1000 inscrits répartis en 4
+ * bureaux selon le numéro civique
+ */
+
+class SuiviParticipationTest : public ::testing::Test
+{
+public:
+
+	SuiviParticipationTest() : generateur(2020), circonscription("Lac Saint-Jean", generateur.reqDepute())
+	{
+		generateur.inscrireElecteurs(circonscription, 1, 1000);
+	}
+
+	static std::size_t bureauSelonNumero(const Personne& p_personne)
+	{
+		return p_personne.reqAdresse().reqNumeroCivic() % 4;
+	}
+
+	GenerateurInscrits generateur;
+	Circonscription circonscription;
+};
+
+/**
+ * Méthode testée: enregistrerVote
+ *
+ * Cas testé: vote, double vote, NAS absent, NAS mal formé
+ *
+ * Comportement attendu: seul le premier vote est compté
+ */
+
+TEST_F(SuiviParticipationTest, enregistrerVote)
+{
+	SuiviParticipation suivi(circonscription, 4, bureauSelonNumero);
+	std::string nas = generateur.reqNas(10);
+
+	EXPECT_TRUE(suivi.enregistrerVote(nas).estValide());
+	EXPECT_EQ(suivi.enregistrerVote(nas).reqErreur(), util::VOTE_DEJA_ENREGISTRE);
+	EXPECT_EQ(suivi.enregistrerVote(generateur.reqNas(5000)).reqErreur(), util::PERSONNE_ABSENTE);
+	EXPECT_EQ(suivi.enregistrerVote("12 34").reqErreur(), util::NAS_INVALIDE);
+
+	std::uint32_t identifiant = suivi.reqIdentifiant(nas).reqValeur();
+	EXPECT_TRUE(suivi.aVote(identifiant));
+	EXPECT_EQ(suivi.reqNbVotants(), 1u);
+	EXPECT_EQ(suivi.reqNbVotants(suivi.reqBureau(identifiant)), 1u);
+}
+
+/**
+ * Méthodes testées: reqNbInscrits, reqNbVotants, reqTauxParticipation
+ *
+ * Cas testé: 8 fils enregistrent chacun le vote de tous les inscrits d'indice pair
+ *
+ * Comportement attendu: chaque vote n'est compté qu'une fois; les comptes par
+ * bureau totalisent ceux de la circonscription
+ */
+
+TEST_F(SuiviParticipationTest, votesConcurrents)
+{
+	SuiviParticipation suivi(circonscription, 4, bureauSelonNumero);
+	std::atomic<std::size_t> acceptes(0);
+	std::vector<std::thread> fils;
+
+	for (int f = 0; f < 8; ++f)
+	{
+		fils.emplace_back([&]()
+		{
+			for (std::size_t i = 2; i <= 1000; i += 2)
+			{
+				if (suivi.enregistrerVote(generateur.reqNas(i)).estValide()) ++acceptes;
+			}
+		});
+	}
+	for (std::thread& t: fils) t.join();
+
+	std::size_t inscrits = 0;
+	std::size_t votants = 0;
+	for (std::size_t b = 0; b < suivi.reqNbBureaux(); ++b)
+	{
+		inscrits += suivi.reqNbInscrits(b);
+		votants += suivi.reqNbVotants(b);
+	}
+	EXPECT_EQ(acceptes.load(), 500u);
+	EXPECT_EQ(votants, 500u);
+	EXPECT_EQ(inscrits, 1000u);
+	EXPECT_DOUBLE_EQ(suivi.reqTauxParticipation(), 0.5);
+}
@@ -0,0 +1,147 @@
+/**
+ * \file testeurVisiteurPersonne.cpp
+ *
+ * Tests unitaires de la visite d'une Personne selon son type concret.
+ *
+ *  Created on: 2020-12-23
+ * \author Pascal Charpentier
+ */
+
+#include "VisiteurPersonne.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <type_traits>
+
+using namespace elections;
+
+/**
+ * \class PersonneAutre
+ *
+ * Classe dérivée hors du modèle, visitée par les appels virtuels
+ */
+
+class PersonneAutre : public Personne
+{
+public:
+
+	PersonneAutre() : Personne("046 454 286", "Ogrodnik", "Ohana", util::Date(4, 4, 1984),
+	                           util::Adresse(4, "Mont-Royal", "Montréal", "H2J 1X3", "Québec")) {}
+
+	Personne* clone() const override { return new PersonneAutre(*this); }
+	std::string reqPersonneFormate() const override { return "Autre"; }
+};
+
+/**
+ * \class VisiteurPersonneTest
+ *
+ * Dispositif de test: un électeur, un candidat et une personne hors du modèle
+ */
+
+class VisiteurPersonneTest : public ::testing::Test
+{
+public:
+
+	VisiteurPersonneTest()
+	: electeur("111 111 118", "Tremblay", "Marie", util::Date(1, 1, 1981),
+	           util::Adresse(2020, "du Finfin", "Alma", "G8Z 3S3", "Québec")),
+	  candidat("222 222 226", "Gagnon", "Luc", util::Date(2, 2, 1982),
+	           util::Adresse(10567, "boulevard de l'Avenir", "Laval", "H7E 1M8", "Québec"), NOUVEAU_PARTI_DEMOCRATIQUE),
+	  autre()
+	{}
+
+	Electeur      electeur;
+	Candidat      candidat;
+	PersonneAutre autre;
+};
+
+/**
+ * Méthode testée: reqType, visiter
+ *
+ * Cas testé: dispositif de test, visiteur qui retourne le nom du type reçu
+ *
+ * Comportement attendu: chaque personne est visitée selon son type concret;
+ * une copie garde son type
+ */
+
+TEST_F(VisiteurPersonneTest, visiter)
+{
+	struct NomDuType
+	{
+		std::string operator()(const Electeur&) const { return "Electeur"; }
+		std::string operator()(const Candidat&) const { return "Candidat"; }
+		std::string operator()(const Personne&) const { return "Personne"; }
+	};
+	Personne* copie = candidat.clone();
+
+	EXPECT_EQ(electeur.reqType(), TypePersonne::ELECTEUR);
+	EXPECT_EQ(copie->reqType(), TypePersonne::CANDIDAT);
+	EXPECT_EQ(autre.reqType(), TypePersonne::AUTRE);
+	EXPECT_EQ(visiter(electeur, NomDuType()), "Electeur");
+	EXPECT_EQ(visiter(*copie, NomDuType()), "Candidat");
+	EXPECT_EQ(visiter(autre, NomDuType()), "Personne");
+	delete copie;
+}
+
+/**
+ * Méthode testée: commeCandidat
+ *
+ * Cas testé: dispositif de test
+ *
+ * Comportement attendu: le candidat lui-même, nullptr pour les autres
+ */
+
+TEST_F(VisiteurPersonneTest, commeCandidat)
+{
+	EXPECT_EQ(commeCandidat(candidat), &candidat);
+	EXPECT_EQ(commeCandidat(electeur), nullptr);
+	EXPECT_EQ(commeCandidat(autre), nullptr);
+}
+
+/**
+ * Méthode testée: formaterPersonne, validerPersonne
+ *
+ * Cas testé: dispositif de test
+ *
+ * Comportement attendu: mêmes résultats que les appels virtuels
+ */
+
+TEST_F(VisiteurPersonneTest, equivalentAuxAppelsVirtuels)
+{
+	for (const Personne* p: {static_cast<const Personne*>(&electeur), static_cast<const Personne*>(&candidat),
+	                          static_cast<const Personne*>(&autre)})
+	{
+		EXPECT_EQ(formaterPersonne(*p), p->reqPersonneFormate());
+		EXPECT_EQ(validerPersonne(*p), p->valider());
+	}
+	EXPECT_EQ(formaterPersonne(autre), "Autre");
+}
+
+/**
+ * Méthode testée: opérateur d'affectation
+ *
+ * Cas testé: affectation par une référence à Personne, affectations entre
+ * objets de même classe
+ *
+ * Comportement attendu: la première ne compile pas; les autres copient les
+ * attributs et gardent le type concret, que visiter() et formaterPersonne()
+ * utilisent
+ */
+
+TEST_F(VisiteurPersonneTest, affectationGardeLeType)
+{
+	static_assert(!std::is_copy_assignable<Personne>::value, "une Personne ne doit pas recevoir une autre classe");
+
+	Electeur copieElecteur("333 333 334", "Roy", "Léa", util::Date(3, 3, 1983),
+	                       util::Adresse(3, "des Pins", "Alma", "G8B 2C2", "Québec"));
+	Candidat copieCandidat(candidat);
+	copieElecteur = electeur;
+	copieCandidat = Candidat("333 333 334", "Roy", "Léa", util::Date(3, 3, 1983),
+	                         util::Adresse(3, "des Pins", "Alma", "G8B 2C2", "Québec"), LIBERAL);
+
+	EXPECT_EQ(copieElecteur, electeur);
+	EXPECT_EQ(copieElecteur.reqType(), TypePersonne::ELECTEUR);
+	EXPECT_EQ(commeCandidat(copieElecteur), nullptr);
+	EXPECT_EQ(formaterPersonne(copieElecteur), electeur.reqPersonneFormate());
+	EXPECT_EQ(copieCandidat.reqType(), TypePersonne::CANDIDAT);
+	EXPECT_EQ(copieCandidat.reqPartiPolitique(), LIBERAL);
+}